@@ -45,6 +45,7 @@ from common.Caches import *
 
 import m5
 from m5.objects import *
+from m5.util import convert
 
 from gem5.isas import ISA
 
@@ -80,6 +81,32 @@ def _get_cache_opts(level, options):
 
 
 
+def parallel_lookahead(options):
+    """The L2 to L3 link latency in ticks. It is the lookahead between the
+    threads of the cores and the thread of the L3 and memory, so it is
+    also the simulation quantum with --parallel-cores.
+    """
+    m5.ticks.fixGlobalFrequency()
+    return m5.ticks.fromSeconds(
+        options.parallel_lookahead / convert.toFrequency(options.cpu_clock)
+    )
+
+
+def _partition_core(options, system, i):
+    """Move core i and its private caches to an event queue of their own,
+    and return the port that its L2 should connect to: a bridge to the
+    L3, which carries the L2 to L3 link latency.
+    """
+    cpu = system.cpu[i]
+    if not options.parallel_serial:
+        cpu.eventq_index = i + 1
+    cpu.l3_bridge = ThreadBridge(
+        delay=f"{parallel_lookahead(options)}t", eventq_index=0
+    )
+    cpu.l3_bridge.out_port = system.tol3bus.cpu_side_ports
+    return cpu.l3_bridge.in_port
+
+
 def config_3L_cache(options, system):
     if options.external_memory_system:
         print("External caches and internal caches are exclusive options.\n")
@@ -249,9 +276,14 @@ def config_3L_cache(options, system):
             icache, dcache, l2cache, iwalkcache, dwalkcache
         )
 
+        if options.parallel_cores:
+            l3_port = _partition_core(options, system, i)
+        else:
+            l3_port = system.tol3bus.cpu_side_ports
+
         system.cpu[i].createInterruptController()
         system.cpu[i].connectAllPorts(
-            system.tol3bus.cpu_side_ports,
+            l3_port,
             system.membus.cpu_side_ports,
             system.membus.mem_side_ports if not options.maa else system.membusnc.mem_side_ports,
         )
@@ -50,8 +50,8 @@ isa_string_map = {
 
 def config_etrace(cpu_cls, cpu_list, options):
     if issubclass(cpu_cls, m5.objects.DerivO3CPU):
-        # Assign the same file name to all cpus for now. This must be
-        # revisited when creating elastic traces for multi processor systems.
+        # The probe prefixes the file names with its own name, so every cpu
+        # writes its own pair of traces, e.g. system.cpu0.traceListener.*
         for cpu in cpu_list:
             # Attach the elastic trace probe listener. Set the protobuf trace
             # file names. Set the dependency window size equal to the cpu it
@@ -60,6 +60,7 @@ def config_etrace(cpu_cls, cpu_list, options):
                 instFetchTraceFile=options.inst_trace_file,
                 dataDepTraceFile=options.data_trace_file,
                 depWindowSize=3 * cpu.numROBEntries,
+                traceWorkItemsOnly=options.etrace_work_items_only,
             )
             # Make the number of entries in the ROB, LQ and SQ very
             # large so that there are no stalls due to resource
@@ -70,6 +70,9 @@ def _get_maa_opts(options):
         opts["num_ALU_lanes"] = getattr(options, "maa_num_ALU_lanes")
     
     opts["num_memory_channels"] = options.mem_channels
+
+    if getattr(options, "maa_trace_record", ""):
+        opts["trace_file"] = options.maa_trace_record
     
     addr_ranges = []
     start = options.mem_size
@@ -133,8 +136,17 @@ def config_maa(options, system):
     opts = _get_maa_opts(options)
     system.maa = SharedMAA(clk_domain=system.cpu_clk_domain, **opts)
 
-    # CPU side is derived by the memory side of the memory bus
-    system.maa.cpu_side = system.membus.mem_side_ports
+    if getattr(options, "maa_trace_replay", ""):
+        # The trace driver replays the recorded CPU-side requests directly
+        system.maa_trace_driver = MAATraceDriver(
+            clk_domain=system.cpu_clk_domain,
+            trace_file=options.maa_trace_replay,
+            maa=system.maa,
+        )
+        system.maa.cpu_side = system.maa_trace_driver.port
+    else:
+        # CPU side is derived by the memory side of the memory bus
+        system.maa.cpu_side = system.membus.mem_side_ports
     # LLC side derives the cpu side of the L3 bus
     
     # Increasing LLC side packets to accommodate the MAA routing table
@@ -196,6 +196,26 @@ def addNoISAOptions(parser):
     parser.add_argument("--num-dirs", type=int, default=1)
     parser.add_argument("--num-l2caches", type=int, default=1)
     parser.add_argument("--num-l3caches", type=int, default=1)
+    parser.add_argument(
+        "--parallel-cores",
+        action="store_true",
+        help="Simulate each core and its private caches on a host thread "
+        "of its own, synchronizing with the L3 and memory every "
+        "--parallel-lookahead cycles (requires --l3cache)",
+    )
+    parser.add_argument(
+        "--parallel-lookahead",
+        type=int,
+        default=10,
+        help="Latency of the L2 to L3 link in CPU cycles with "
+        "--parallel-cores, which is also the simulation quantum",
+    )
+    parser.add_argument(
+        "--parallel-serial",
+        action="store_true",
+        help="Partition the system as with --parallel-cores, but simulate "
+        "it on one thread, as a reference for validation",
+    )
     parser.add_argument("--l1d_size", type=str, default="64kB")
     parser.add_argument("--l1i_size", type=str, default="32kB")
     parser.add_argument("--l2_size", type=str, default="2MB")
@@ -226,6 +246,8 @@ def addNoISAOptions(parser):
     parser.add_argument("--maa_num_request_table_entries_per_address", type=int, default=16, help="Number of entries in the request table per address")
     parser.add_argument("--maa_l2_uncacheable", action="store_true", help="Enable uncacheable L2 cache for MAA")
     parser.add_argument("--maa_l3_uncacheable", action="store_true", help="Enable uncacheable L3 cache for MAA")
+    parser.add_argument("--maa_trace_record", type=str, default="", help="Record the MAA CPU-side request stream to this file in the output directory")
+    parser.add_argument("--maa_trace_replay", type=str, default="", help="Drive the MAA from a recorded trace instead of the CPUs")
     parser.add_argument("--l1d_repl_policy",  default="LRURP",
                     choices=ObjectList.rp_list.get_names(),
                     help="""
@@ -461,6 +483,12 @@ def addCommonOptions(parser, default_isa: Optional[ISA] = None):
         help="""Enable capture of data dependency and instruction
                       fetch traces using elastic trace probe.""",
     )
+    parser.add_argument(
+        "--etrace-work-items-only",
+        action="store_true",
+        help="""Restrict elastic trace capture to the region of
+                      interest between work item begin and end markers.""",
+    )
     # Trace file paths input to trace probe in a capture simulation and input
     # to Trace CPU in a replay simulation
     parser.add_argument(
@@ -869,6 +897,29 @@ def addSEOptions(parser):
         action="store_true",
         help="Wait for remote GDB to connect.",
     )
+    parser.add_argument(
+        "--map-file-pages",
+        action="store_true",
+        help="Map the pages of files the workload mmaps copy-on-write "
+        "into the guest memory instead of copying them.",
+    )
+    parser.add_argument(
+        "--large-pages",
+        action="append",
+        type=str,
+        default=[],
+        help="Map anonymous memory with large pages of this size, e.g. "
+        "2MiB, where the workload's mappings cover them. Can be given "
+        "more than once.",
+    )
+    parser.add_argument(
+        "--checkpoint-before-roi",
+        default=False,
+        action="store_true",
+        help="With a KVM CPU, checkpoint at the first m5_work_begin or "
+        "m5_add_mem_region, right after executing it. The memory regions "
+        "registered so far are part of the checkpoint.",
+    )
 
 
 def addFSOptions(parser):
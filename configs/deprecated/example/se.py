@@ -114,6 +114,10 @@ def get_processes(args):
             process.output = outputs[idx]
         if len(errouts) > idx:
             process.errout = errouts[idx]
+        if args.map_file_pages:
+            process.mapFilePages = True
+        if args.large_pages:
+            process.largePageSizes = args.large_pages
 
         multiprocesses.append(process)
         idx += 1
@@ -305,8 +309,25 @@ system.workload = SEWorkload.init_compatible(mp0_path)
 
 if args.wait_gdb:
     system.workload.wait_for_remote_gdb = True
+if args.checkpoint_before_roi:
+    if not ObjectList.is_kvm_cpu(CPUClass):
+        fatal("--checkpoint-before-roi requires a KVM CPU")
+    system.workload.checkpoint_before_roi = True
 Simulation.setWorkCountOptions(system, args)
 
 root = Root(full_system=False, system=system)
+if args.parallel_cores:
+    if not (args.caches and args.l2cache and args.l3cache) or args.ruby:
+        fatal("--parallel-cores requires --caches --l2cache --l3cache.")
+    # The cores only reach the L3 through ThreadBridges, which cannot
+    # carry timing snoops between the threads, so the cores must not
+    # share memory
+    if args.smt or len(multiprocesses) != np or args.maa:
+        fatal(
+            "--parallel-cores requires a process of its own per core, "
+            "and does not support --smt or --maa: caches on different "
+            "threads cannot snoop each other."
+        )
+    root.sim_quantum = CacheConfig.parallel_lookahead(args)
 print("Running simulation from SE python script...")
 Simulation.run(args, root, system, FutureClass)
\ No newline at end of file
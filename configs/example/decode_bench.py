@@ -0,0 +1,127 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Host-speed benchmark for instruction fetch and decode.
+
+Runs one of the kernels in tests/test-progs/hpc-loops on a single x86 CPU
+in SE mode and reports how long the simulation took on the host. The
+kernels are tight loops, so almost every fetch hits in the decoder's
+predecoded instruction cache; comparing the host instruction rate across
+builds shows the cost of the decode path. To run the whole suite:
+
+    for k in triad spmv stencil gather; do
+        build/X86/gem5.opt configs/example/decode_bench.py --kernel $k
+    done
+"""
+
+import argparse
+import os
+import time
+
+import m5
+from m5.objects import *
+
+thispath = os.path.dirname(os.path.realpath(__file__))
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument(
+    "--binary",
+    default=os.path.join(
+        thispath, "../../tests/test-progs/hpc-loops/bin/hpc-loops"
+    ),
+    help="hpc-loops binary, built with tests/test-progs/hpc-loops/src",
+)
+parser.add_argument(
+    "--kernel",
+    default="all",
+    choices=["triad", "spmv", "stencil", "gather", "all"],
+    help="Kernel to run",
+)
+parser.add_argument(
+    "--iterations", type=int, default=10, help="Iterations of the kernel"
+)
+parser.add_argument(
+    "--cpu-type",
+    default="atomic",
+    choices=["atomic", "timing", "o3"],
+    help="CPU model to run the kernel on",
+)
+
+args = parser.parse_args()
+
+cpu_classes = {
+    "atomic": X86AtomicSimpleCPU,
+    "timing": X86TimingSimpleCPU,
+    "o3": X86O3CPU,
+}
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="3GHz", voltage_domain=VoltageDomain()
+)
+system.mem_ranges = [AddrRange("512MB")]
+
+system.cpu = cpu_classes[args.cpu_type]()
+system.mem_mode = system.cpu.memory_mode()
+
+system.membus = SystemXBar()
+system.cpu.icache_port = system.membus.cpu_side_ports
+system.cpu.dcache_port = system.membus.cpu_side_ports
+system.cpu.createInterruptController()
+system.cpu.interrupts[0].pio = system.membus.mem_side_ports
+system.cpu.interrupts[0].int_requestor = system.membus.cpu_side_ports
+system.cpu.interrupts[0].int_responder = system.membus.mem_side_ports
+system.system_port = system.membus.cpu_side_ports
+
+system.mem_ctrl = SimpleMemory(range=system.mem_ranges[0])
+system.mem_ctrl.port = system.membus.mem_side_ports
+
+system.workload = SEWorkload.init_compatible(args.binary)
+process = Process()
+process.cmd = [args.binary, args.kernel, str(args.iterations)]
+system.cpu.workload = process
+system.cpu.createThreads()
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+start = time.perf_counter()
+exit_event = m5.simulate()
+host_seconds = time.perf_counter() - start
+
+insts = system.cpu.totalInsts()
+print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
+print(
+    "Decode benchmark: %s kernel, %d iterations, %s cpu"
+    % (args.kernel, args.iterations, args.cpu_type)
+)
+print(
+    "%d instructions in %.3f host seconds (%.0f inst/s)"
+    % (insts, host_seconds, insts / host_seconds)
+)
@@ -0,0 +1,147 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Host-speed microbenchmark for the Garnet routers.
+
+Synthetic traffic generators inject packets into a Garnet mesh (build with
+PROTOCOL=Garnet_standalone). At the default low injection rate most
+routers are idle in most cycles, which is where the time spent evaluating
+every port of a router shows up. The script simulates a fixed number of
+cycles and reports how long that took on the host. The simulated results
+do not depend on the host-side router implementation, so the stats.txt of
+two builds can be diffed to check that they are cycle-identical.
+"""
+
+import argparse
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import Options
+from ruby import Ruby
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+Options.addNoISAOptions(parser)
+
+parser.add_argument(
+    "--synthetic",
+    default="uniform_random",
+    choices=[
+        "uniform_random",
+        "tornado",
+        "bit_complement",
+        "bit_reverse",
+        "bit_rotation",
+        "neighbor",
+        "shuffle",
+        "transpose",
+    ],
+)
+parser.add_argument(
+    "-i",
+    "--injectionrate",
+    type=float,
+    default=0.02,
+    help="Injection rate in packets per cycle per node",
+)
+parser.add_argument(
+    "--sim-cycles",
+    type=int,
+    default=100000,
+    help="Number of cycles the generators inject for",
+)
+
+Ruby.define_options(parser)
+
+# An 8x8 mesh with one generator and one directory per router
+parser.set_defaults(
+    network="garnet",
+    topology="Mesh_XY",
+    num_cpus=64,
+    num_dirs=64,
+    mesh_rows=8,
+)
+
+args = parser.parse_args()
+
+cpus = [
+    GarnetSyntheticTraffic(
+        num_packets_max=-1,
+        single_sender=-1,
+        single_dest=-1,
+        sim_cycles=args.sim_cycles,
+        traffic_type=args.synthetic,
+        inj_rate=args.injectionrate,
+        inj_vnet=-1,
+        precision=3,
+        num_dest=args.num_dirs,
+    )
+    for i in range(args.num_cpus)
+]
+
+system = System(cpu=cpus, mem_ranges=[AddrRange(args.mem_size)])
+
+system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+system.clk_domain = SrcClockDomain(
+    clock=args.sys_clock, voltage_domain=system.voltage_domain
+)
+
+Ruby.create_system(args, False, system)
+
+system.ruby.clk_domain = SrcClockDomain(
+    clock=args.ruby_clock, voltage_domain=system.voltage_domain
+)
+
+for i, ruby_port in enumerate(system.ruby._cpu_ports):
+    cpus[i].test = ruby_port.in_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.ticks.setGlobalFrequency("1ps")
+
+m5.instantiate()
+
+start = time.perf_counter()
+exit_event = m5.simulate(args.abs_max_tick)
+host_seconds = time.perf_counter() - start
+
+print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
+print(
+    "Garnet router benchmark: %d routers, %s traffic, injection rate %.3f"
+    % (len(system.ruby.network.routers), args.synthetic, args.injectionrate)
+)
+print(
+    "%d ticks in %.3f host seconds (%.0f ticks/s)"
+    % (m5.curTick(), host_seconds, m5.curTick() / host_seconds)
+)
@@ -0,0 +1,133 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script drives a memory device with indirect (gather, scatter or
+read-modify-write) traffic: the generator walks an index array and accesses
+``target[index[i]]``, waiting for each index to be read before accessing its
+target.
+
+The indices come from a synthetic distribution or from a file, e.g. the
+column indices of a sparse matrix in Matrix Market format:
+
+```
+gem5 configs/example/gem5_library/indirect_traffic.py --access rmw \
+    --distribution mtx --index-file matrix.mtx
+```
+"""
+
+import argparse
+
+from gem5.components.boards.test_board import TestBoard
+from gem5.components.memory.dram_interfaces.hbm import HBM_2000_4H_1x64
+from gem5.components.memory.hbm import HighBandwidthMemory
+from gem5.components.processors.indirect_generator import IndirectGenerator
+from gem5.simulate.simulator import Simulator
+
+parser = argparse.ArgumentParser(
+    description="An indirect access traffic generator driving a gem5 "
+    "memory component."
+)
+
+parser.add_argument(
+    "--access",
+    type=str,
+    default="load",
+    choices=["load", "store", "rmw"],
+    help="What to do with each target element.",
+)
+parser.add_argument(
+    "--distribution",
+    type=str,
+    default="uniform",
+    choices=["uniform", "zipf", "powerlaw", "file", "mtx"],
+    help="Where the index values come from.",
+)
+parser.add_argument(
+    "--index-file",
+    type=str,
+    default="",
+    help="Index file for the file and mtx distributions.",
+)
+parser.add_argument(
+    "--num-indices",
+    type=int,
+    default=1 << 16,
+    help="Number of indices, 0 for all of a file or power-law graph.",
+)
+parser.add_argument(
+    "--num-targets",
+    type=int,
+    default=1 << 20,
+    help="Number of target elements, 0 to derive it from the file.",
+)
+parser.add_argument(
+    "--skew",
+    type=float,
+    default=1.0,
+    help="Exponent of the zipf and powerlaw distributions.",
+)
+parser.add_argument(
+    "--mlp",
+    type=int,
+    default=16,
+    help="Maximum number of requests in flight.",
+)
+
+args = parser.parse_args()
+
+# Single pair of HBM2 pseudo channels. This can be replaced with any
+# single ported memory device
+memory = HighBandwidthMemory(HBM_2000_4H_1x64, 1, 128)
+
+# The index array sits at the start of memory and the target array right
+# after it, both with 4 byte elements.
+index_bytes = 4 * max(args.num_indices, 1 << 20)
+generator = IndirectGenerator(
+    duration="1ms",
+    rate="32GiB/s",
+    index_addr=0,
+    index_size=4,
+    target_addr=index_bytes,
+    word_size=4,
+    access=args.access,
+    distribution=args.distribution,
+    index_file=args.index_file,
+    num_indices=args.num_indices,
+    num_targets=args.num_targets,
+    skew=args.skew,
+    mlp=args.mlp,
+)
+
+board = TestBoard(
+    clk_freq="1GHz",  # Ignored for these generators
+    generator=generator,
+    memory=memory,
+    cache_hierarchy=None,
+)
+
+simulator = Simulator(board=board)
+simulator.run()
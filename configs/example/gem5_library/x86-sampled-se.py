@@ -0,0 +1,160 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script shows how to sample the region of interest of an SE workload
+SMARTS-style with the SampledSimulator. Atomic cores with caches warm the
+caches and the branch predictors between samples, and O3 cores measure
+short samples after a detailed warm-up. The region of interest is marked by
+m5_work_begin and m5_work_end in the workload.
+
+Usage
+-----
+
+```
+scons build/X86/gem5.opt
+./build/X86/gem5.opt \
+    configs/example/gem5_library/x86-sampled-se.py \
+    --binary <path> [--ramulator-config <path>]
+```
+
+The mean IPC of every core and its confidence interval are written to
+m5out/sampling.json.
+"""
+
+import argparse
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.cachehierarchies.classic.private_l1_private_l2_cache_hierarchy import (
+    PrivateL1PrivateL2CacheHierarchy,
+)
+from gem5.components.memory.single_channel import SingleChannelDDR4_2400
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+from gem5.isas import ISA
+from gem5.resources.resource import BinaryResource
+from gem5.simulate.sampled_simulator import SampledSimulator
+from gem5.utils.requires import requires
+
+requires(isa_required=ISA.X86)
+
+parser = argparse.ArgumentParser(
+    description="SMARTS-style sampled simulation of an SE workload."
+)
+parser.add_argument(
+    "--binary", type=str, required=True, help="The workload binary."
+)
+parser.add_argument(
+    "--arguments",
+    type=str,
+    nargs="*",
+    default=[],
+    help="The arguments of the workload.",
+)
+parser.add_argument("--num-cores", type=int, default=1)
+parser.add_argument(
+    "--ramulator-config",
+    type=str,
+    default=None,
+    help="Use Ramulator2 with this configuration as the main memory.",
+)
+parser.add_argument("--mem-size", type=str, default="4GB")
+parser.add_argument("--functional-warming-insts", type=int, default=1000000)
+parser.add_argument("--detailed-warmup-insts", type=int, default=20000)
+parser.add_argument("--measurement-insts", type=int, default=10000)
+parser.add_argument(
+    "--max-samples",
+    type=int,
+    default=0,
+    help="Stop sampling after this many samples, 0 for no limit.",
+)
+parser.add_argument(
+    "--stats",
+    type=str,
+    nargs="*",
+    default=None,
+    help="Stats to sample, by their full name. Defaults to the IPC of "
+    "every O3 core.",
+)
+parser.add_argument(
+    "--whole-program",
+    action="store_true",
+    help="Sample the whole program instead of its region of interest.",
+)
+
+args = parser.parse_args()
+
+if args.ramulator_config:
+    from gem5.components.memory.ramulator2 import Ramulator2Memory
+
+    memory = Ramulator2Memory(
+        config_path=args.ramulator_config, size=args.mem_size
+    )
+else:
+    memory = SingleChannelDDR4_2400(size=args.mem_size)
+
+processor = SimpleSwitchableProcessor(
+    starting_core_type=CPUTypes.ATOMIC,
+    switch_core_type=CPUTypes.O3,
+    isa=ISA.X86,
+    num_cores=args.num_cores,
+)
+
+board = SimpleBoard(
+    clk_freq="3GHz",
+    processor=processor,
+    memory=memory,
+    cache_hierarchy=PrivateL1PrivateL2CacheHierarchy(
+        l1d_size="32KiB", l1i_size="32KiB", l2_size="256KiB"
+    ),
+)
+
+board.set_se_binary_workload(
+    BinaryResource(local_path=args.binary), arguments=args.arguments
+)
+
+simulator = SampledSimulator(
+    board=board,
+    functional_warming_insts=args.functional_warming_insts,
+    detailed_warmup_insts=args.detailed_warmup_insts,
+    measurement_insts=args.measurement_insts,
+    stats=args.stats,
+    roi_only=not args.whole_program,
+    max_samples=args.max_samples,
+)
+simulator.run()
+
+for name, result in simulator.get_sample_results()["stats"].items():
+    if "ci_low" in result:
+        print(
+            f"{name}: {result['mean']:.4f} "
+            f"[{result['ci_low']:.4f}, {result['ci_high']:.4f}] "
+            f"over {result['samples']} samples"
+        )
+    else:
+        print(f"{name}: {result.get('mean')} over {result['samples']} samples")
@@ -0,0 +1,118 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Replay an MAA trace without a CPU model.
+
+Record a trace by running the workload once with se.py and
+--maa_trace_record=<file>. The trace lands in the output directory, next to
+<file>.mem, an image of the physical memory taken when the MAA received its
+first request. The MAA loads data such as indices from memory, so the replay
+initializes memory from that image, which has to stay next to the trace.
+The image is only taken once: data the CPUs write after the first MAA
+request, e.g. between MAA phases, is not replayed, and such replays diverge
+from the recorded run.
+Keep --mem-size the same as in the recorded run. The trace can then be
+replayed against different MAA, cache and DRAM configurations:
+
+    build/X86/gem5.opt configs/example/maa_trace_replay.py \\
+        --maa_trace_replay=m5out/<file> --mem-type=Ramulator2 \\
+        --maa_num_indirect_access_units=4 ...
+
+The replay keeps the recorded request order and think times. It waits on
+instruction dispatch and SPD ready reads, so the reported ticks reflect
+the configuration under test. No CPU caches exist in the replayed system,
+so the MAA invalidations of SPD lines always complete immediately.
+"""
+
+import argparse
+import sys
+
+import m5
+from m5.objects import *
+from m5.util import (
+    addToPath,
+    fatal,
+)
+
+addToPath("../")
+
+from common import (
+    CacheConfig,
+    MAAConfig,
+    MemConfig,
+    Options,
+    Simulation,
+)
+
+parser = argparse.ArgumentParser()
+Options.addCommonOptions(parser)
+args = parser.parse_args()
+
+if not args.maa_trace_replay:
+    fatal("--maa_trace_replay is required.\n")
+if args.ruby:
+    fatal("This script only supports the classic memory system.\n")
+
+# The MAA hangs off the L3 and the non-coherent memory bus, build those
+# without any cores in front of them.
+args.maa = True
+args.caches = args.l2cache = args.l3cache = True
+args.num_cpus = 0
+
+system = System(
+    mem_mode="timing",
+    mem_ranges=[AddrRange(args.mem_size)],
+    cache_line_size=args.cacheline_size,
+)
+
+system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+system.clk_domain = SrcClockDomain(
+    clock=args.sys_clock, voltage_domain=system.voltage_domain
+)
+system.cpu_voltage_domain = VoltageDomain()
+system.cpu_clk_domain = SrcClockDomain(
+    clock=args.cpu_clock, voltage_domain=system.cpu_voltage_domain
+)
+
+MemClass = Simulation.setMemClass(args)
+system.membus = SystemXBar()
+system.membus.width = 32
+system.system_port = system.membus.cpu_side_ports
+system.membusnc = SystemXBarNC()
+system.membusnc.width = 16
+system.membusnc.cpu_side_ports = system.membus.mem_side_ports
+
+CacheConfig.config_3L_cache(args, system)
+MemConfig.config_mem(args, system)
+MAAConfig.config_maa(args, system)
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+system.maa.addRamulatorInstance(system.mem_ctrls[0])
+
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
@@ -0,0 +1,137 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Host-speed microbenchmark for the Ruby memory system and network.
+
+Memory testers hammer a few cache lines through tiny caches, which keeps
+the protocol controllers and the network busy with coherence messages.
+The script runs for a fixed number of ticks and reports how long that took
+on the host, so that changes to message handling can be compared across
+protocols (select one at build time) and network models (--network).
+"""
+
+import argparse
+import sys
+import time
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import Options
+from ruby import Ruby
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+Options.addNoISAOptions(parser)
+
+parser.add_argument(
+    "--bench-ticks",
+    type=int,
+    default=10000000,
+    help="Number of ticks (1 tick = 1ns) to simulate",
+)
+parser.add_argument(
+    "--randomization",
+    action="store_true",
+    help="Randomize message delays in the Ruby message buffers",
+)
+
+Ruby.define_options(parser)
+
+args = parser.parse_args()
+
+# Small caches keep the traffic coherence heavy.
+args.l1d_size = "256B"
+args.l1i_size = "256B"
+args.l2_size = "512B"
+args.l3_size = "1kB"
+args.l1d_assoc = 2
+args.l1i_assoc = 2
+args.l2_assoc = 2
+args.l3_assoc = 2
+
+block_size = 64
+
+if args.num_cpus > block_size:
+    print(
+        "Error: Number of testers %d limited to %d because of false sharing"
+        % (args.num_cpus, block_size)
+    )
+    sys.exit(1)
+
+cpus = [
+    MemTest(
+        max_loads=0,
+        percent_functional=0,
+        percent_uncacheable=0,
+        progress_interval=0,
+    )
+    for i in range(args.num_cpus)
+]
+
+system = System(cpu=cpus, mem_ranges=[AddrRange(args.mem_size)])
+
+system.voltage_domain = VoltageDomain(voltage=args.sys_voltage)
+system.clk_domain = SrcClockDomain(
+    clock=args.sys_clock, voltage_domain=system.voltage_domain
+)
+
+Ruby.create_system(args, False, system)
+
+system.ruby.clk_domain = SrcClockDomain(
+    clock=args.ruby_clock, voltage_domain=system.voltage_domain
+)
+system.ruby.randomization = args.randomization
+
+for i, cpu in enumerate(cpus):
+    cpu.port = system.ruby._cpu_ports[i].in_ports
+    system.ruby._cpu_ports[i].deadlock_threshold = 5000000
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.ticks.setGlobalFrequency("1ns")
+
+m5.instantiate()
+
+start = time.perf_counter()
+exit_event = m5.simulate(args.bench_ticks)
+host_seconds = time.perf_counter() - start
+
+print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
+print(
+    "Ruby network benchmark: %d cpus, %s network, randomization %s"
+    % (args.num_cpus, args.network, "on" if args.randomization else "off")
+)
+print(
+    "%d ticks in %.3f host seconds (%.0f ticks/s)"
+    % (m5.curTick(), host_seconds, m5.curTick() / host_seconds)
+)
@@ -0,0 +1,11 @@
+# Runs the initialization natively with KVM and checkpoints right after the
+# first m5_work_begin or m5_add_mem_region. The checkpoint restores like the
+# AtomicSimpleCPU ones from gen_checkpoint_gem5.sh, e.g. with
+# restore_checkpoint_gem5.sh. Needs /dev/kvm on an x86 host.
+
+if [ -n "$3" ]
+then
+    export OMP_PROC_BIND=false; export OMP_NUM_THREADS=4; ~/gem5-hpc/build/X86/gem5.fast --outdir=$1 ~/gem5-hpc/configs/deprecated/example/se.py --cpu-type X86KvmCPU -n 4 --mem-size '16GB' --checkpoint-before-roi --max-checkpoints 1 --cmd "\"$2\"" --options "\"$3\""
+else
+    export OMP_PROC_BIND=false; export OMP_NUM_THREADS=4; ~/gem5-hpc/build/X86/gem5.fast --outdir=$1 ~/gem5-hpc/configs/deprecated/example/se.py --cpu-type X86KvmCPU -n 4 --mem-size '16GB' --checkpoint-before-roi --max-checkpoints 1 --cmd "\"$2\""
+fi
@@ -73,6 +73,20 @@ all_instruction_types = {"LDFP": "commitStats0.committedInstType::FloatMemRead",
                          "VEC": "commitStats0.committedInstType::Vector",
                          "Total": "commitStats0.committedInstType::total"}
 
+# Top-down slot counters of the O3 CPUs, summed over all cores
+all_top_down_stats = {"TD-Slots": "topDown.slots",
+                      "TD-Renamed": "topDown.renamedSlots",
+                      "TD-Retiring": "topDown.retiredSlots",
+                      "TD-Recovery": "topDown.recoverySlots",
+                      "TD-Frontend": "topDown.frontEndSlots",
+                      "TD-Backend": "topDown.backEndSlots",
+                      "TD-Load": "topDown.loadBoundSlots",
+                      "TD-Store": "topDown.storeBoundSlots",
+                      "TD-Load-L1": "topDown.loadBoundLevel::L1",
+                      "TD-Load-L2": "topDown.loadBoundLevel::L2",
+                      "TD-Load-L3": "topDown.loadBoundLevel::L3",
+                      "TD-Load-Mem": "topDown.loadBoundLevel::Mem"}
+
 SPD_load_latencies = ""
 
 all_tiles = [1024, 2048, 4096, 8192, 16384]
@@ -92,6 +106,7 @@ def parse_gem5_stats(stats, mode):
     maa_indirect_cycles = {}
     cache_stats = {}
     instruction_types = {}
+    top_down = {}
     for maa_cycle in all_maa_cycles:
         maa_cycles[maa_cycle] = 0
     for maa_indirect_cycle in all_maa_indirect_cycles:
@@ -100,6 +115,8 @@ def parse_gem5_stats(stats, mode):
         cache_stats[cache_stat] = 0
     for instruction_type in all_instruction_types.keys():
         instruction_types[instruction_type] = 0
+    for top_down_stat in all_top_down_stats.keys():
+        top_down[top_down_stat] = 0
 
     if os.path.exists(stats):    
         with open(stats, "r") as f:
@@ -136,6 +153,11 @@ def parse_gem5_stats(stats, mode):
                             instruction_types[instruction_type] += int(words[1])
                             found = True
                             break
+                    for top_down_stat in all_top_down_stats.keys():
+                        if words[0].endswith("." + all_top_down_stats[top_down_stat]):
+                            top_down[top_down_stat] += int(words[1])
+                            found = True
+                            break
                 if found:
                     continue
                 if mode == "MAA" or mode == "maa":
@@ -156,7 +178,7 @@ def parse_gem5_stats(stats, mode):
     # else:
     #     print(f"File not found: {stats}")
 
-    return cycles, maa_cycles, maa_indirect_cycles, cache_stats, instruction_types
+    return cycles, maa_cycles, maa_indirect_cycles, cache_stats, instruction_types, top_down
 
 def parse_ramulator_stats(stats):
     DRAM_RD = 0
@@ -234,6 +256,8 @@ for cache_stat in all_cache_stats.keys():
     print(f"{cache_stat}", end=",")
 for instruction_type in all_instruction_types.keys():
     print(f"{instruction_type}", end=",")
+for top_down_stat in all_top_down_stats.keys():
+    print(f"{top_down_stat}", end=",")
 print("LSQ-LD-OCC", end=",")
 print("DRAM-RD,DRAM-WR,DRAM-ACT,DRAM-RD-BW,DRAM-WR-BW,DRAM-total-BW,DRAM-RB-hitrate,DRAM-CTRL-occ", end=",")
 print()
@@ -244,7 +268,7 @@ for mode in ["maa", "base"]:
             if mode == "base" and (l2 == "nol2" or l3 == "nol3"):
                 continue
             stats = f"tests_16T_{l2}_{l3}_{mode}/stats.txt"
-            cycles, maa_cycles, maa_indirect_cycles, cache_stats, instruction_types = parse_gem5_stats(stats, mode)
+            cycles, maa_cycles, maa_indirect_cycles, cache_stats, instruction_types, top_down = parse_gem5_stats(stats, mode)
             logs = f"tests_16T_{l2}_{l3}_{mode}/logs_run.txt"
             DRAM_RD, DRAM_WR, DRAM_ACT, DRAM_RD_BW, DRAM_WR_BW, DRAM_total_BW, DRAM_RB_hitrate, DRAM_CTRL_occ = parse_ramulator_stats(logs)
             print(f"{mode},{l2},{l3},{cycles}", end=",")
@@ -256,6 +280,8 @@ for mode in ["maa", "base"]:
                 print(cache_stats[cache_stat], end=",")
             for instruction_type in all_instruction_types.keys():
                 print(instruction_types[instruction_type], end=",")
+            for top_down_stat in all_top_down_stats.keys():
+                print(top_down[top_down_stat], end=",")
             if cycles == 0:
                 print(0, end=",")
             else:
@@ -273,6 +299,8 @@ for cache_stat in all_cache_stats.keys():
     print(f"{cache_stat}", end=",")
 for instruction_type in all_instruction_types.keys():
     print(f"{instruction_type}", end=",")
+for top_down_stat in all_top_down_stats.keys():
+    print(f"{top_down_stat}", end=",")
 print("LSQ-LD-OCC", end=",")
 print("DRAM-RD,DRAM-WR,DRAM-ACT,DRAM-RD-BW,DRAM-WR-BW,DRAM-total-BW,DRAM-RB-hitrate,DRAM-CTRL-occ", end=",")
 print()
@@ -287,7 +315,7 @@ for kernel in all_kernels:
                 all_cycles = {}
                 for mode in all_modes:
                     stats = f"{DATA_DIR}/{kernel}/M{mode}/D{distance_str}/T{tile_size_str}/S{size_str}/FP32/stats.txt"
-                    cycles, maa_cycles, maa_indirect_cycles, cache_stats, instruction_types = parse_gem5_stats(stats, mode)
+                    cycles, maa_cycles, maa_indirect_cycles, cache_stats, instruction_types, top_down = parse_gem5_stats(stats, mode)
                     logs = f"{DATA_DIR}/{kernel}/M{mode}/D{distance_str}/T{tile_size_str}/S{size_str}/FP32/logs.txt"
                     DRAM_RD, DRAM_WR, DRAM_ACT, DRAM_RD_BW, DRAM_WR_BW, DRAM_total_BW, DRAM_RB_hitrate, DRAM_CTRL_occ = parse_ramulator_stats(logs)
                     all_cycles[mode] = cycles
@@ -300,6 +328,8 @@ for kernel in all_kernels:
                         print(cache_stats[cache_stat], end=",")
                     for instruction_type in all_instruction_types.keys():
                         print(instruction_types[instruction_type], end=",")
+                    for top_down_stat in all_top_down_stats.keys():
+                        print(top_down[top_down_stat], end=",")
                     print(((instruction_types["LDINT"] + instruction_types["LDFP"]) * cache_stats["Avg-Latency"]) / cycles, end=",")
                     print(f"{DRAM_RD},{DRAM_WR},{DRAM_ACT},{DRAM_RD_BW},{DRAM_WR_BW},{DRAM_total_BW},{DRAM_RB_hitrate},{DRAM_CTRL_occ}", end=",")
                     print()
@@ -132,7 +132,11 @@ def add_command(cpu_buffer_enlarge_factor, cpu_register_enlarge_factor, cpu_widt
     COMMAND += "| awk '{ print strftime(), $0; fflush() }' "
     COMMAND += f"| tee {m5out_addr}/logs.txt "
     if checkpoint_address != None:
-        tasks.append(f"rm -r {m5out_addr} &> /dev/null; sleep 1; mkdir -p {m5out_addr} 2>&1 > /dev/null; sleep 1; cp -r {checkpoint_address} {m5out_addr}/; sleep 1; {COMMAND}; sleep 1;")
+        # Restoring only reads the checkpoint, so link to its files rather
+        # than copying them. All the jobs then restore from the same memory
+        # images, which share the host page cache when the checkpoint was
+        # taken with system.image_memory_checkpoint.
+        tasks.append(f"rm -r {m5out_addr} &> /dev/null; sleep 1; mkdir -p {m5out_addr} 2>&1 > /dev/null; sleep 1; cp -rs {os.path.abspath(checkpoint_address)} {m5out_addr}/; sleep 1; {COMMAND}; sleep 1;")
     else:
         tasks.append(f"rm -r {m5out_addr} &> /dev/null; sleep 1; mkdir -p {m5out_addr} 2>&1 > /dev/null; sleep 1; {COMMAND}; sleep 1;")
 
@@ -0,0 +1,168 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Validate --parallel-cores runs of se.py.
+
+Runs a workload three times: partitioned but on a single thread as the
+reference, and twice with a thread per core. The two parallel runs have to
+produce identical statistics, and the statistics of the parallel runs are
+compared against the reference.
+
+Usage:
+    validate_parallel.py --gem5 build/X86/gem5.opt --outdir val -- \\
+        -n 4 --cpu-type X86O3CPU --caches --l2cache --l3cache \\
+        --cmd "a;b;c;d" ...
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+SE_PY = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), "deprecated", "example", "se.py"
+)
+
+# statistics that measure the host rather than the simulated system
+HOST_STATS = (
+    "hostSeconds",
+    "hostTickRate",
+    "hostMemory",
+    "hostInstRate",
+    "hostOpRate",
+)
+
+
+def run(gem5, outdir, se_args):
+    os.makedirs(outdir, exist_ok=True)
+    cmd = [gem5, f"--outdir={outdir}", SE_PY] + se_args
+    print("Running:", " ".join(cmd))
+    with open(os.path.join(outdir, "log.txt"), "w") as log:
+        if subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT):
+            sys.exit(f"gem5 failed, see {outdir}/log.txt")
+    return read_stats(os.path.join(outdir, "stats.txt"))
+
+
+def read_stats(path):
+    """Read the first statistics dump as a dict of name to value."""
+    stats = {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith("---------- End"):
+                break
+            fields = line.split()
+            if len(fields) < 2 or line.startswith("-"):
+                continue
+            try:
+                stats[fields[0]] = float(fields[1])
+            except ValueError:
+                pass
+    return stats
+
+
+def differences(ref, other):
+    """Return (relative difference, name, ref, other) of differing stats."""
+    diffs = []
+    for name in sorted(set(ref) | set(other)):
+        if name in HOST_STATS:
+            continue
+        a, b = ref.get(name), other.get(name)
+        if a == b:
+            continue
+        if a is None or b is None:
+            diffs.append((float("inf"), name, a, b))
+        else:
+            diffs.append((abs(b - a) / max(abs(a), 1e-12), name, a, b))
+    return sorted(diffs, reverse=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter
+    )
+    parser.add_argument("--gem5", required=True, help="gem5 binary")
+    parser.add_argument("--outdir", required=True, help="Output directory")
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.01,
+        help="Relative difference to the reference to report [0.01]",
+    )
+    parser.add_argument(
+        "--show", type=int, default=20, help="Differences to show [20]"
+    )
+    parser.add_argument("se_args", nargs=argparse.REMAINDER)
+    args = parser.parse_args()
+
+    se_args = [a for a in args.se_args if a != "--"]
+    se_args += ["--parallel-cores"]
+
+    ref = run(
+        args.gem5,
+        os.path.join(args.outdir, "serial"),
+        se_args + ["--parallel-serial"],
+    )
+    par = [
+        run(args.gem5, os.path.join(args.outdir, f"parallel{i}"), se_args)
+        for i in range(2)
+    ]
+
+    ok = True
+    repro = differences(par[0], par[1])
+    if repro:
+        ok = False
+        print(f"Parallel runs differ in {len(repro)} statistics:")
+        for _, name, a, b in repro[: args.show]:
+            print(f"  {name}: {a} != {b}")
+    else:
+        print("Parallel runs are identical.")
+
+    diffs = differences(ref, par[0])
+    large = [d for d in diffs if d[0] > args.tolerance]
+    print(
+        f"{len(diffs)} statistics differ from the reference, "
+        f"{len(large)} by more than {args.tolerance:.1%}."
+    )
+    for rel, name, a, b in large[: args.show]:
+        print(f"  {name}: {a} -> {b} ({rel:.2%})")
+    if large:
+        ok = False
+
+    for name in ("simTicks", "simInsts"):
+        if name in ref and name in par[0]:
+            print(f"{name}: {ref[name]:.0f} -> {par[0][name]:.0f}")
+    if "hostSeconds" in ref and "hostSeconds" in par[0]:
+        print(
+            f"Host seconds: {ref['hostSeconds']} -> "
+            f"{par[0]['hostSeconds']} "
+            f"({ref['hostSeconds'] / max(par[0]['hostSeconds'], 1e-9):.2f}x)"
+        )
+
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -531,7 +531,8 @@ namespace X86ISA
                                     alignedVaddr, pte->paddr);
 
                             TlbEntry gpuEntry(p->pid(), alignedVaddr,
-                                              pte->paddr, false, false);
+                                              pte->translate(alignedVaddr),
+                                              false, false);
                             entry = insert(alignedVaddr, gpuEntry);
                         }
 
@@ -967,7 +968,8 @@ namespace X86ISA
                         pte->paddr);
 
                 sender_state->tlbEntry =
-                    new TlbEntry(p->pid(), virtPageAddr, pte->paddr, false,
+                    new TlbEntry(p->pid(), virtPageAddr,
+                                 pte->translate(virtPageAddr), false,
                                  false);
             } else {
                 sender_state->tlbEntry = nullptr;
@@ -1177,7 +1179,8 @@ namespace X86ISA
 
                     sender_state->tlbEntry =
                         new TlbEntry(p->pid(), virt_page_addr,
-                                     pte->paddr, false, false);
+                                     pte->translate(virt_page_addr),
+                                     false, false);
                 } else {
                     // If this was a prefetch, then do the normal thing if it
                     // was a successful translation.  Otherwise, send an empty
@@ -1189,7 +1192,8 @@ namespace X86ISA
 
                         sender_state->tlbEntry =
                             new TlbEntry(p->pid(), virt_page_addr,
-                                         pte->paddr, false, false);
+                                         pte->translate(virt_page_addr),
+                                         false, false);
                     } else {
                         DPRINTF(GPUPrefetch, "Prefetch failed %#x\n",
                                 alignedVaddr);
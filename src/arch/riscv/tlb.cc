@@ -467,7 +467,7 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
         if (!pte)
             return std::make_shared<GenericPageTableFault>(req->getVaddr());
 
-        paddr = pte->paddr | process->pTable->pageOffset(vaddr);
+        paddr = pte->translate(vaddr);
     }
 
     DPRINTF(TLB, "Translated (functional) %#x -> %#x.\n", vaddr, paddr);
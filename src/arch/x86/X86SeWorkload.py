@@ -32,6 +32,13 @@ class X86EmuLinux(SEWorkload):
     cxx_header = "arch/x86/linux/se_workload.hh"
     cxx_class = "gem5::X86ISA::EmuLinux"
 
+    # Only used with KVM CPUs, which trap m5ops out of the guest
+    checkpoint_before_roi = Param.Bool(
+        False,
+        "Exit for a checkpoint at the first m5_work_begin or "
+        "m5_add_mem_region, right after executing it",
+    )
+
     @classmethod
     def _is_compatible_with(cls, obj):
         return obj.get_arch() in ("x86_64", "i386") and obj.get_op_sys() in (
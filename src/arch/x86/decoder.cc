@@ -43,14 +43,9 @@ namespace X86ISA
 
 X86ISAInst::MicrocodeRom Decoder::microcodeRom;
 
-Decoder::State
-Decoder::doResetState()
+void
+Decoder::resetEmi()
 {
-    origPC = basePC + offset;
-    DPRINTF(Decoder, "Setting origPC to %#x\n", origPC);
-    instBytes = &decodePages->lookup(origPC);
-    chunkIdx = 0;
-
     emi.rex = 0;
     emi.legacy = 0;
     emi.vex = 0;
@@ -65,10 +60,22 @@ Decoder::doResetState()
 
     emi.modRM = 0;
     emi.sib = 0;
+}
+
+Decoder::State
+Decoder::doResetState()
+{
+    origPC = basePC + offset;
+    DPRINTF(Decoder, "Setting origPC to %#x\n", origPC);
+    instBytes = &decodePages->lookup(origPC);
+    chunkIdx = 0;
 
+    // A cached instruction only needs its bytes checked, emi is filled
+    // in by the state machine when they don't match.
     if (instBytes->si) {
         return FromCacheState;
     } else {
+        resetEmi();
         instBytes->chunks.clear();
         return PrefixState;
     }
@@ -154,8 +161,10 @@ Decoder::doFromCacheState()
         // The chached chunks didn't match what was fetched. Fall back to the
         // predecoder.
         instBytes->chunks[chunkIdx] = fetchChunk;
-        instBytes->chunks.resize(chunkIdx + 1);
+        while (instBytes->chunks.size() > chunkIdx + 1)
+            instBytes->chunks.pop_back();
         instBytes->si = NULL;
+        resetEmi();
         chunkIdx = 0;
         fetchChunk = instBytes->chunks[0];
         offset = origPC % sizeof(MachInst);
@@ -31,7 +31,6 @@
 
 #include <cassert>
 #include <unordered_map>
-#include <vector>
 
 #include "arch/generic/decoder.hh"
 #include "arch/x86/microcode_rom.hh"
@@ -39,6 +38,7 @@
 #include "arch/x86/types.hh"
 #include "base/bitfield.hh"
 #include "base/logging.hh"
+#include "base/small_vector.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "cpu/decode_cache.hh"
@@ -77,11 +77,16 @@ class Decoder : public InstDecoder
   protected:
     using MachInst = uint64_t;
 
+    // An instruction is at most 15 bytes long, so it spans at most three
+    // chunks. Keeping those inline means checking a cached instruction
+    // against the fetched bytes stays within its InstBytes entry.
+    static constexpr int InlineChunks = 3;
+
     struct InstBytes
     {
         StaticInstPtr si;
-        std::vector<MachInst> chunks;
-        std::vector<MachInst> masks;
+        SmallVector<MachInst, InlineChunks> chunks;
+        SmallVector<MachInst, InlineChunks> masks;
         int lastOffset;
 
         InstBytes() : lastOffset(0)
@@ -208,6 +213,9 @@ class Decoder : public InstDecoder
 
     State state = ResetState;
 
+    // Clear the parts of emi the state machine fills in.
+    void resetEmi();
+
     // Functions to handle each of the states
     State doResetState();
     State doFromCacheState();
@@ -40,17 +40,24 @@
 
 #include <sys/syscall.h>
 
+#include <gem5/asm/generic/m5ops.h>
+
+#include "arch/x86/fs_workload.hh"
 #include "arch/x86/linux/linux.hh"
 #include "arch/x86/page_size.hh"
 #include "arch/x86/process.hh"
+#include "arch/x86/pseudo_inst_abi.hh"
 #include "arch/x86/regs/int.hh"
 #include "arch/x86/regs/misc.hh"
 #include "arch/x86/se_workload.hh"
+#include "arch/x86/utility.hh"
 #include "base/trace.hh"
 #include "cpu/thread_context.hh"
 #include "kern/linux/linux.hh"
 #include "mem/se_translating_port_proxy.hh"
 #include "sim/process.hh"
+#include "sim/pseudo_inst.hh"
+#include "sim/sim_exit.hh"
 #include "sim/syscall_desc.hh"
 #include "sim/syscall_emul.hh"
 
@@ -146,6 +153,9 @@ EmuLinux::event(ThreadContext *tc)
         } else if (pc_page == PFHandlerVirtAddr) {
             pageFault(tc);
             return;
+        } else if (pc_page == UDHandlerVirtAddr) {
+            invalidOpcode(tc);
+            return;
         }
     }
     warn("Unexpected workload event at pc %#x.", pc);
@@ -175,5 +185,74 @@ EmuLinux::pageFault(ThreadContext *tc)
    }
 }
 
+/**
+ * Do what the iretq at the end of an interrupt handler does: pop the
+ * interrupt frame (rip, cs, rflags, rsp and ss) into the thread context,
+ * loading the segments from the GDT.
+ */
+static void
+popInterruptFrame(ThreadContext *tc, PortProxy &proxy, const uint64_t *frame)
+{
+    auto load_segment = [tc, &proxy](int seg, SegSelector sel) {
+        uint64_t desc;
+        proxy.readBlob(tc->readMiscReg(misc_reg::TsgBase) + sel.si * 8,
+                       &desc, sizeof(desc));
+        tc->setMiscReg(misc_reg::segSel(seg), sel);
+        installSegDesc(tc, seg, desc, true);
+    };
+
+    load_segment(segment_idx::Cs, frame[1]);
+    load_segment(segment_idx::Ss, frame[4]);
+    setRFlags(tc, frame[2]);
+    tc->setReg(int_reg::Rsp, frame[3]);
+    tc->pcState(frame[0]);
+}
+
+void
+EmuLinux::invalidOpcode(ThreadContext *tc)
+{
+    SETranslatingPortProxy proxy(tc);
+    // at this point we should have 5 values on the interrupt stack, #UD
+    // does not push an error code
+    int size = 5;
+    uint64_t is[size];
+    Addr is_addr = ISTVirtAddr + PageBytes - size * sizeof(uint64_t);
+    proxy.readBlob(is_addr, &is, sizeof(is));
+    Addr rip = is[0];
+
+    // m5ops are encoded as 0x0f 0x04 followed by a 16 bit function
+    uint8_t inst[4];
+    proxy.readBlob(rip, inst, sizeof(inst));
+    uint16_t func = inst[2] | (inst[3] << 8);
+    panic_if(inst[0] != 0x0f || inst[1] != 0x04,
+            "Invalid opcode at rip %#x\n\tInterrupt handler stack:\n"
+            "\tss: %#x\n"
+            "\trsp: %#x\n"
+            "\trflags: %#x\n"
+            "\tcs: %#x\n",
+            rip, is[4], is[3], is[2], is[1]);
+
+    uint64_t result;
+    bool recognized =
+        pseudo_inst::pseudoInst<X86PseudoInstABI>(tc, func, result);
+    panic_if(!recognized, "Unrecognized m5op %#x at rip %#x\n", func, rip);
+
+    // Return past the m5op
+    is[0] = rip + sizeof(inst);
+
+    if (params().checkpoint_before_roi && !roiReached &&
+            (func == M5OP_WORK_BEGIN || func == M5OP_ADD_MEM_REGION)) {
+        // Leave the handler before exiting, so that the checkpoint is
+        // taken in user mode rather than at the iretq of the handler,
+        // and can be restored by CPUs which do not run the handler.
+        roiReached = true;
+        popInterruptFrame(tc, proxy, is);
+        exitSimLoop("checkpoint");
+        return;
+    }
+
+    proxy.writeBlob(is_addr, &is, sizeof(is));
+}
+
 } // namespace X86ISA
 } // namespace gem5
@@ -77,6 +77,14 @@ class EmuLinux : public SEWorkload
 
     void pageFault(ThreadContext *tc);
 
+    /**
+     * Emulate an m5op that trapped with #UD while running under KVM. If
+     * checkpoint_before_roi is set, the simulation exits for a
+     * checkpoint after the first m5_work_begin or m5_add_mem_region,
+     * with the thread back in user mode right after that m5op.
+     */
+    void invalidOpcode(ThreadContext *tc);
+
     struct SyscallABI64 :
         public GenericSyscallABI64, public X86Linux::SyscallABI
     {
@@ -90,6 +98,9 @@ class EmuLinux : public SEWorkload
     };
 
   private:
+    /** Whether the ROI checkpoint was already requested. */
+    bool roiReached = false;
+
     static SyscallDescTable<SyscallABI64> syscallDescs64;
     static SyscallDescTable<SyscallABI32> syscallDescs32;
 };
@@ -186,6 +186,7 @@ X86_64Process::initState()
         Addr istPhysAddr = seWorkload->allocPhysPages(1);
         Addr tssPhysAddr = seWorkload->allocPhysPages(1);
         Addr pfHandlerPhysAddr = seWorkload->allocPhysPages(1);
+        Addr udHandlerPhysAddr = seWorkload->allocPhysPages(1);
 
         /*
          * Set up the gdt.
@@ -482,6 +483,23 @@ X86_64Process::initState()
 
         physProxy.writeBlob(idtPhysAddr + 0xE0, &PFGate, sizeof(PFGate));
 
+        // The invalid opcode gate differs from the page fault one only
+        // in the handler it points to.
+        GateDescriptorLow UDGateLow = PFGateLow;
+        UDGateLow.offsetHigh = bits(UDHandlerVirtAddr, 31, 16);
+        UDGateLow.offsetLow = bits(UDHandlerVirtAddr, 15, 0);
+
+        GateDescriptorHigh UDGateHigh = 0;
+        UDGateHigh.offset = bits(UDHandlerVirtAddr, 63, 32);
+
+        struct
+        {
+            uint64_t low;
+            uint64_t high;
+        } UDGate = {UDGateLow, UDGateHigh};
+
+        physProxy.writeBlob(idtPhysAddr + 0x60, &UDGate, sizeof(UDGate));
+
         /* System call handler */
         // First, we write to the MMIO m5ops range (0xffffc90000007000)
         // to trap out of the VM back into gem5 to emulate the system
@@ -529,6 +547,21 @@ X86_64Process::initState()
 
         physProxy.writeBlob(pfHandlerPhysAddr, faultBlob, sizeof(faultBlob));
 
+        /** Invalid opcode handler */
+        // The m5ops linked into SE workloads are the 0x0f 0x04 pseudo
+        // instructions, which the host CPU rejects with #UD. Trap out to
+        // gem5 like the other handlers; the workload emulates the m5op
+        // and moves the saved rip past it. #UD pushes no error code.
+        uint8_t udBlob[] = {
+            // mov    %rax, (0xffffc90000007000)
+            0x48, 0xa3, 0x00, 0x70, 0x00,
+            0x00, 0x00, 0xc9, 0xff, 0xff,
+            // iretq
+            0x48, 0xcf
+        };
+
+        physProxy.writeBlob(udHandlerPhysAddr, udBlob, sizeof(udBlob));
+
         /* Syscall handler */
         pTable->map(syscallCodeVirtAddr, syscallCodePhysAddr,
                     PageBytes, false);
@@ -542,6 +575,8 @@ X86_64Process::initState()
         pTable->map(ISTVirtAddr, istPhysAddr, PageBytes, false);
         /* PF handler */
         pTable->map(PFHandlerVirtAddr, pfHandlerPhysAddr, PageBytes, false);
+        /* UD handler */
+        pTable->map(UDHandlerVirtAddr, udHandlerPhysAddr, PageBytes, false);
         /* MMIO region for m5ops */
         auto m5op_range = system->m5opRange();
         if (m5op_range.size()) {
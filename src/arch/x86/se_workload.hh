@@ -44,6 +44,7 @@ const Addr TSSVirtAddr = 0xffff800000003000;
 const Addr TSSPhysAddr = 0x63000;
 const Addr ISTVirtAddr = 0xffff800000004000;
 const Addr PFHandlerVirtAddr = 0xffff800000005000;
+const Addr UDHandlerVirtAddr = 0xffff800000006000;
 const Addr MMIORegionVirtAddr = 0xffffc90000000000;
 
 } // namespace X86ISA
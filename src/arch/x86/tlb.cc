@@ -420,11 +420,13 @@ Fault TLB::translate(const RequestPtr &req,
                         return std::make_shared<PageFault>(vaddr, true, mode,
                                                            true, false);
                     } else {
-                        Addr alignedVaddr = p->pTable->pageAlign(vaddr);
+                        // Large pages of the page table get large entries
+                        Addr alignedVaddr = vaddr & ~mask(pte->logBytes);
                         DPRINTF(TLB, "Mapping %#x to %#x\n", alignedVaddr,
                                 pte->paddr);
-                        entry = insert(alignedVaddr, TlbEntry(p->pTable->pid(), alignedVaddr, pte->paddr, pte->flags & EmulationPageTable::Uncacheable, pte->flags & EmulationPageTable::ReadOnly),
-                                       pcid);
+                        TlbEntry new_entry(p->pTable->pid(), alignedVaddr, pte->paddr, pte->flags & EmulationPageTable::Uncacheable, pte->flags & EmulationPageTable::ReadOnly);
+                        new_entry.logBytes = pte->logBytes;
+                        entry = insert(alignedVaddr, new_entry, pcid);
                     }
                     DPRINTF(TLB, "Miss was serviced.\n");
                 }
@@ -511,7 +513,7 @@ Fault TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
         if (!pte)
             return std::make_shared<PageFault>(vaddr, true, mode, true, false);
 
-        paddr = pte->paddr | process->pTable->pageOffset(vaddr);
+        paddr = pte->translate(vaddr);
     }
     DPRINTF(TLB, "Translated (functional) %#x -> %#x.\n", vaddr, paddr);
     req->setPaddr(paddr);
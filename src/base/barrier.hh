@@ -38,24 +38,34 @@
 #ifndef __BASE_BARRIER_HH__
 #define __BASE_BARRIER_HH__
 
+#include <atomic>
 #include <condition_variable>
+#include <mutex>
 
 namespace gem5
 {
 
+/**
+ * A reusable barrier. Threads arriving at the barrier spin for a while
+ * before they block, as the barriers between simulation quanta are
+ * usually short and waking a blocked thread costs more than the wait.
+ */
 class Barrier
 {
   private:
-    /// Mutex to protect access to numLeft and generation
+    /// Number of times a waiting thread polls before it blocks
+    static constexpr unsigned spinCount = 1 << 12;
+
+    /// Mutex to protect blocking on and waking up the barrier
     std::mutex bMutex;
     /// Condition variable for waiting on barrier
     std::condition_variable bCond;
     /// Number of threads we should be waiting for before completing the barrier
     unsigned numWaiting;
     /// Generation of this barrier
-    unsigned generation;
+    std::atomic<unsigned> generation;
     /// Number of threads remaining for the current generation
-    unsigned numLeft;
+    std::atomic<unsigned> numLeft;
 
   public:
     Barrier(unsigned _numWaiting)
@@ -65,17 +75,27 @@ class Barrier
     bool
     wait()
     {
-        std::unique_lock<std::mutex> lock(bMutex);
-        unsigned int gen = generation;
+        unsigned gen = generation.load(std::memory_order_acquire);
 
-        if (--numLeft == 0) {
-            generation++;
-            numLeft = numWaiting;
+        if (numLeft.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            numLeft.store(numWaiting, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(bMutex);
+                generation.store(gen + 1, std::memory_order_release);
+            }
             bCond.notify_all();
             return true;
         }
-        while (gen == generation)
-            bCond.wait(lock);
+
+        for (unsigned i = 0; i < spinCount; ++i) {
+            if (generation.load(std::memory_order_acquire) != gen)
+                return false;
+        }
+
+        std::unique_lock<std::mutex> lock(bMutex);
+        bCond.wait(lock, [&] {
+            return generation.load(std::memory_order_acquire) != gen;
+        });
         return false;
     }
 };
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SMALL_VECTOR_HH__
+#define __BASE_SMALL_VECTOR_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace gem5
+{
+
+/**
+ * A vector with inline storage for a small number of elements.
+ *
+ * The first N elements are stored in the object itself, so short vectors
+ * never touch the heap. Once the vector grows past N elements the
+ * elements move to a heap buffer, which is kept when the vector is
+ * cleared so that a reused vector stops allocating once it has reached
+ * its working size.
+ *
+ * Elements are only ever copy or move constructed and destroyed, never
+ * assigned, so types with const members can be stored. Iterators are
+ * plain pointers and are invalidated by any operation that adds or
+ * removes elements.
+ *
+ * @tparam T Type of the elements.
+ * @tparam N Number of elements stored inline.
+ *
+ * @ingroup api_base_utils
+ */
+template <typename T, std::size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector needs inline storage");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+  private:
+    /** Inline storage for the first N elements. */
+    alignas(T) unsigned char inlineStorage[N * sizeof(T)];
+
+    /** The current storage, either inlineStorage or a heap buffer. */
+    T *_data;
+
+    /** Number of elements in the vector. */
+    size_type _size = 0;
+
+    /** Number of elements the current storage can hold. */
+    size_type _capacity = N;
+
+    T *inlineData() { return reinterpret_cast<T *>(inlineStorage); }
+    bool isInline() const
+    {
+        return _data == reinterpret_cast<const T *>(inlineStorage);
+    }
+
+    /** Destroy the elements in [first, last). */
+    static void
+    destroy(T *first, T *last)
+    {
+        for (; first != last; ++first)
+            first->~T();
+    }
+
+    /** Free the heap buffer, if any, and go back to inline storage. */
+    void
+    releaseStorage()
+    {
+        if (!isInline())
+            std::allocator<T>().deallocate(_data, _capacity);
+        _data = inlineData();
+        _capacity = N;
+    }
+
+    /** Move the elements of another vector into this empty one. */
+    void
+    stealFrom(SmallVector &other)
+    {
+        assert(_size == 0);
+        if (other.isInline()) {
+            for (size_type i = 0; i < other._size; ++i) {
+                new (&_data[i]) T(std::move(other._data[i]));
+                other._data[i].~T();
+            }
+        } else {
+            releaseStorage();
+            _data = other._data;
+            _capacity = other._capacity;
+            other._data = other.inlineData();
+            other._capacity = N;
+        }
+        _size = other._size;
+        other._size = 0;
+    }
+
+    /** Move the elements to a new heap buffer. */
+    void
+    moveTo(T *new_data, size_type new_capacity)
+    {
+        for (size_type i = 0; i < _size; ++i) {
+            new (&new_data[i]) T(std::move(_data[i]));
+            _data[i].~T();
+        }
+        releaseStorage();
+        _data = new_data;
+        _capacity = new_capacity;
+    }
+
+  public:
+    SmallVector() : _data(inlineData()) {}
+
+    SmallVector(const SmallVector &other) : _data(inlineData())
+    {
+        reserve(other._size);
+        for (const auto &v : other)
+            push_back(v);
+    }
+
+    SmallVector(SmallVector &&other) : _data(inlineData())
+    {
+        stealFrom(other);
+    }
+
+    SmallVector &
+    operator=(const SmallVector &other)
+    {
+        if (this != &other) {
+            clear();
+            reserve(other._size);
+            for (const auto &v : other)
+                push_back(v);
+        }
+        return *this;
+    }
+
+    SmallVector &
+    operator=(SmallVector &&other)
+    {
+        if (this != &other) {
+            clear();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        releaseStorage();
+    }
+
+    iterator begin() { return _data; }
+    iterator end() { return _data + _size; }
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+    const_iterator cbegin() const { return _data; }
+    const_iterator cend() const { return _data + _size; }
+
+    size_type size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    size_type capacity() const { return _capacity; }
+
+    reference operator[](size_type idx) { return _data[idx]; }
+    const_reference operator[](size_type idx) const { return _data[idx]; }
+
+    reference front() { assert(_size); return _data[0]; }
+    const_reference front() const { assert(_size); return _data[0]; }
+    reference back() { assert(_size); return _data[_size - 1]; }
+    const_reference back() const { assert(_size); return _data[_size - 1]; }
+
+    /**
+     * Make sure the vector can hold at least the given number of
+     * elements without allocating.
+     */
+    void
+    reserve(size_type new_capacity)
+    {
+        if (new_capacity > _capacity)
+            moveTo(std::allocator<T>().allocate(new_capacity), new_capacity);
+    }
+
+    template <typename... Args>
+    reference
+    emplace_back(Args &&...args)
+    {
+        T *elem;
+        if (_size < _capacity) {
+            elem = new (&_data[_size]) T(std::forward<Args>(args)...);
+        } else {
+            // Build the new element before moving the old ones, as the
+            // arguments may refer to an element of this vector
+            const size_type new_capacity = 2 * _capacity;
+            T *new_data = std::allocator<T>().allocate(new_capacity);
+            elem = new (&new_data[_size]) T(std::forward<Args>(args)...);
+            moveTo(new_data, new_capacity);
+        }
+        ++_size;
+        return *elem;
+    }
+
+    void push_back(const T &v) { emplace_back(v); }
+    void push_back(T &&v) { emplace_back(std::move(v)); }
+
+    void
+    pop_back()
+    {
+        assert(_size);
+        _data[--_size].~T();
+    }
+
+    void pop_front() { erase(begin()); }
+
+    /**
+     * Remove the elements in [first, last), shifting the following
+     * elements down.
+     *
+     * @return An iterator to the element that followed the last removed
+     * one.
+     */
+    iterator
+    erase(const_iterator first, const_iterator last)
+    {
+        T *dst = _data + (first - _data);
+        T *src = _data + (last - _data);
+        if (dst == src)
+            return dst;
+
+        T *const old_end = end();
+        for (T *pos = dst; src != old_end; ++pos, ++src) {
+            pos->~T();
+            new (pos) T(std::move(*src));
+        }
+        const size_type removed = last - first;
+        destroy(old_end - removed, old_end);
+        _size -= removed;
+        return const_cast<T *>(first);
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /**
+     * Remove the elements in [first, end()) for which pred returns true,
+     * keeping the order of the others. pred is called once per element,
+     * in order, so it may take the removed elements elsewhere.
+     *
+     * @return The new end().
+     */
+    template <typename Pred>
+    iterator
+    erase_if(const_iterator first, Pred pred)
+    {
+        T *dst = _data + (first - _data);
+        T *const old_end = end();
+        for (T *src = dst; src != old_end; ++src) {
+            if (pred(*src))
+                continue;
+            if (dst != src) {
+                dst->~T();
+                new (dst) T(std::move(*src));
+            }
+            ++dst;
+        }
+        destroy(dst, old_end);
+        _size = dst - _data;
+        return dst;
+    }
+
+    /** Remove all elements. The storage is kept. */
+    void
+    clear()
+    {
+        destroy(begin(), end());
+        _size = 0;
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_SMALL_VECTOR_HH__
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/small_vector.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An element that can be constructed but not assigned. */
+struct ConstElem
+{
+    const int value;
+    std::shared_ptr<int> counter;
+
+    ConstElem(int v, std::shared_ptr<int> c) : value(v), counter(c) {}
+};
+
+} // anonymous namespace
+
+/** A new vector is empty and uses its inline storage. */
+TEST(SmallVectorTest, Empty)
+{
+    SmallVector<int, 4> v;
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(v.size(), 0);
+    ASSERT_EQ(v.capacity(), 4);
+}
+
+/** Elements keep their order when the vector grows past its inline size. */
+TEST(SmallVectorTest, PushBackAndGrow)
+{
+    SmallVector<int, 2> v;
+    for (int i = 0; i < 10; i++)
+        v.push_back(i);
+
+    ASSERT_EQ(v.size(), 10);
+    ASSERT_GE(v.capacity(), 10);
+    for (int i = 0; i < 10; i++)
+        ASSERT_EQ(v[i], i);
+    ASSERT_EQ(v.front(), 0);
+    ASSERT_EQ(v.back(), 9);
+}
+
+/** Pushing an element of the vector itself survives a reallocation. */
+TEST(SmallVectorTest, PushBackSelf)
+{
+    SmallVector<std::string, 1> v;
+    v.push_back("first");
+    v.push_back(v.front());
+    ASSERT_EQ(v.size(), 2);
+    ASSERT_EQ(v[1], "first");
+}
+
+/** Erasing returns the following element and keeps the order. */
+TEST(SmallVectorTest, Erase)
+{
+    SmallVector<int, 4> v;
+    for (int i = 0; i < 6; i++)
+        v.push_back(i);
+
+    auto it = v.erase(v.begin() + 1);
+    ASSERT_EQ(*it, 2);
+    it = v.erase(v.begin() + 2, v.begin() + 4);
+    ASSERT_EQ(*it, 5);
+    v.pop_front();
+
+    ASSERT_EQ(v.size(), 2);
+    ASSERT_EQ(v[0], 2);
+    ASSERT_EQ(v[1], 5);
+
+    it = v.erase(v.begin() + 1);
+    ASSERT_EQ(it, v.end());
+    v.pop_back();
+    ASSERT_TRUE(v.empty());
+}
+
+/** Clearing a vector keeps its heap storage. */
+TEST(SmallVectorTest, ClearKeepsCapacity)
+{
+    SmallVector<int, 1> v;
+    for (int i = 0; i < 8; i++)
+        v.push_back(i);
+    const auto capacity = v.capacity();
+    v.clear();
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(v.capacity(), capacity);
+}
+
+/** Copies are independent and moves leave the source empty. */
+TEST(SmallVectorTest, CopyAndMove)
+{
+    for (int n : {2, 8}) {
+        SmallVector<std::string, 4> v;
+        for (int i = 0; i < n; i++)
+            v.push_back(std::to_string(i));
+
+        SmallVector<std::string, 4> copy(v);
+        copy.push_back("extra");
+        ASSERT_EQ(v.size(), n);
+        ASSERT_EQ(copy.size(), n + 1);
+
+        SmallVector<std::string, 4> moved(std::move(v));
+        ASSERT_TRUE(v.empty());
+        ASSERT_EQ(moved.size(), n);
+        ASSERT_EQ(moved.back(), std::to_string(n - 1));
+
+        v = moved;
+        ASSERT_EQ(v.size(), n);
+        copy = std::move(moved);
+        ASSERT_TRUE(moved.empty());
+        ASSERT_EQ(copy.size(), n);
+        ASSERT_EQ(copy[0], "0");
+    }
+}
+
+/** Types without assignment work, and every element is destroyed. */
+TEST(SmallVectorTest, ConstMembers)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        SmallVector<ConstElem, 2> v;
+        for (int i = 0; i < 5; i++)
+            v.emplace_back(i, counter);
+        v.erase(v.begin());
+        v.pop_front();
+
+        ASSERT_EQ(v.size(), 3);
+        ASSERT_EQ(v.front().value, 2);
+        ASSERT_EQ(counter.use_count(), 4);
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+}
+
+/** erase_if keeps the order of the remaining elements. */
+TEST(SmallVectorTest, EraseIf)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        SmallVector<ConstElem, 2> v;
+        for (int i = 0; i < 7; i++)
+            v.emplace_back(i, counter);
+
+        std::vector<int> removed;
+        auto end = v.erase_if(v.begin() + 1, [&removed](const ConstElem &e) {
+            if (e.value % 2 == 0)
+                return false;
+            removed.push_back(e.value);
+            return true;
+        });
+
+        ASSERT_EQ(end, v.end());
+        ASSERT_EQ(removed, std::vector<int>({1, 3, 5}));
+        ASSERT_EQ(v.size(), 4);
+        for (int i = 0; i < 4; i++)
+            ASSERT_EQ(v[i].value, 2 * i);
+        ASSERT_EQ(counter.use_count(), 5);
+    }
+    ASSERT_EQ(counter.use_count(), 1);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SPSC_QUEUE_HH__
+#define __BASE_SPSC_QUEUE_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+/*
+ * An unbounded, lock-free FIFO queue for exactly one producer and one
+ * consumer thread, for example for passing events between the threads of
+ * a parallel simulation.
+ *
+ * Values are stored in fixed size segments that are linked as the queue
+ * grows. A producer only ever writes its own end of the queue and the
+ * count of pushed values, and the consumer its end and the count of
+ * popped values, so neither ever waits for the other. A segment the
+ * consumer is done with is kept as a spare for the producer, so a queue
+ * that does not grow does not allocate memory.
+ *
+ * The role of producer may move between threads, as long as the threads
+ * synchronize between them, e.g. by a mutex or a barrier. The same holds
+ * for the consumer.
+ */
+template <typename T, size_t SegmentSize = 256>
+class SpscQueue
+{
+  private:
+    struct Segment
+    {
+        T values[SegmentSize];
+        std::atomic<Segment *> next{nullptr};
+    };
+
+    // keep the ends of the queue apart to avoid false sharing
+    static constexpr size_t LineSize = 64;
+
+    /** Producer end. */
+    alignas(LineSize) Segment *tail;
+    size_t tailIndex = 0;
+    std::atomic<uint64_t> _pushed{0};
+
+    /** Consumer end. */
+    alignas(LineSize) Segment *head;
+    size_t headIndex = 0;
+    uint64_t _popped = 0;
+
+    /** A segment that is free for the producer to reuse. */
+    alignas(LineSize) std::atomic<Segment *> spare{nullptr};
+
+  public:
+    SpscQueue() : tail(new Segment), head(tail) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    ~SpscQueue()
+    {
+        while (head) {
+            Segment *next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
+        }
+        delete spare.load(std::memory_order_relaxed);
+    }
+
+    /** Add a value at the end of the queue. Producer only. */
+    void
+    push(const T &value)
+    {
+        if (tailIndex == SegmentSize) {
+            Segment *segment = spare.exchange(nullptr,
+                                              std::memory_order_acquire);
+            if (segment)
+                segment->next.store(nullptr, std::memory_order_relaxed);
+            else
+                segment = new Segment;
+            tail->next.store(segment, std::memory_order_relaxed);
+            tail = segment;
+            tailIndex = 0;
+        }
+        tail->values[tailIndex++] = value;
+
+        // publish the value, and the segment it is in
+        _pushed.store(_pushed.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_release);
+    }
+
+    /**
+     * Take the value at the front of the queue. Consumer only.
+     *
+     * @return false if the queue is empty.
+     */
+    bool
+    pop(T &value)
+    {
+        if (_popped == _pushed.load(std::memory_order_acquire))
+            return false;
+
+        if (headIndex == SegmentSize) {
+            Segment *done = head;
+            head = head->next.load(std::memory_order_relaxed);
+            headIndex = 0;
+            delete spare.exchange(done, std::memory_order_release);
+        }
+        value = head->values[headIndex++];
+        _popped++;
+        return true;
+    }
+
+    /** Number of values pushed so far. Any thread. */
+    uint64_t pushed() const { return _pushed.load(std::memory_order_acquire); }
+
+    /** Number of values popped so far. Consumer only. */
+    uint64_t popped() const { return _popped; }
+
+    /** Whether there is nothing to pop. Consumer only. */
+    bool empty() const { return _popped == pushed(); }
+};
+
+} // namespace gem5
+
+#endif // __BASE_SPSC_QUEUE_HH__
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+
+#include "base/spsc_queue.hh"
+
+using namespace gem5;
+
+TEST(SpscQueue, Empty)
+{
+    SpscQueue<int> q;
+    int value;
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.pop(value));
+    EXPECT_EQ(q.pushed(), 0);
+}
+
+TEST(SpscQueue, FifoAcrossSegments)
+{
+    SpscQueue<int, 4> q;
+    for (int i = 0; i < 10; i++)
+        q.push(i);
+    EXPECT_EQ(q.pushed(), 10);
+
+    int value;
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(q.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.popped(), 10);
+
+    // segments are reused once drained
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 6; i++)
+            q.push(100 * round + i);
+        for (int i = 0; i < 6; i++) {
+            ASSERT_TRUE(q.pop(value));
+            EXPECT_EQ(value, 100 * round + i);
+        }
+    }
+    EXPECT_FALSE(q.pop(value));
+}
+
+TEST(SpscQueue, TwoThreads)
+{
+    constexpr uint64_t count = 1000000;
+    SpscQueue<uint64_t, 64> q;
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < count; i++)
+            q.push(i);
+    });
+
+    uint64_t expected = 0;
+    uint64_t value;
+    while (expected < count) {
+        if (q.pop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(q.empty());
+}
@@ -242,6 +242,12 @@ Formula::zero() const
     return true;
 }
 
+bool
+Formula::changed() const
+{
+    return !root || root->changed();
+}
+
 std::string
 Formula::str() const
 {
@@ -112,6 +112,8 @@ class InfoProxy : public Base
         visitor.visit(*static_cast<Base *>(this));
     }
     bool zero() const { return s.zero(); }
+    bool changed() const { return s.changed(); }
+    void clearChanged() { s.clearChanged(); }
 };
 
 template <class Stat>
@@ -183,8 +185,13 @@ class InfoAccess
 {
   private:
     Info *_info;
+    /** Has the stat been updated since the last clearChanged() call? */
+    bool _changed;
 
   protected:
+    /** Record that the stat has been updated */
+    void setChanged() { _changed = true; }
+
     /** Set up an info class for this statistic */
     void setInfo(Group *parent, Info *info);
     /** Save Storage class parameters if any */
@@ -202,7 +209,7 @@ class InfoAccess
 
   public:
     InfoAccess()
-        : _info(nullptr) {};
+        : _info(nullptr), _changed(true) {};
 
     /**
      * Reset the stat to the default state.
@@ -215,6 +222,17 @@ class InfoAccess
      */
     bool zero() const { return true; }
 
+    /**
+     * @return true if the stat has been updated or reset since the
+     * last call to clearChanged()
+     */
+    bool changed() const { return _changed; }
+
+    /**
+     * Mark the current value of the stat as seen, e.g., after a dump.
+     */
+    void clearChanged() { _changed = false; }
+
     /**
      * Check that this stat has been set up properly and is ready for
      * use
@@ -454,6 +472,7 @@ class DataWrapVec : public DataWrap<Derived, InfoProxyType>
         size_t size = self.size();
         for (off_type i = 0; i < size; ++i)
             self.data(i)->reset(info->getStorageParams());
+        this->setChanged();
     }
 };
 
@@ -572,12 +591,12 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * Increment the stat by 1. This calls the associated storage object inc
      * function.
      */
-    void operator++() { data()->inc(1); }
+    void operator++() { data()->inc(1); this->setChanged(); }
     /**
      * Decrement the stat by 1. This calls the associated storage object dec
      * function.
      */
-    void operator--() { data()->dec(1); }
+    void operator--() { data()->dec(1); this->setChanged(); }
 
     /** Increment the stat by 1. */
     void operator++(int) { ++*this; }
@@ -590,7 +609,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * @param v The new value.
      */
     template <typename U>
-    void operator=(const U &v) { data()->set(v); }
+    void operator=(const U &v) { data()->set(v); this->setChanged(); }
 
     /**
      * Increment the stat by the given value. This calls the associated
@@ -598,7 +617,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * @param v The value to add.
      */
     template <typename U>
-    void operator+=(const U &v) { data()->inc(v); }
+    void operator+=(const U &v) { data()->inc(v); this->setChanged(); }
 
     /**
      * Decrement the stat by the given value. This calls the associated
@@ -606,7 +625,7 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
      * @param v The value to substract.
      */
     template <typename U>
-    void operator-=(const U &v) { data()->dec(v); }
+    void operator-=(const U &v) { data()->dec(v); this->setChanged(); }
 
     /**
      * Return the number of elements, always 1 for a scalar.
@@ -626,7 +645,19 @@ class ScalarBase : public DataWrap<Derived, ScalarInfoProxy>
 
     bool zero() const { return result() == 0.0; }
 
-    void reset() { data()->reset(this->info()->getStorageParams()); }
+    bool
+    changed() const
+    {
+        return Storage::tickDependent || InfoAccess::changed();
+    }
+
+    void
+    reset()
+    {
+        data()->reset(this->info()->getStorageParams());
+        this->setChanged();
+    }
+
     void prepare() { data()->prepare(this->info()->getStorageParams()); }
 };
 
@@ -776,6 +807,8 @@ class ValueBase : public DataWrap<Derived, ScalarInfoProxy>
 
     std::string str() const { return proxy->str(); }
     bool zero() const { return proxy->zero(); }
+    /** The value is computed on demand, so any dump may see a change. */
+    bool changed() const { return true; }
     bool check() const { return proxy != NULL; }
     void prepare() { }
     void reset() { }
@@ -814,6 +847,12 @@ class ScalarProxy
      */
     Result result() const { return stat.data(index)->result(); }
 
+    /**
+     * @return true if the parent stat may have changed since it was last
+     * dumped.
+     */
+    bool changed() const { return stat.changed(); }
+
   public:
     /**
      * Create and initialize this proxy, do not register it with the database.
@@ -851,12 +890,12 @@ class ScalarProxy
      * Increment the stat by 1. This calls the associated storage object inc
      * function.
      */
-    void operator++() { stat.data(index)->inc(1); }
+    void operator++() { stat.data(index)->inc(1); stat.setChanged(); }
     /**
      * Decrement the stat by 1. This calls the associated storage object dec
      * function.
      */
-    void operator--() { stat.data(index)->dec(1); }
+    void operator--() { stat.data(index)->dec(1); stat.setChanged(); }
 
     /** Increment the stat by 1. */
     void operator++(int) { ++*this; }
@@ -873,6 +912,7 @@ class ScalarProxy
     operator=(const U &v)
     {
         stat.data(index)->set(v);
+        stat.setChanged();
     }
 
     /**
@@ -885,6 +925,7 @@ class ScalarProxy
     operator+=(const U &v)
     {
         stat.data(index)->inc(v);
+        stat.setChanged();
     }
 
     /**
@@ -897,6 +938,7 @@ class ScalarProxy
     operator-=(const U &v)
     {
         stat.data(index)->dec(v);
+        stat.setChanged();
     }
 
     /**
@@ -1009,6 +1051,12 @@ class VectorBase : public DataWrapVec<Derived, VectorInfoProxy>
         return true;
     }
 
+    bool
+    changed() const
+    {
+        return Storage::tickDependent || InfoAccess::changed();
+    }
+
     bool
     check() const
     {
@@ -1213,6 +1261,12 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
         return data(0)->zero();
     }
 
+    bool
+    changed() const
+    {
+        return Storage::tickDependent || InfoAccess::changed();
+    }
+
     /**
      * Return a total of all entries in this vector.
      * @return The total of all vector entries.
@@ -1250,6 +1304,7 @@ class Vector2dBase : public DataWrapVec2d<Derived, Vector2dInfoProxy>
         size_type size = this->size();
         for (off_type i = 0; i < size; ++i)
             data(i)->reset(info->getStorageParams());
+        this->setChanged();
     }
 
     bool
@@ -1324,7 +1379,12 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      * @param n The number of times to add it, defaults to 1.
      */
     template <typename U>
-    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+    void
+    sample(const U &v, int n = 1)
+    {
+        data()->sample(v, n);
+        this->setChanged();
+    }
 
     /**
      * Return the number of entries in this stat.
@@ -1337,6 +1397,12 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      */
     bool zero() const { return data()->zero(); }
 
+    bool
+    changed() const
+    {
+        return Storage::tickDependent || InfoAccess::changed();
+    }
+
     void
     prepare()
     {
@@ -1351,12 +1417,18 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     reset()
     {
         data()->reset(this->info()->getStorageParams());
+        this->setChanged();
     }
 
     /**
      *  Add the argument distribution to the this distribution.
      */
-    void add(DistBase &d) { data()->add(d.data()); }
+    void
+    add(DistBase &d)
+    {
+        data()->add(d.data());
+        this->setChanged();
+    }
 };
 
 template <class Stat>
@@ -1438,6 +1510,12 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
         return true;
     }
 
+    bool
+    changed() const
+    {
+        return Storage::tickDependent || InfoAccess::changed();
+    }
+
     void
     prepare()
     {
@@ -1489,6 +1567,7 @@ class DistProxy
     sample(const U &v, int n = 1)
     {
         data()->sample(v, n);
+        stat.setChanged();
     }
 
     size_type
@@ -1543,6 +1622,13 @@ class Node
      */
     virtual std::string str() const = 0;
 
+    /**
+     * Check if any of the stats this subtree depends on may have
+     * changed since they were last dumped.
+     * @return true if the subtree needs to be re-evaluated.
+     */
+    virtual bool changed() const = 0;
+
     virtual ~Node() {};
 };
 
@@ -1569,6 +1655,8 @@ class ScalarStatNode : public Node
 
     size_type size() const { return 1; }
 
+    bool changed() const { return data->changed(); }
+
     /**
      *
      */
@@ -1606,6 +1694,8 @@ class ScalarProxyNode : public Node
         return 1;
     }
 
+    bool changed() const { return proxy.changed(); }
+
     /**
      *
      */
@@ -1628,6 +1718,8 @@ class VectorStatNode : public Node
 
     size_type size() const { return data->size(); }
 
+    bool changed() const { return data->changed(); }
+
     std::string str() const { return data->name; }
 };
 
@@ -1642,6 +1734,7 @@ class ConstNode : public Node
     const VResult &result() const { return vresult; }
     Result total() const { return vresult[0]; };
     size_type size() const { return 1; }
+    bool changed() const { return false; }
     std::string str() const { return std::to_string(vresult[0]); }
 };
 
@@ -1666,6 +1759,7 @@ class ConstVectorNode : public Node
     }
 
     size_type size() const { return vresult.size(); }
+    bool changed() const { return false; }
     std::string
     str() const
     {
@@ -1755,6 +1849,8 @@ class UnaryNode : public Node
 
     size_type size() const { return l->size(); }
 
+    bool changed() const { return l->changed(); }
+
     std::string
     str() const
     {
@@ -1852,6 +1948,12 @@ class BinaryNode : public Node
         }
     }
 
+    bool
+    changed() const override
+    {
+        return l->changed() || r->changed();
+    }
+
     std::string
     str() const override
     {
@@ -1903,6 +2005,8 @@ class SumNode : public Node
 
     size_type size() const { return 1; }
 
+    bool changed() const { return l->changed(); }
+
     std::string
     str() const
     {
@@ -2461,7 +2565,12 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
      * @param n The number of times to add it, defaults to 1.
      */
     template <typename U>
-    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+    void
+    sample(const U &v, int n = 1)
+    {
+        data()->sample(v, n);
+        this->setChanged();
+    }
 
     /**
      * Return the number of entries in this stat.
@@ -2474,6 +2583,12 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
      */
     bool zero() const { return data()->zero(); }
 
+    bool
+    changed() const
+    {
+        return Storage::tickDependent || InfoAccess::changed();
+    }
+
     void
     prepare()
     {
@@ -2488,6 +2603,7 @@ class SparseHistBase : public DataWrap<Derived, SparseHistInfoProxy>
     reset()
     {
         data()->reset(this->info()->getStorageParams());
+        this->setChanged();
     }
 };
 
@@ -2624,6 +2740,11 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
      */
     bool zero() const;
 
+    /**
+     * A formula changes if any of the stats it is computed from changed.
+     */
+    bool changed() const;
+
     std::string str() const;
 };
 
@@ -2639,6 +2760,7 @@ class FormulaNode : public Node
     size_type size() const { return formula.size(); }
     const VResult &result() const { formula.result(vec); return vec; }
     Result total() const { return formula.total(); }
+    bool changed() const { return formula.changed(); }
 
     std::string str() const { return formula.str(); }
 };
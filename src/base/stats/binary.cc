@@ -0,0 +1,490 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+constexpr auto Nan = std::numeric_limits<double>::quiet_NaN();
+
+} // anonymous namespace
+
+namespace statistics
+{
+
+Binary::Binary(std::ostream *_stream, bool desc, bool formulas)
+    : stream(_stream), enableDescriptions(desc), enableFormula(formulas),
+      schemaId(0), headerWritten(false)
+{
+}
+
+bool
+Binary::valid() const
+{
+    return stream != nullptr && stream->good();
+}
+
+void
+Binary::begin()
+{
+    assert(path.empty());
+
+    paths.clear();
+    paths.emplace_back();
+    path.push(0);
+
+    entries.clear();
+    values.clear();
+
+    if (!headerWritten) {
+        const uint32_t header[2] = { version, 0 };
+        stream->write(magic, sizeof(magic));
+        stream->write((const char *)header, sizeof(header));
+        headerWritten = true;
+    }
+}
+
+void
+Binary::end()
+{
+    assert(valid());
+    assert(path.size() == 1);
+    path.pop();
+
+    // Only regenerate the (expensive) column metadata if the set of
+    // dumped stats changed since the last schema was written.
+    if (entries != schema) {
+        std::vector<Column> columns;
+        columns.reserve(values.size());
+
+        values.clear();
+        for (const auto &entry : entries)
+            emit(entry, &columns);
+        assert(columns.size() == values.size());
+
+        ++schemaId;
+        writeSchema(columns);
+        schema = entries;
+
+        schemaIndex.clear();
+        schemaOffset.clear();
+        size_t offset = 0;
+        for (size_t i = 0; i < schema.size(); ++i) {
+            schemaIndex[schema[i].info] = i;
+            schemaOffset.push_back(offset);
+            offset += schema[i].count;
+        }
+    }
+
+    writeRow();
+    stream->flush();
+    lastRow.swap(values);
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    const std::string &parent = paths[path.top()];
+    if (parent.empty())
+        paths.emplace_back(name);
+    else
+        paths.emplace_back(parent + "." + name);
+    path.push(paths.size() - 1);
+}
+
+void
+Binary::endGroup()
+{
+    assert(path.size() > 1);
+    path.pop();
+}
+
+std::string
+Binary::statName(size_t idx, const std::string &name) const
+{
+    const std::string &prefix = paths[idx];
+    return prefix.empty() ? name : prefix + "." + name;
+}
+
+void
+Binary::record(const Info &info, Kind kind, size_t first)
+{
+    entries.push_back({ &info, kind, path.top(), values.size() - first });
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const size_t first = values.size();
+    emitScalar(info.name, info, nullptr);
+    record(info, Kind::Scalar, first);
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const size_t first = values.size();
+    emitVector(info.name, info, nullptr);
+    record(info, Kind::Vector, first);
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const size_t first = values.size();
+    emitDist(info.name, info, info.data, info.desc, nullptr);
+    record(info, Kind::Dist, first);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const size_t first = values.size();
+    for (off_type i = 0; i < info.size(); ++i)
+        emitDist(info.name, info, info.data[i], info.desc, nullptr);
+    record(info, Kind::VectorDist, first);
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const size_t first = values.size();
+    emitVector2d(info.name, info, nullptr);
+    record(info, Kind::Vector2d, first);
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    if (!enableFormula)
+        return;
+
+    visit((const VectorInfo &)info);
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    warn_once("Binary stat files don't support sparse histograms.\n");
+}
+
+void
+Binary::unchanged(Info &info)
+{
+    auto it = schemaIndex.find(&info);
+    if (it == schemaIndex.end()) {
+        // We haven't written this stat yet, so there is nothing to
+        // copy from.
+        info.visit(*this);
+        return;
+    }
+
+    const Entry &prev = schema[it->second];
+    const auto begin = lastRow.begin() + schemaOffset[it->second];
+    values.insert(values.end(), begin, begin + prev.count);
+    entries.push_back({ &info, prev.kind, path.top(), prev.count });
+}
+
+void
+Binary::emit(const Entry &entry, std::vector<Column> *columns)
+{
+    const std::string name = statName(entry.path, entry.info->name);
+
+    switch (entry.kind) {
+      case Kind::Scalar:
+        emitScalar(name, *(const ScalarInfo *)entry.info, columns);
+        break;
+      case Kind::Vector:
+        emitVector(name, *(const VectorInfo *)entry.info, columns);
+        break;
+      case Kind::Dist: {
+          auto &info = *(const DistInfo *)entry.info;
+          emitDist(name, info, info.data, info.desc, columns);
+        }
+        break;
+      case Kind::VectorDist: {
+          auto &info = *(const VectorDistInfo *)entry.info;
+          for (off_type i = 0; i < info.size(); ++i) {
+              const std::string sub = info.subnames[i].empty() ?
+                  std::to_string(i) : info.subnames[i];
+              emitDist(name + "_" + sub, info, info.data[i],
+                  info.subdescs[i].empty() ? info.desc : info.subdescs[i],
+                  columns);
+          }
+        }
+        break;
+      case Kind::Vector2d:
+        emitVector2d(name, *(const Vector2dInfo *)entry.info, columns);
+        break;
+    }
+}
+
+void
+Binary::emitScalar(const std::string &name, const ScalarInfo &info,
+                   std::vector<Column> *columns)
+{
+    values.push_back(info.result());
+
+    if (columns)
+        columns->push_back({ name, info.unit->getUnitString(), info.desc });
+}
+
+void
+Binary::emitVector(const std::string &name, const VectorInfo &info,
+                   std::vector<Column> *columns)
+{
+    const VResult &vec = info.result();
+    const size_type size = vec.size();
+    // Matches the text output, which prints single-element vectors
+    // as plain scalars without a total.
+    const bool with_total = size > 1 && info.flags.isSet(total);
+
+    values.insert(values.end(), vec.begin(), vec.end());
+    if (with_total)
+        values.push_back(info.total());
+
+    if (!columns)
+        return;
+
+    const std::string unit = info.unit->getUnitString();
+    if (size == 1) {
+        columns->push_back({ name, unit, info.desc });
+        return;
+    }
+
+    const std::string base = name + info.separatorString;
+    for (off_type i = 0; i < size; ++i) {
+        const bool named = i < info.subnames.size() &&
+            !info.subnames[i].empty();
+        const bool described = i < info.subdescs.size() &&
+            !info.subdescs[i].empty();
+        columns->push_back({
+            base + (named ? info.subnames[i] : std::to_string(i)),
+            unit, described ? info.subdescs[i] : info.desc });
+    }
+
+    if (with_total)
+        columns->push_back({ base + "total", unit, info.desc });
+}
+
+void
+Binary::emitVector2d(const std::string &name, const Vector2dInfo &info,
+                     std::vector<Column> *columns)
+{
+    const bool row_total = info.y > 1 && info.flags.isSet(total);
+    const bool grand_total = info.x > 1 && info.flags.isSet(total);
+
+    for (off_type i = 0; i < info.x; ++i) {
+        const auto begin = info.cvec.begin() + i * info.y;
+        values.insert(values.end(), begin, begin + info.y);
+        if (row_total) {
+            Result sum = 0.0;
+            for (off_type j = 0; j < info.y; ++j)
+                sum += begin[j];
+            values.push_back(sum);
+        }
+    }
+    if (grand_total)
+        values.push_back(info.total());
+
+    if (!columns)
+        return;
+
+    const std::string unit = info.unit->getUnitString();
+    const std::string &sep = info.separatorString;
+    for (off_type i = 0; i < info.x; ++i) {
+        const bool named = i < info.subnames.size() &&
+            !info.subnames[i].empty();
+        const std::string base = name + "_" +
+            (named ? info.subnames[i] : std::to_string(i)) + sep;
+        for (off_type j = 0; j < info.y; ++j) {
+            const bool y_named = j < info.y_subnames.size() &&
+                !info.y_subnames[j].empty();
+            columns->push_back({
+                base + (y_named ? info.y_subnames[j] : std::to_string(j)),
+                unit, info.desc });
+        }
+        if (row_total)
+            columns->push_back({ base + "total", unit, info.desc });
+    }
+    if (grand_total)
+        columns->push_back({ name + sep + "total", unit, info.desc });
+}
+
+void
+Binary::emitDist(const std::string &name, const Info &info,
+                 const DistData &data, const std::string &desc,
+                 std::vector<Column> *columns)
+{
+    const bool is_dist = data.type == Dist;
+    const size_t size = data.cvec.size();
+
+    values.push_back(data.samples);
+    values.push_back(data.samples ? data.sum / data.samples : Nan);
+    if (data.type == Hist)
+        values.push_back(data.samples ? exp(data.logs / data.samples) : Nan);
+    values.push_back(data.samples ?
+        sqrt((data.samples * data.squares - data.sum * data.sum) /
+             (data.samples * (data.samples - 1.0))) : Nan);
+
+    if (data.type != Deviation) {
+        Result sum = 0.0;
+        if (is_dist) {
+            values.push_back(data.underflow);
+            sum += data.underflow;
+        }
+        for (off_type i = 0; i < size; ++i) {
+            values.push_back(data.cvec[i]);
+            sum += data.cvec[i];
+        }
+        if (is_dist) {
+            values.push_back(data.overflow);
+            values.push_back(data.min_val);
+            values.push_back(data.max_val);
+            sum += data.overflow;
+        }
+        values.push_back(sum);
+    }
+
+    if (!columns)
+        return;
+
+    const std::string unit = info.unit->getUnitString();
+    const std::string base = name + info.separatorString;
+    auto add = [&](const std::string &suffix) {
+        columns->push_back({ base + suffix, unit, desc });
+    };
+
+    add("samples");
+    add("mean");
+    if (data.type == Hist)
+        add("gmean");
+    add("stdev");
+
+    if (data.type == Deviation)
+        return;
+
+    if (is_dist)
+        add("underflows");
+    for (off_type i = 0; i < size; ++i) {
+        std::stringstream bucket;
+        Counter low = i * data.bucket_size + data.min;
+        Counter high = std::min(low + data.bucket_size - 1.0, data.max);
+        bucket << low;
+        if (low < high)
+            bucket << "-" << high;
+        add(bucket.str());
+    }
+    if (is_dist) {
+        add("overflows");
+        add("min_value");
+        add("max_value");
+    }
+    add("total");
+}
+
+void
+Binary::writeString(const std::string &str)
+{
+    const uint32_t len = str.size();
+    stream->write((const char *)&len, sizeof(len));
+    stream->write(str.data(), len);
+}
+
+void
+Binary::writeSchema(const std::vector<Column> &columns)
+{
+    static const std::string empty;
+    const uint32_t header[2] = { schemaTag, schemaId };
+    const uint64_t count = columns.size();
+
+    stream->write((const char *)header, sizeof(header));
+    stream->write((const char *)&count, sizeof(count));
+    for (const auto &column : columns) {
+        writeString(column.name);
+        writeString(column.unit);
+        writeString(enableDescriptions ? column.desc : empty);
+    }
+}
+
+void
+Binary::writeRow()
+{
+    const uint32_t header[2] = { rowTag, schemaId };
+    const uint64_t tick = curTick();
+    const uint64_t count = values.size();
+
+    stream->write((const char *)header, sizeof(header));
+    stream->write((const char *)&tick, sizeof(tick));
+    stream->write((const char *)&count, sizeof(count));
+    stream->write((const char *)values.data(),
+                  values.size() * sizeof(double));
+}
+
+std::unique_ptr<Output>
+initBinary(const std::string &filename, bool desc, bool formulas)
+{
+    OutputStream *os = simout.findOrCreate(filename, true);
+    if (!os->stream()->good())
+        fatal("Unable to open binary statistics file '%s' for writing\n",
+              filename);
+
+    return std::unique_ptr<Output>(new Binary(os->stream(), desc, formulas));
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Compact, columnar binary stat file.
+ *
+ * Every scalar value produced by a stat dump (a scalar, an element of
+ * a vector, a bucket of a distribution, ...) is a column. The column
+ * names, units and descriptions are written once in a schema record,
+ * and every dump appends a row record that only holds the tick of the
+ * dump and the raw double values. A new schema record is only emitted
+ * if the set of dumped stats changes between two dumps, so rows always
+ * refer to the most recent schema.
+ *
+ * Column names follow the naming of the text output (e.g.,
+ * system.l3.demandHits_0::switch_cpus0.data or
+ * system.switch_cpus0.lsq0.loadToUse_0::mean) so that existing
+ * analysis scripts can look stats up using the same keys.
+ *
+ * File layout (native byte order, see util/binary_stats.py):
+ *
+ *   header: char magic[8] = "GEM5STAT", uint32 version, uint32 0
+ *   schema: uint32 'SCHM', uint32 schema id, uint64 #columns,
+ *           #columns x { str name, str unit, str desc }
+ *   row:    uint32 'ROW_', uint32 schema id, uint64 tick,
+ *           uint64 #columns, double values[#columns]
+ *
+ * where str is a uint32 length followed by the (non-terminated)
+ * characters.
+ */
+class Binary : public Output
+{
+  public:
+    static constexpr char magic[8] = {'G', 'E', 'M', '5', 'S', 'T', 'A', 'T'};
+    static constexpr uint32_t version = 1;
+    static constexpr uint32_t schemaTag = 0x4d484353; // "SCHM"
+    static constexpr uint32_t rowTag = 0x5f574f52; // "ROW_"
+
+    Binary(std::ostream *stream, bool desc, bool formulas);
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+    /** Repeat the values of unchanged stats from the previous row. */
+    void unchanged(Info &info) override;
+
+  protected:
+    /** Metadata of a single column. Only built when the schema changes. */
+    struct Column
+    {
+        std::string name;
+        std::string unit;
+        std::string desc;
+    };
+
+    enum class Kind : uint8_t
+    {
+        Scalar,
+        Vector,
+        Dist,
+        VectorDist,
+        Vector2d,
+    };
+
+    /** A stat that has been visited during the current dump. */
+    struct Entry
+    {
+        const Info *info;
+        Kind kind;
+        /** Index of the group path the stat was visited in. */
+        size_t path;
+        /** Number of columns the stat contributed to the row. */
+        size_t count;
+
+        bool
+        operator==(const Entry &other) const
+        {
+            return info == other.info && kind == other.kind &&
+                count == other.count;
+        }
+    };
+
+    /**
+     * Append the values of a stat to the current row. If columns is
+     * not null, the matching column metadata is appended as well.
+     *
+     * @param entry The stat to emit.
+     * @param columns Optional column metadata output.
+     */
+    void emit(const Entry &entry, std::vector<Column> *columns);
+
+    void emitScalar(const std::string &name, const ScalarInfo &info,
+                    std::vector<Column> *columns);
+    void emitVector(const std::string &name, const VectorInfo &info,
+                    std::vector<Column> *columns);
+    void emitVector2d(const std::string &name, const Vector2dInfo &info,
+                      std::vector<Column> *columns);
+    void emitDist(const std::string &name, const Info &info,
+                  const DistData &data, const std::string &desc,
+                  std::vector<Column> *columns);
+
+    /** Record a visited stat and the number of columns it produced. */
+    void record(const Info &info, Kind kind, size_t first);
+
+    /** Full name of a stat visited in the given group path. */
+    std::string statName(size_t path, const std::string &name) const;
+
+    void writeString(const std::string &str);
+    void writeSchema(const std::vector<Column> &columns);
+    void writeRow();
+
+  protected:
+    std::ostream *stream;
+    const bool enableDescriptions;
+    const bool enableFormula;
+
+    /** Group paths seen during the current dump. */
+    std::vector<std::string> paths;
+    /** Stack of indices into paths for the currently open groups. */
+    std::stack<size_t> path;
+
+    /** Stats visited during the current dump. */
+    std::vector<Entry> entries;
+    /** Stats making up the most recently written schema. */
+    std::vector<Entry> schema;
+    /** Index of each stat in the schema. */
+    std::unordered_map<const Info *, size_t> schemaIndex;
+    /** Offset of the first column of each schema entry. */
+    std::vector<size_t> schemaOffset;
+    /** Row being assembled by the current dump. */
+    std::vector<double> values;
+    /** Most recently written row. */
+    std::vector<double> lastRow;
+
+    uint32_t schemaId;
+    bool headerWritten;
+};
+
+std::unique_ptr<Output> initBinary(const std::string &filename,
+                                   bool desc = true, bool formulas = true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
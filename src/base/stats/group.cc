@@ -41,6 +41,7 @@
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/stats/info.hh"
+#include "base/stats/output.hh"
 #include "base/trace.hh"
 #include "debug/Stats.hh"
 
@@ -105,6 +106,45 @@ Group::preDumpStats()
         g.second->preDumpStats();
 }
 
+void
+Group::prepareStats(bool delta)
+{
+    for (auto &s : stats) {
+        if (!delta || s->changed())
+            s->prepare();
+    }
+
+    for (auto &g : statGroups)
+        g.second->prepareStats(delta);
+}
+
+void
+Group::visitStats(Output &visitor, bool delta) const
+{
+    for (auto &s : stats) {
+        if (delta && !s->changed())
+            visitor.unchanged(*s);
+        else
+            s->visit(visitor);
+    }
+
+    for (auto &g : statGroups) {
+        visitor.beginGroup(g.first.c_str());
+        g.second->visitStats(visitor, delta);
+        visitor.endGroup();
+    }
+}
+
+void
+Group::clearChangedStats()
+{
+    for (auto &s : stats)
+        s->clearChanged();
+
+    for (auto &g : statGroups)
+        g.second->clearChangedStats();
+}
+
 void
 Group::addStat(statistics::Info *info)
 {
@@ -76,6 +76,7 @@ namespace gem5 {
 namespace statistics {
 
 class Info;
+struct Output;
 
 /**
  * Statistics container.
@@ -151,6 +152,41 @@ public:
      */
     virtual void preDumpStats();
 
+    /**
+     * Prepare the stats of this group and all of its sub-groups for
+     * dumping.
+     *
+     * @param delta Only prepare stats that changed since the last
+     * call to clearChangedStats().
+     *
+     * @ingroup api_stats
+     */
+    void prepareStats(bool delta = false);
+
+    /**
+     * Visit the stats of this group and all of its sub-groups.
+     *
+     * This is equivalent to walking the group hierarchy using
+     * getStats() and getStatGroups() and visiting every stat, but it
+     * doesn't involve the Python world. In a delta dump, stats that
+     * haven't changed since the last call to clearChangedStats() are
+     * passed to Output::unchanged() instead of being visited, which
+     * avoids evaluating them.
+     *
+     * @param visitor Output to visit the stats with.
+     * @param delta Only visit stats that changed.
+     *
+     * @ingroup api_stats
+     */
+    void visitStats(Output &visitor, bool delta = false) const;
+
+    /**
+     * Mark all stats of this group and its sub-groups as dumped.
+     *
+     * @ingroup api_stats
+     */
+    void clearChangedStats();
+
     /**
      * Register a stat with this group. This method is normally called
      * automatically when a stat is instantiated.
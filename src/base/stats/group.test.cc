@@ -657,3 +657,104 @@ TEST(StatsGroupTest, ResolveStatMergedSubGroup)
     ASSERT_NE(info_found, nullptr);
     ASSERT_EQ(info_found->name, "InfoResolveStatMergedSubGroup");
 }
+
+class ChangeTrackingInfo : public DummyInfo
+{
+  public:
+    bool dirty = true;
+    int visits = 0;
+
+    bool changed() const override { return dirty; }
+    void clearChanged() override { dirty = false; }
+    void visit(statistics::Output &visitor) override { visits++; }
+};
+
+class GroupPathOutput : public statistics::Output
+{
+  public:
+    std::vector<std::string> groups;
+    int unchangedStats = 0;
+
+    void begin() override {}
+    void end() override {}
+    bool valid() const override { return true; }
+
+    void beginGroup(const char *name) override { groups.push_back(name); }
+    void endGroup() override {}
+
+    void visit(const statistics::ScalarInfo &info) override {}
+    void visit(const statistics::VectorInfo &info) override {}
+    void visit(const statistics::DistInfo &info) override {}
+    void visit(const statistics::VectorDistInfo &info) override {}
+    void visit(const statistics::Vector2dInfo &info) override {}
+    void visit(const statistics::FormulaInfo &info) override {}
+    void visit(const statistics::SparseHistInfo &info) override {}
+
+    void unchanged(statistics::Info &info) override { unchangedStats++; }
+};
+
+/** Test that visiting a group visits the stats of all sub-groups. */
+TEST(StatsGroupTest, VisitStats)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(nullptr);
+    statistics::Group node1_1(nullptr);
+
+    ChangeTrackingInfo info;
+    info.setName("InfoVisitStats");
+    root.addStat(&info);
+
+    ChangeTrackingInfo info2;
+    info2.setName("InfoVisitStats2");
+    node1_1.addStat(&info2);
+
+    root.addStatGroup("Node1", &node1);
+    node1.addStatGroup("Node1_1", &node1_1);
+
+    GroupPathOutput output;
+    root.visitStats(output);
+    ASSERT_EQ(info.visits, 1);
+    ASSERT_EQ(info2.visits, 1);
+    ASSERT_EQ(output.unchangedStats, 0);
+    ASSERT_EQ(output.groups,
+        std::vector<std::string>({"Node1", "Node1_1"}));
+}
+
+/** Test that delta visits skip the stats that didn't change. */
+TEST(StatsGroupTest, VisitStatsDelta)
+{
+    statistics::Group root(nullptr);
+    statistics::Group node1(nullptr);
+
+    ChangeTrackingInfo info;
+    info.setName("InfoVisitStatsDelta");
+    root.addStat(&info);
+
+    ChangeTrackingInfo info2;
+    info2.setName("InfoVisitStatsDelta2");
+    node1.addStat(&info2);
+
+    root.addStatGroup("Node1", &node1);
+
+    GroupPathOutput output;
+    root.visitStats(output, true);
+    ASSERT_EQ(info.visits, 1);
+    ASSERT_EQ(info2.visits, 1);
+    ASSERT_EQ(output.unchangedStats, 0);
+
+    root.clearChangedStats();
+    ASSERT_FALSE(info.changed());
+    ASSERT_FALSE(info2.changed());
+
+    info2.dirty = true;
+    root.visitStats(output, true);
+    ASSERT_EQ(info.visits, 1);
+    ASSERT_EQ(info2.visits, 2);
+    ASSERT_EQ(output.unchangedStats, 1);
+
+    // A full visit ignores the change tracking
+    root.visitStats(output);
+    ASSERT_EQ(info.visits, 2);
+    ASSERT_EQ(info2.visits, 3);
+    ASSERT_EQ(output.unchangedStats, 1);
+}
@@ -156,6 +156,18 @@ class Info
      */
     virtual bool zero() const = 0;
 
+    /**
+     * @return true if the stat may have changed since the last call to
+     * clearChanged(). Stats that can't track their updates always
+     * report a change.
+     */
+    virtual bool changed() const { return true; }
+
+    /**
+     * Mark the current value of the stat as dumped.
+     */
+    virtual void clearChanged() {}
+
     /**
      * Visitor entry for outputing statistics data
      */
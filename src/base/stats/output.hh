@@ -45,6 +45,7 @@
 #include <string>
 
 #include "base/compiler.hh"
+#include "base/stats/info.hh"
 
 namespace gem5
 {
@@ -79,6 +80,14 @@ struct Output
     virtual void visit(const Vector2dInfo &info) = 0;
     virtual void visit(const FormulaInfo &info) = 0;
     virtual void visit(const SparseHistInfo &info) = 0; // Sparse histogram
+
+    /**
+     * Called instead of Info::visit() for stats that a delta dump
+     * skipped because they didn't change since the previous dump.
+     * Outputs that can't represent partial dumps fall back to a
+     * regular visit.
+     */
+    virtual void unchanged(Info &info) { info.visit(*this); }
 };
 
 } // namespace statistics
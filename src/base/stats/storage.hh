@@ -60,6 +60,9 @@ class StatStor
     Counter data;
 
   public:
+    /** The result only changes when the stat is updated. */
+    static constexpr bool tickDependent = false;
+
     struct Params : public StorageParams {};
 
     /**
@@ -136,6 +139,9 @@ class AvgStor
     mutable Tick last;
 
   public:
+    /** The result changes with time even if the stat is not updated. */
+    static constexpr bool tickDependent = true;
+
     struct Params : public StorageParams {};
 
     /**
@@ -257,6 +263,9 @@ class DistStor
     VCounter cvec;
 
   public:
+    /** The result only changes when the stat is updated. */
+    static constexpr bool tickDependent = false;
+
     /** The parameters for a distribution stat. */
     struct Params : public DistParams
     {
@@ -455,6 +464,9 @@ class HistStor
     void growDown();
 
   public:
+    /** The result only changes when the stat is updated. */
+    static constexpr bool tickDependent = false;
+
     /** The parameters for a distribution stat. */
     struct Params : public DistParams
     {
@@ -567,6 +579,9 @@ class SampleStor
     Counter samples;
 
   public:
+    /** The result only changes when the stat is updated. */
+    static constexpr bool tickDependent = false;
+
     struct Params : public DistParams
     {
         Params() : DistParams(Deviation) {}
@@ -643,6 +658,9 @@ class AvgSampleStor
     Counter squares;
 
   public:
+    /** The result changes with time even if the stat is not updated. */
+    static constexpr bool tickDependent = true;
+
     struct Params : public DistParams
     {
         Params() : DistParams(Deviation) {}
@@ -719,6 +737,9 @@ class SparseHistStor
     MCounter cmap;
 
   public:
+    /** The result only changes when the stat is updated. */
+    static constexpr bool tickDependent = false;
+
     /** The parameters for a sparse histogram stat. */
     struct Params : public DistParams
     {
@@ -92,6 +92,9 @@ class Text : public Output
     void visit(const FormulaInfo &info) override;
     void visit(const SparseHistInfo &info) override;
 
+    // Delta dumps only print the stats that changed
+    void unchanged(Info &info) override {}
+
     // Group handling
     void beginGroup(const char *name) override;
     void endGroup() override;
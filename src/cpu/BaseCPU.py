@@ -74,6 +74,8 @@ class BaseCPU(ClockedObject):
         PyBindMethod("getCurrentInstCount"),
         PyBindMethod("scheduleSimpointsInstStop"),
         PyBindMethod("scheduleInstStopAnyThread"),
+        PyBindMethod("scheduleSampleStop"),
+        PyBindMethod("descheduleSampleStop"),
     ]
 
     @classmethod
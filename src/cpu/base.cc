@@ -43,9 +43,11 @@
 
 #include "cpu/base.hh"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "arch/generic/decoder.hh"
 #include "arch/generic/isa.hh"
@@ -58,8 +60,10 @@
 #include "cpu/checker/cpu.hh"
 #include "cpu/thread_context.hh"
 #include "debug/Mwait.hh"
+#include "debug/PseudoInst.hh"
 #include "debug/SyscallVerbose.hh"
 #include "debug/Thread.hh"
+#include "mem/packet.hh"
 #include "mem/page_table.hh"
 #include "params/BaseCPU.hh"
 #include "sim/clocked_object.hh"
@@ -130,6 +134,7 @@ BaseCPU::BaseCPU(const Params &p, bool is_checker)
       _taskId(context_switch_task_id::Unknown), _pid(invldPid),
       _switchedOut(p.switched_out), _cacheLineSize(p.system->cacheLineSize()),
       modelResetPort(p.name + ".model_reset"),
+      memRegions(MAX_CMD_REGIONS, {0, 0}), maxMemRegionID(-1),
       interrupts(p.interrupts), numThreads(p.numThreads), system(p.system),
       previousCycle(0), previousState(CPU_STATE_SLEEP),
       functionTraceStream(nullptr), currentFunctionStart(0),
@@ -362,6 +367,8 @@ void BaseCPU::regProbePoints() {
 
     ppSleeping = new ProbePointArg<bool>(this->getProbeManager(),
                                          "Sleeping");
+    ppWorkItem = new ProbePointArg<bool>(this->getProbeManager(),
+                                         "WorkItem");
 }
 
 void BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc) {
@@ -546,6 +553,9 @@ void BaseCPU::switchOut() {
     // it gets switched in later.
     flushTLBs();
 
+    // The instruction counts of the next CPU start from its own counters
+    descheduleSampleStop();
+
     // Go to the power gating state
     powerState->set(enums::PwrState::OFF);
 }
@@ -563,6 +573,9 @@ void BaseCPU::takeOverFrom(BaseCPU *oldCPU) {
     previousState = oldCPU->previousState;
     previousCycle = oldCPU->previousCycle;
 
+    memRegions = oldCPU->memRegions;
+    maxMemRegionID = oldCPU->maxMemRegionID;
+
     _switchedOut = false;
 
     ThreadID size = threadContexts.size();
@@ -656,6 +669,16 @@ void BaseCPU::serialize(CheckpointOut &cp) const {
          * system. */
         SERIALIZE_SCALAR(_pid);
 
+        // Keep the m5_add_mem_region table, checkpoints are commonly
+        // taken after the workload registered its regions
+        std::vector<Addr> mem_region_begin, mem_region_end;
+        for (const auto &region : memRegions) {
+            mem_region_begin.push_back(region.first);
+            mem_region_end.push_back(region.second);
+        }
+        SERIALIZE_CONTAINER(mem_region_begin);
+        SERIALIZE_CONTAINER(mem_region_end);
+
         // Serialize the threads, this is done by the CPU implementation.
         for (ThreadID i = 0; i < numThreads; ++i) {
             ScopedCheckpointSection sec(cp, csprintf("xc.%i", i));
@@ -671,6 +694,23 @@ void BaseCPU::unserialize(CheckpointIn &cp) {
     if (!_switchedOut) {
         UNSERIALIZE_SCALAR(_pid);
 
+        // Checkpoints predating the region table have no regions
+        if (cp.entryExists(Serializable::currentSection(),
+                           "mem_region_begin")) {
+            std::vector<Addr> mem_region_begin, mem_region_end;
+            UNSERIALIZE_CONTAINER(mem_region_begin);
+            UNSERIALIZE_CONTAINER(mem_region_end);
+            fatal_if(mem_region_begin.size() != memRegions.size() ||
+                     mem_region_end.size() != memRegions.size(),
+                     "Checkpoint has %d memory regions, expected %d\n",
+                     mem_region_begin.size(), memRegions.size());
+            clearMemRegion();
+            for (int i = 0; i < MAX_CMD_REGIONS; i++) {
+                if (mem_region_end[i] != 0)
+                    addMemRegion(mem_region_begin[i], mem_region_end[i], i);
+            }
+        }
+
         // Unserialize the threads, this is done by the CPU implementation.
         for (ThreadID i = 0; i < numThreads; ++i) {
             ScopedCheckpointSection sec(cp, csprintf("xc.%i", i));
@@ -691,6 +731,57 @@ Tick BaseCPU::getCurrentInstCount(ThreadID tid) {
     return threadContexts[tid]->getCurrentInstCount();
 }
 
+void BaseCPU::scheduleSampleStop(Counter insts) {
+    descheduleSampleStop();
+    while ((ThreadID)sampleStopEvents.size() < numThreads) {
+        sampleStopEvents.push_back(
+            new LocalSimLoopExitEvent("sample boundary reached", 0));
+    }
+    for (ThreadID tid = 0; tid < numThreads; ++tid) {
+        threadContexts[tid]->scheduleInstCountEvent(
+            sampleStopEvents[tid], getCurrentInstCount(tid) + insts);
+    }
+}
+
+void BaseCPU::descheduleSampleStop() {
+    for (ThreadID tid = 0; tid < (ThreadID)sampleStopEvents.size(); ++tid) {
+        if (sampleStopEvents[tid]->scheduled())
+            threadContexts[tid]->descheduleInstCountEvent(
+                sampleStopEvents[tid]);
+    }
+}
+
+void BaseCPU::addMemRegion(Addr begin, Addr end, uint64_t region_id) {
+    // Negative ids from the guest wrap around to large ones
+    fatal_if(region_id >= MAX_CMD_REGIONS,
+             "Memory region id %d is out of range [0, %d)\n",
+             (int64_t)region_id, MAX_CMD_REGIONS);
+    const int8_t id = region_id;
+    assert(begin < end);
+    maxMemRegionID = -1;
+    for (int i = 0; i < MAX_CMD_REGIONS; i++) {
+        if (begin <= memRegions[i].first && memRegions[i].first < end) {
+            DPRINTF(PseudoInst, "Region[%d]:[0x%x-0x%x] overlaps with new "
+                    "Region[%d]:[0x%x-0x%x], removing it\n", i,
+                    memRegions[i].first, memRegions[i].second, id, begin,
+                    end);
+            memRegions[i] = {0, 0};
+        } else if (memRegions[i].second != 0) {
+            maxMemRegionID = i;
+        }
+    }
+    DPRINTF(PseudoInst, "Region[%d]:[0x%x-0x%x] added\n", id, begin, end);
+    memRegions[id] = {begin, end};
+    maxMemRegionID = std::max<int>(maxMemRegionID, id);
+}
+
+void BaseCPU::clearMemRegion() {
+    DPRINTF(PseudoInst, "all addr regions cleared\n");
+    std::fill(memRegions.begin(), memRegions.end(),
+              std::pair<Addr, Addr>(0, 0));
+    maxMemRegionID = -1;
+}
+
 AddressMonitor::AddressMonitor() {
     armed = false;
     waiting = false;
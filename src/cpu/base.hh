@@ -208,12 +208,45 @@ public:
     uint32_t getPid() const { return _pid; }
     void setPid(uint32_t pid) { _pid = pid; }
 
-    inline void workItemBegin() { baseStats.numWorkItemsStarted++; }
-    inline void workItemEnd() { baseStats.numWorkItemsCompleted++; }
+    inline void workItemBegin() {
+        baseStats.numWorkItemsStarted++;
+        ppWorkItem->notify(true);
+    }
+    inline void workItemEnd() {
+        baseStats.numWorkItemsCompleted++;
+        ppWorkItem->notify(false);
+    }
+
+    /**
+     * Tag accesses to [begin, end) with a memory region id, as requested
+     * by m5_add_mem_region. Regions that overlap the new one are dropped.
+     * The table lives in the CPU rather than in a pipeline structure so
+     * that takeOverFrom can hand it over when switching CPU models.
+     * The id is taken as passed by the guest and checked before it is
+     * narrowed.
+     */
+    void addMemRegion(Addr begin, Addr end, uint64_t id);
+    void clearMemRegion();
+
+    /** Memory region id of an address, -1 if it is not in any region. */
+    int8_t
+    getMemRegion(Addr addr) const {
+        for (int i = 0; i <= maxMemRegionID; i++) {
+            if (memRegions[i].first <= addr && addr < memRegions[i].second)
+                return i;
+        }
+        return -1;
+    }
+
     // @todo remove me after debugging with legion done
     Tick instCount() { return instCnt; }
 
 protected:
+    /** Address range of each memory region id, {0, 0} if unused. */
+    std::vector<std::pair<Addr, Addr>> memRegions;
+    /** Highest memory region id in use, -1 if there is none. */
+    int maxMemRegionID;
+
     std::vector<BaseInterrupts *> interrupts;
 
 public:
@@ -470,6 +503,25 @@ public:
      */
     uint64_t getCurrentInstCount(ThreadID tid);
 
+    /**
+     * Schedule a sample boundary: an exit event with the cause "sample
+     * boundary reached" when any thread in the core has committed insts
+     * more instructions. A boundary scheduled earlier is replaced, and
+     * the boundary is dropped when the CPU is switched out, so a sampling
+     * controller that alternates between CPU models never sees a stale
+     * one.
+     *
+     * @param insts Number of instructions into the future.
+     */
+    void scheduleSampleStop(Counter insts);
+
+    /** Drop the pending sample boundary of this CPU, if any. */
+    void descheduleSampleStop();
+
+private:
+    /** Per-thread sample boundary events, allocated on first use. */
+    std::vector<Event *> sampleStopEvents;
+
 public:
     /**
      * @{
@@ -529,6 +581,13 @@ protected:
      * remaining threadContexts are disabled.
      */
     ProbePointArg<bool> *ppSleeping;
+
+    /**
+     * ProbePoint that signals the work item markers (m5_work_begin and
+     * m5_work_end) executed on this CPU. The parameter is true when a work
+     * item begins and false when it ends.
+     */
+    ProbePointArg<bool> *ppWorkItem;
     /** @} */
 
     enum CPUState {
@@ -389,6 +389,9 @@ KvmVM::delayedStartup()
                       "a KVM VM.\n");
             }
 
+            // The guest writes to the region directly
+            system->getPhysMem().untrackDirtyPages(slot);
+
             const MemSlot slot = allocMemSlot(range.size());
             setupMemSlot(slot, pmem, range.start(), 0/* flags */);
         } else {
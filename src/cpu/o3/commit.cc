@@ -975,6 +975,7 @@ Commit::commitInsts()
                 cpu->commitStats[tid]
                     ->committedInstType[head_inst->opClass()]++;
                 stats.committedInstType[tid][head_inst->opClass()]++;
+                cpu->topDown.retire(head_inst);
                 ppCommit->notify(head_inst);
 
                 // hardware transactional memory
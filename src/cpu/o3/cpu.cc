@@ -114,6 +114,7 @@ CPU::CPU(const BaseO3CPUParams &params)
       globalSeqNum(1),
       system(params.system),
       lastRunningCycle(curCycle()),
+      topDown(this, &rob, params),
       cpuStats(this)
 {
     fatal_if(FullSystem && params.numThreads > 1,
@@ -63,6 +63,7 @@
 #include "cpu/o3/rob.hh"
 #include "cpu/o3/scoreboard.hh"
 #include "cpu/o3/thread_state.hh"
+#include "cpu/o3/top_down.hh"
 #include "cpu/activity.hh"
 #include "cpu/base.hh"
 #include "cpu/simple_thread.hh"
@@ -362,14 +363,6 @@ public:
     /** Debug function to print all instructions on the list. */
     void dumpInsts();
 
-    inline void addMemRegion(Addr begin, Addr end, int8_t id) {
-        iew.ldstQueue.addAddrRegion(begin, end, id);
-    }
-
-    inline void clearMemRegion() {
-        iew.ldstQueue.clearAddrRegion();
-    }
-
 public:
 #ifndef NDEBUG
     /** Count of total number of dynamic instructions in flight. */
@@ -563,6 +556,9 @@ public:
         return iew.ldstQueue.getDataPort();
     }
 
+    /** Top-down accounting of the pipeline slots. */
+    TopDown topDown;
+
     struct CPUStats : public statistics::Group {
         CPUStats(CPU *cpu);
 
@@ -956,6 +956,11 @@ public:
     Tick firstIssue = -1;
     Tick lastWakeDependents = -1;
 
+    /** Number of caches the deepest access of this instruction missed
+     * in, 0 for an L1 hit. -1 if no response came from memory, e.g.
+     * when a load was forwarded from the store queue. */
+    int8_t memAccessDepth = -1;
+
     /** Reads a misc. register, including any side-effects the read
      * might have as defined by the architecture.
      */
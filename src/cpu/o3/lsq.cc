@@ -52,7 +52,6 @@
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
 #include "debug/Drain.hh"
-#include "debug/PseudoInst.hh"
 #include "debug/Fetch.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQ.hh"
@@ -80,9 +79,7 @@ LSQ::LSQ(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params)
       maxSQEntries(maxLSQAllocation(lsqPolicy, SQEntries, params.numThreads,
                                     params.smtLSQThreshold)),
       dcachePort(this, cpu_ptr),
-      numThreads(params.numThreads),
-      addrRegions(MAX_CMD_REGIONS, {0, 0}),
-      maxRegionID(-1) {
+      numThreads(params.numThreads) {
     assert(numThreads > 0 && numThreads <= MaxThreads);
 
     //**********************************************
@@ -118,34 +115,6 @@ LSQ::LSQ(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params)
     }
 }
 
-void LSQ::addAddrRegion(Addr start, Addr end, int8_t id) {
-    assert(id < MAX_CMD_REGIONS);
-    assert(start < end);
-    assert(end != 0);
-    maxRegionID = -1;
-    for (int i = 0; i < MAX_CMD_REGIONS; i++) {
-        if (start <= addrRegions[i].first && addrRegions[i].first < end) {
-            DPRINTF(PseudoInst, "Region[%d]:[0x%x-0x%x] overlaps with new Region[%d]:[0x%x-0x%x], removing it\n", i, addrRegions[i].first, addrRegions[i].second, id, start, end);
-            addrRegions[i] = {0, 0};
-        } else {
-            maxRegionID = i;
-        }
-    }
-    DPRINTF(PseudoInst, "Region[%d]:[0x%x-0x%x] added\n", id, start, end);
-    addrRegions[id] = {start, end};
-    if (id > maxRegionID) {
-        maxRegionID = id;
-    }
-}
-
-void LSQ::clearAddrRegion() {
-    DPRINTF(PseudoInst, "all addr regions cleared\n");
-    maxRegionID = -1;
-    for (int i = 0; i < MAX_CMD_REGIONS; i++) {
-        addrRegions[i] = {0, 0};
-    }
-}
-
 std::string
 LSQ::name() const {
     return iewStage->name() + ".lsq";
@@ -377,6 +346,11 @@ bool LSQ::recvTimingResp(PacketPtr pkt) {
     LSQRequest *request = dynamic_cast<LSQRequest *>(pkt->senderState);
     panic_if(!request, "Got packet back with unknown sender state\n");
 
+    // Split accesses are as slow as their deepest fragment
+    const DynInstPtr &inst = request->instruction();
+    inst->memAccessDepth = std::max<int>(inst->memAccessDepth,
+                                         pkt->req->getAccessDepth());
+
     thread[cpu->contextToThread(request->contextId())].recvTimingResp(pkt);
 
     if (pkt->isInvalidate()) {
@@ -727,15 +701,9 @@ Fault LSQ::pushRequest(const DynInstPtr &inst, bool isLoad, uint8_t *data,
         request = inst->savedRequest;
         assert(request);
     } else {
-        int8_t reg = -1;
-        for (int reg_idx = 0; reg_idx <= maxRegionID; reg_idx++) {
-            if (addrRegions[reg_idx].first == 0 && addrRegions[reg_idx].second == 0) {
-                continue;
-            } else if (addrRegions[reg_idx].first <= addr && addr < addrRegions[reg_idx].second) {
-                reg = reg_idx;
-                DPRINTF(LSQ, "addr region[%d] [%x-%x] detected for addr[%x]\n", reg_idx, addrRegions[reg_idx].first, addrRegions[reg_idx].second, addr);
-                break;
-            }
+        int8_t reg = cpu->getMemRegion(addr);
+        if (reg != -1) {
+            DPRINTF(LSQ, "addr region[%d] detected for addr[%x]\n", reg, addr);
         }
         inst->setRegion(reg);
         if (htm_cmd || tlbi_cmd) {
@@ -74,8 +74,6 @@ class LSQ {
 public:
     class LSQRequest;
 
-    typedef std::pair<Addr, Addr> AddrRegion;
-
     /**
      * DcachePort class for the load/store queue.
      */
@@ -848,9 +846,6 @@ public:
 
     RequestPort &getDataPort() { return dcachePort; }
 
-    void addAddrRegion(Addr start, Addr end, int8_t id);
-    void clearAddrRegion();
-
 protected:
     /** D-cache is blocked */
     bool _cacheBlocked;
@@ -915,10 +910,6 @@ protected:
 
     /** Number of Threads. */
     ThreadID numThreads;
-
-    /** Request address to Region map **/
-    std::vector<AddrRegion> addrRegions;
-    int maxRegionID;
 };
 
 } // namespace o3
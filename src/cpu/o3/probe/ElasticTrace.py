@@ -68,3 +68,10 @@ class ElasticTrace(ProbeListenerObject):
     traceVirtAddr = Param.Bool(
         False, "Set to true if virtual addresses are to be traced."
     )
+    # Whether to restrict tracing to the region of interest between the
+    # m5_work_begin and m5_work_end markers
+    traceWorkItemsOnly = Param.Bool(
+        False,
+        "Set to true to only trace between work item "
+        "begin and end markers. startTraceInst is ignored.",
+    )
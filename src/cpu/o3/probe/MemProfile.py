@@ -0,0 +1,49 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.Probe import *
+from m5.params import *
+
+
+class MemProfile(ProbeListenerObject):
+    """Per-PC profile of the loads and stores committed by an O3 CPU,
+    sorted by the cycles they blocked commit at the head of the ROB. The
+    profile covers the instructions committed since the last stats reset
+    and is rewritten on every stats dump."""
+
+    type = "MemProfile"
+    cxx_class = "gem5::o3::MemProfile"
+    cxx_header = "cpu/o3/probe/mem_profile.hh"
+
+    output_file = Param.String(
+        "", "File the profile is written to, <name>.txt if empty"
+    )
+    level_names = VectorParam.String(
+        ["L1", "L2", "L3", "Mem"],
+        "Names of the memory levels serving the loads, by the number of "
+        "caches they missed in; deeper accesses count for the last level",
+    )
+    max_entries = Param.Unsigned(0, "Number of PCs to print, 0 for all")
@@ -55,6 +55,7 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
     :  ProbeListenerObject(params),
        regEtraceListenersEvent([this]{ regEtraceListeners(); }, name()),
        firstWin(true),
+       traceStartTick(0),
        lastClearedSeqNum(0),
        depWindowSize(params.depWindowSize),
        dataTraceStream(nullptr),
@@ -62,6 +63,8 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
        startTraceInst(params.startTraceInst),
        allProbesReg(false),
        traceVirtAddr(params.traceVirtAddr),
+       traceWorkItemsOnly(params.traceWorkItemsOnly),
+       workItemDepth(0),
        stats(this)
 {
     cpu = dynamic_cast<CPU *>(params.manager);
@@ -105,7 +108,11 @@ ElasticTrace::regProbeListeners()
 {
     inform("@%llu: regProbeListeners() called, startTraceInst = %llu",
         curTick(), startTraceInst);
-    if (startTraceInst == 0) {
+    if (traceWorkItemsOnly) {
+        // The work item markers register and remove all other listeners.
+        listeners.push_back(new ProbeListenerArg<ElasticTrace, bool>(this,
+                            "WorkItem", &ElasticTrace::workItemTrace));
+    } else if (startTraceInst == 0) {
         // If we want to start tracing from the start of the simulation,
         // register all elastic trace probes now.
         regEtraceListeners();
@@ -147,6 +154,48 @@ ElasticTrace::regEtraceListeners()
     allProbesReg = true;
 }
 
+void
+ElasticTrace::unregEtraceListeners()
+{
+    assert(allProbesReg);
+    inform("@%llu: No. of instructions committed = %llu, removing elastic"
+        " probe listeners", curTick(), cpu->numSimulatedInsts());
+    // Only the listeners added by regEtraceListeners() come after the work
+    // item listener, which stays registered.
+    assert(traceWorkItemsOnly && !listeners.empty());
+    for (auto it = listeners.begin() + 1; it != listeners.end(); ++it)
+        delete *it;
+    listeners.resize(1);
+    allProbesReg = false;
+
+    // Write out everything recorded in this region. Instructions still in
+    // flight are dropped, they get no record as for a late start.
+    writeDepTrace(depTrace.size());
+    firstWin = false;
+    for (auto &temp_store_entry : tempStore)
+        delete temp_store_entry.second;
+    tempStore.clear();
+    physRegDepMap.clear();
+}
+
+void
+ElasticTrace::workItemTrace(const bool &begin)
+{
+    if (begin) {
+        if (workItemDepth++ == 0 && !allProbesReg) {
+            // Dependency-free records of a later region are timed from its
+            // start rather than from the end of the previous one.
+            if (!firstWin)
+                traceStartTick = curTick();
+            firstWin = true;
+            regEtraceListeners();
+        }
+    } else if (workItemDepth > 0) {
+        if (--workItemDepth == 0 && allProbesReg)
+            unregEtraceListeners();
+    }
+}
+
 void
 ElasticTrace::fetchReqTrace(const RequestPtr &req)
 {
@@ -414,6 +463,7 @@ ElasticTrace::addDepTraceRecord(const DynInstConstPtr& head_inst,
     // Currently the tracing does not support split requests.
     new_record->size = head_inst->effSize;
     new_record->pc = head_inst->pcState().instAddr();
+    new_record->region = head_inst->getRegion();
 
     // Assign the timing information stored in the execution info object
     new_record->executeTick = exec_info_ptr->executeTick;
@@ -820,6 +870,8 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 } else {
                     temp_ptr->compDelay = temp_ptr->toCommitTick;
                 }
+                temp_ptr->compDelay -= std::min<Tick>(traceStartTick,
+                                                      temp_ptr->compDelay);
             }
             assert(temp_ptr->compDelay != -1);
             DPRINTFR(ElasticTrace, "\thas computational delay %lli\n",
@@ -838,6 +890,8 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 if (traceVirtAddr)
                     dep_pkt.set_v_addr(temp_ptr->virtAddr);
                 dep_pkt.set_size(temp_ptr->size);
+                if (temp_ptr->region != -1)
+                    dep_pkt.set_region(temp_ptr->region);
             }
             dep_pkt.set_comp_delay(temp_ptr->compDelay);
             if (temp_ptr->robDepList.empty()) {
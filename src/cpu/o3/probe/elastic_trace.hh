@@ -112,6 +112,21 @@ class ElasticTrace : public ProbeListenerObject
     /** Register all listeners. */
     void regEtraceListeners();
 
+    /**
+     * Remove all listeners registered by regEtraceListeners(), write out
+     * the records collected so far and drop the state of instructions that
+     * are still in flight.
+     */
+    void unregEtraceListeners();
+
+    /**
+     * Start tracing when the outermost work item begins and stop when it
+     * ends. Only used when tracing is restricted to work items.
+     *
+     * @param begin true on a work item begin, false on its end
+     */
+    void workItemTrace(const bool &begin);
+
     /**
      * Process any outstanding trace records, flush them out to the protobuf
      * output streams and delete the streams at simulation exit.
@@ -190,6 +205,14 @@ class ElasticTrace : public ProbeListenerObject
      */
     bool firstWin;
 
+    /**
+     * Tick from which the computational delay of dependency-free records in
+     * the first window is counted. Zero for the first traced region, so the
+     * replay subtracts its own trace offset, and the start of the region
+     * when tracing resumes at a later work item.
+     */
+    Tick traceStartTick;
+
     /**
      * @defgroup InstExecInfo Struct for storing information before an
      * instruction reaches the commit stage, e.g. execute timestamp.
@@ -292,6 +315,8 @@ class ElasticTrace : public ProbeListenerObject
         Addr virtAddr;
         /* Request size in case of a load/store instruction */
         unsigned size;
+        /* Memory region tag in case of a load/store instruction */
+        int8_t region;
         /** Default Constructor */
         TraceInfo()
           : type(Record::INVALID)
@@ -368,6 +393,12 @@ class ElasticTrace : public ProbeListenerObject
     /** Whether to trace virtual addresses for memory requests. */
     const bool traceVirtAddr;
 
+    /** Whether to trace only between work item begin and end markers. */
+    const bool traceWorkItemsOnly;
+
+    /** Number of work items that have begun but not ended. */
+    int workItemDepth;
+
     /** Pointer to the O3CPU that is this listener's parent a.k.a. manager */
     CPU *cpu;
 
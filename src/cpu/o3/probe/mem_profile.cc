@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/probe/mem_profile.hh"
+
+#include <algorithm>
+#include <ostream>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/loader/symtab.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/statistics.hh"
+#include "cpu/base.hh"
+#include "cpu/o3/dyn_inst.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+MemProfile::MemProfile(const MemProfileParams &params)
+    : ProbeListenerObject(params),
+      cpu(dynamic_cast<BaseCPU *>(params.manager)),
+      outputFile(params.output_file.empty() ?
+                 name() + ".txt" : params.output_file),
+      levelNames(params.level_names),
+      maxEntries(params.max_entries)
+{
+    fatal_if(!cpu, "%s must be attached to a CPU\n", name());
+    fatal_if(levelNames.empty() || levelNames.size() > numLevels,
+             "%s needs between 1 and %d memory level names\n", name(),
+             numLevels);
+    headStalls.resize(cpu->numThreads);
+
+    statistics::registerResetCallback([this]() { reset(); });
+    statistics::registerDumpCallback([this]() { dump(); });
+}
+
+void
+MemProfile::regProbeListeners()
+{
+    typedef ProbeListenerArg<MemProfile, DynInstConstPtr> DynInstListener;
+    listeners.push_back(new DynInstListener(this, "CommitStall",
+                &MemProfile::commitStall));
+    listeners.push_back(new DynInstListener(this, "Commit",
+                &MemProfile::commit));
+}
+
+void
+MemProfile::commitStall(const DynInstConstPtr &inst)
+{
+    // Commit reports the head of the ROB once per cycle it can't commit
+    // it, only the first report of each instruction matters
+    HeadStall &head = headStalls[inst->threadNumber];
+    if (head.seqNum != inst->seqNum) {
+        head.seqNum = inst->seqNum;
+        head.since = curTick();
+    }
+}
+
+Counter
+MemProfile::stallCycles(const DynInstConstPtr &inst)
+{
+    HeadStall &head = headStalls[inst->threadNumber];
+    if (head.seqNum != inst->seqNum)
+        return 0;
+    head.seqNum = 0;
+    return cpu->ticksToCycles(curTick() - head.since);
+}
+
+void
+MemProfile::commit(const DynInstConstPtr &inst)
+{
+    Counter stall = stallCycles(inst);
+    totalRobStall += stall;
+
+    if (!inst->isLoad() && !inst->isStore())
+        return;
+
+    Entry &entry = profile[inst->pcState().instAddr()];
+    entry.robStall += stall;
+    if (inst->getRegion() != -1)
+        entry.region = inst->getRegion();
+
+    if (inst->isStore()) {
+        entry.stores++;
+        return;
+    }
+
+    entry.loads++;
+    if (inst->memAccessDepth == -1)
+        entry.forwarded++;
+    else
+        entry.levels[std::min<int>(inst->memAccessDepth, numLevels - 1)]++;
+
+    // Same latency as the loadToUse stats of the LSQ
+    if (!inst->isInstPrefetch() && !inst->isDataPrefetch() &&
+            inst->firstIssue != -1 && inst->lastWakeDependents != -1) {
+        Counter latency =
+            cpu->ticksToCycles(inst->lastWakeDependents - inst->firstIssue);
+        entry.latency += latency;
+        int bucket = latency ? floorLog2(latency) + 1 : 0;
+        entry.latencyHist[std::min(bucket, numLatencyBuckets - 1)]++;
+    }
+}
+
+void
+MemProfile::reset()
+{
+    profile.clear();
+    totalRobStall = 0;
+}
+
+void
+MemProfile::dump()
+{
+    std::vector<std::pair<Addr, const Entry *>> sorted;
+    sorted.reserve(profile.size());
+    Counter mem_rob_stall = 0;
+    for (const auto &[pc, entry] : profile) {
+        sorted.emplace_back(pc, &entry);
+        mem_rob_stall += entry.robStall;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const auto &a, const auto &b) {
+            if (a.second->robStall != b.second->robStall)
+                return a.second->robStall > b.second->robStall;
+            if (a.second->latency != b.second->latency)
+                return a.second->latency > b.second->latency;
+            return a.first < b.first;
+        });
+
+    OutputStream *os = simout.create(outputFile, false, true);
+    std::ostream &out = *os->stream();
+
+    ccprintf(out, "# Memory instruction profile of %s\n", cpu->name());
+    ccprintf(out, "# %d static memory instructions, %d of %d ROB head "
+             "stall cycles\n", profile.size(), mem_rob_stall,
+             totalRobStall);
+    ccprintf(out, "# Latencies are load-to-use cycles, the histogram "
+             "buckets are 0, [1,2), [2,4), ... cycles\n");
+    ccprintf(out, "#%17s %-32s %10s %10s %12s %8s %10s %6s", "pc", "symbol",
+             "loads", "stores", "stall", "stall%", "avg_lat", "region");
+    for (const auto &level : levelNames)
+        ccprintf(out, " %10s", level);
+    ccprintf(out, " %10s  latency_hist\n", "fwd");
+
+    unsigned printed = 0;
+    for (const auto &[pc, entry] : sorted) {
+        if (maxEntries && printed++ == maxEntries)
+            break;
+
+        std::string symbol = "-";
+        auto it = loader::debugSymbolTable.findNearest(pc);
+        if (it != loader::debugSymbolTable.end())
+            symbol = csprintf("%s+%d", it->name(), pc - it->address());
+
+        Counter timed_loads = 0;
+        for (auto count : entry->latencyHist)
+            timed_loads += count;
+
+        ccprintf(out, " %#17x %-32s %10d %10d %12d %7.2f%% %10.1f %6d",
+                 pc, symbol, entry->loads, entry->stores, entry->robStall,
+                 totalRobStall ? 100.0 * entry->robStall / totalRobStall : 0,
+                 timed_loads ? (double)entry->latency / timed_loads : 0,
+                 entry->region);
+
+        // Accesses deeper than the named levels count for the last one
+        int num_names = levelNames.size();
+        for (int level = 0; level < num_names; level++) {
+            Counter count = entry->levels[level];
+            if (level == num_names - 1) {
+                for (int deeper = level + 1; deeper < numLevels; deeper++)
+                    count += entry->levels[deeper];
+            }
+            ccprintf(out, " %10d", count);
+        }
+        ccprintf(out, " %10d ", entry->forwarded);
+
+        int last = numLatencyBuckets - 1;
+        while (last > 0 && entry->latencyHist[last] == 0)
+            last--;
+        for (int bucket = 0; bucket <= last; bucket++) {
+            ccprintf(out, "%s%d", bucket ? "," : " ",
+                     entry->latencyHist[bucket]);
+        }
+        ccprintf(out, "\n");
+    }
+
+    simout.close(os);
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_PROBE_MEM_PROFILE_HH__
+#define __CPU_O3_PROBE_MEM_PROFILE_HH__
+
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+#include "params/MemProfile.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+
+namespace o3
+{
+
+/**
+ * Per-PC profile of the memory instructions committed by an O3 CPU, in
+ * the spirit of perf's mem mode. For each static load and store it
+ * counts the committed instances, the load-to-use latency of the loads
+ * (the same latency as the LSQ loadToUse stats) as a log2 histogram, the
+ * memory level that served them and the cycles they spent blocking commit
+ * at the head of the ROB, along with their memory region.
+ *
+ * The profile covers the instructions committed since the last stats
+ * reset. It is written, sorted by ROB head stall cycles, to the output
+ * file on every stats dump.
+ */
+class MemProfile : public ProbeListenerObject
+{
+  public:
+    MemProfile(const MemProfileParams &params);
+
+    /** Register the probe listeners. */
+    void regProbeListeners() override;
+
+    /** Forget the profile, called on stats reset. */
+    void reset();
+
+    /** Write the profile, called on stats dump. */
+    void dump();
+
+  protected:
+    /** Latency histogram buckets, bucket b > 0 covers [2^(b-1), 2^b)
+     * cycles and bucket 0 covers 0 cycles. */
+    static constexpr int numLatencyBuckets = 16;
+
+    /** Memory levels told apart, deeper accesses count as the last. */
+    static constexpr int numLevels = 8;
+
+    struct Entry
+    {
+        Counter loads = 0;
+        Counter stores = 0;
+        /** Sum of the load-to-use latencies of the loads, in cycles */
+        Counter latency = 0;
+        std::array<Counter, numLatencyBuckets> latencyHist{};
+        /** Loads served by each level, by cache access depth */
+        std::array<Counter, numLevels> levels{};
+        /** Loads that got their data without a memory access */
+        Counter forwarded = 0;
+        /** Cycles spent at the head of the ROB waiting to commit */
+        Counter robStall = 0;
+        /** Region of the last access that had one, -1 if none did */
+        int8_t region = -1;
+    };
+
+    /** Head of the ROB of a thread, as seen by the commit stall probe */
+    struct HeadStall
+    {
+        InstSeqNum seqNum = 0;
+        Tick since = 0;
+    };
+
+    void commitStall(const DynInstConstPtr &inst);
+    void commit(const DynInstConstPtr &inst);
+
+    /** Cycles inst blocked commit for, 0 if it never stalled it. */
+    Counter stallCycles(const DynInstConstPtr &inst);
+
+    BaseCPU *cpu;
+
+    /** File the profile is written to */
+    const std::string outputFile;
+
+    /** Names of the memory levels, by cache access depth */
+    const std::vector<std::string> levelNames;
+
+    /** Number of PCs to print, 0 to print all of them */
+    const unsigned maxEntries;
+
+    std::unordered_map<Addr, Entry> profile;
+
+    std::vector<HeadStall> headStalls;
+
+    /** ROB head stall cycles of all instructions, memory or not */
+    Counter totalRobStall = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_PROBE_MEM_PROFILE_HH__
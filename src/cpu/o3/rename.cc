@@ -85,6 +85,7 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
         stalls[tid] = {false, false};
         serializeInst[tid] = nullptr;
         serializeOnNextInst[tid] = false;
+        recovering[tid] = false;
     }
 }
 
@@ -245,6 +246,7 @@ Rename::clearStates(ThreadID tid)
     storesInProgress[tid] = 0;
 
     serializeOnNextInst[tid] = false;
+    recovering[tid] = false;
 }
 
 void
@@ -275,6 +277,7 @@ Rename::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+        recovering[tid] = false;
     }
 }
 
@@ -341,6 +344,8 @@ Rename::squash(const InstSeqNum &squash_seq_num, ThreadID tid)
     DPRINTF(Rename, "[tid:%i] [squash sn:%llu] Squashing instructions.\n",
         tid,squash_seq_num);
 
+    recovering[tid] = true;
+
     // Clear the stall signal if rename was blocked or unblocking before.
     // If it still needs to block, the blocking should happen the next
     // cycle and there should be space to hold everything due to the squash.
@@ -398,6 +403,8 @@ Rename::tick()
     bool status_change = false;
 
     toIEWIndex = 0;
+    topDownCause = TopDown::FrontEnd;
+    topDownThread = 0;
 
     sortInsts();
 
@@ -424,6 +431,14 @@ Rename::tick()
         cpu->activityThisCycle();
     }
 
+    // Until the correct path reaches rename again after a squash, the
+    // empty slots are the cost of the misspeculation, not of the front end
+    for (ThreadID tid : *activeThreads) {
+        if (recovering[tid])
+            setTopDownCause(TopDown::BadSpeculation, tid);
+    }
+    cpu->topDown.renameCycle(toIEWIndex, topDownCause, topDownThread);
+
     threads = activeThreads->begin();
 
     while (threads != end) {
@@ -463,10 +478,12 @@ Rename::rename(bool &status_change, ThreadID tid)
 
     if (renameStatus[tid] == Blocked) {
         ++stats.blockCycles;
+        setTopDownCause(TopDown::BackEnd, tid);
     } else if (renameStatus[tid] == Squashing) {
         ++stats.squashCycles;
     } else if (renameStatus[tid] == SerializeStall) {
         ++stats.serializeStallCycles;
+        setTopDownCause(TopDown::BackEnd, tid);
         // If we are currently in SerializeStall and resumeSerialize
         // was set, then that means that we are resuming serializing
         // this cycle.  Tell the previous stages to block.
@@ -554,6 +571,7 @@ Rename::renameInsts(ThreadID tid)
         block(tid);
 
         incrFullStat(source);
+        setTopDownCause(TopDown::BackEnd, tid);
 
         return;
     } else if (min_free_entries < insts_available) {
@@ -569,6 +587,7 @@ Rename::renameInsts(ThreadID tid)
         blockThisCycle = true;
 
         incrFullStat(source);
+        setTopDownCause(TopDown::BackEnd, tid);
     }
 
     InstQueue &insts_to_rename = renameStatus[tid] == Unblocking ?
@@ -615,6 +634,7 @@ Rename::renameInsts(ThreadID tid)
                         tid);
                 source = LQ;
                 incrFullStat(source);
+                setTopDownCause(TopDown::BackEnd, tid);
                 break;
             }
         }
@@ -625,6 +645,7 @@ Rename::renameInsts(ThreadID tid)
                         tid);
                 source = SQ;
                 incrFullStat(source);
+                setTopDownCause(TopDown::StoreQueueFull, tid);
                 break;
             }
         }
@@ -666,6 +687,7 @@ Rename::renameInsts(ThreadID tid)
             blockThisCycle = true;
             insts_to_rename.push_front(inst);
             ++stats.fullRegistersEvents;
+            setTopDownCause(TopDown::BackEnd, tid);
 
             break;
         }
@@ -697,6 +719,7 @@ Rename::renameInsts(ThreadID tid)
             serializeInst[tid] = inst;
 
             blockThisCycle = true;
+            setTopDownCause(TopDown::BackEnd, tid);
 
             break;
         } else if ((inst->isStoreConditional() || inst->isSerializeAfter()) &&
@@ -739,6 +762,9 @@ Rename::renameInsts(ThreadID tid)
     instsInProgress[tid] += renamed_insts;
     stats.renamedInsts += renamed_insts;
 
+    if (renamed_insts)
+        recovering[tid] = false;
+
     // If we wrote to the time buffer, record this.
     if (toIEWIndex) {
         wroteToTimeBuffer = true;
@@ -1422,6 +1448,15 @@ Rename::incrFullStat(const FullSource &source)
     }
 }
 
+void
+Rename::setTopDownCause(TopDown::StallCause cause, ThreadID tid)
+{
+    if (topDownCause == TopDown::FrontEnd) {
+        topDownCause = cause;
+        topDownThread = tid;
+    }
+}
+
 void
 Rename::dumpHistory()
 {
@@ -52,6 +52,7 @@
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/top_down.hh"
 #include "cpu/timebuf.hh"
 #include "sim/probe/probe.hh"
 
@@ -428,6 +429,22 @@ class Rename
      */
     bool serializeOnNextInst[MaxThreads];
 
+    /** Records if a thread has not renamed any instruction since it was
+     * last squashed.
+     */
+    bool recovering[MaxThreads];
+
+    /** Why the slots rename does not fill this cycle are lost, and the
+     * thread that lost them.
+     */
+    TopDown::StallCause topDownCause;
+    ThreadID topDownThread;
+
+    /** Records the reason rename stalls this cycle, unless an earlier
+     * thread already stalled it.
+     */
+    void setTopDownCause(TopDown::StallCause cause, ThreadID tid);
+
     /** Delay between iew and rename, in ticks. */
     int iewToRenameDelay;
 
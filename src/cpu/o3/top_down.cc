@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/top_down.hh"
+
+#include <algorithm>
+#include <string>
+
+#include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst.hh"
+#include "cpu/o3/rob.hh"
+#include "mem/packet.hh"
+#include "params/BaseO3CPU.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+TopDown::TopDown(CPU *cpu, ROB *_rob, const BaseO3CPUParams &params)
+    : statistics::Group(cpu, "topDown"),
+      rob(_rob),
+      width(params.renameWidth),
+      ADD_STAT(slots, statistics::units::Count::get(),
+               "Number of pipeline slots, renameWidth per cycle rename "
+               "ran"),
+      ADD_STAT(renamedSlots, statistics::units::Count::get(),
+               "Number of slots used to rename an instruction"),
+      ADD_STAT(retiredSlots, statistics::units::Count::get(),
+               "Number of slots of instructions that committed"),
+      ADD_STAT(recoverySlots, statistics::units::Count::get(),
+               "Number of slots left unused while recovering from a "
+               "squash"),
+      ADD_STAT(frontEndSlots, statistics::units::Count::get(),
+               "Number of slots left unused because the front end "
+               "delivered no instruction"),
+      ADD_STAT(backEndSlots, statistics::units::Count::get(),
+               "Number of slots left unused because the back end could "
+               "not accept an instruction"),
+      ADD_STAT(loadBoundSlots, statistics::units::Count::get(),
+               "Number of back end bound slots with a load waiting for "
+               "memory at the ROB head"),
+      ADD_STAT(storeBoundSlots, statistics::units::Count::get(),
+               "Number of back end bound slots with a full store queue"),
+      ADD_STAT(loadBoundLevel, statistics::units::Count::get(),
+               "Number of load bound slots by the level that served the "
+               "load, loads forwarded from the store queue count as L1"),
+      ADD_STAT(loadBoundRegion, statistics::units::Count::get(),
+               "Number of load bound slots by the memory region of the "
+               "load"),
+      ADD_STAT(frontEndBound, statistics::units::Ratio::get(),
+               "Fraction of slots lost to the front end",
+               frontEndSlots / slots),
+      ADD_STAT(badSpeculation, statistics::units::Ratio::get(),
+               "Fraction of slots wasted on squashed instructions and on "
+               "recovering from squashes",
+               (renamedSlots - retiredSlots + recoverySlots) / slots),
+      ADD_STAT(retiring, statistics::units::Ratio::get(),
+               "Fraction of slots used by committed instructions",
+               retiredSlots / slots),
+      ADD_STAT(backEndBound, statistics::units::Ratio::get(),
+               "Fraction of slots lost to the back end",
+               backEndSlots / slots),
+      ADD_STAT(memoryBound, statistics::units::Ratio::get(),
+               "Fraction of slots lost to the back end waiting on memory",
+               (loadBoundSlots + storeBoundSlots) / slots),
+      ADD_STAT(coreBound, statistics::units::Ratio::get(),
+               "Fraction of slots lost to the back end for other reasons",
+               (backEndSlots - loadBoundSlots - storeBoundSlots) / slots)
+{
+    using namespace statistics;
+
+    static const char *levelNames[numLevels] = {"L1", "L2", "L3", "Mem"};
+    loadBoundLevel.init(numLevels).flags(total | nozero);
+    for (int i = 0; i < numLevels; i++)
+        loadBoundLevel.subname(i, levelNames[i]);
+
+    loadBoundRegion.init(MAX_CMD_REGIONS + 1).flags(nozero);
+    for (int r = 0; r < MAX_CMD_REGIONS; r++)
+        loadBoundRegion.subname(r, "region" + std::to_string(r));
+    loadBoundRegion.subname(MAX_CMD_REGIONS, "untagged");
+
+    frontEndBound.flags(nozero | nonan);
+    badSpeculation.flags(nozero | nonan);
+    retiring.flags(nozero | nonan);
+    backEndBound.flags(nozero | nonan);
+    memoryBound.flags(nozero | nonan);
+    coreBound.flags(nozero | nonan);
+}
+
+void
+TopDown::renameCycle(unsigned renamed, StallCause cause, ThreadID tid)
+{
+    slots += width;
+    renamedSlots += renamed;
+
+    if (renamed >= width)
+        return;
+    const unsigned unused = width - renamed;
+
+    switch (cause) {
+      case FrontEnd:
+        frontEndSlots += unused;
+        return;
+      case BadSpeculation:
+        recoverySlots += unused;
+        return;
+      case BackEnd:
+      case StoreQueueFull:
+        backEndSlots += unused;
+        break;
+    }
+
+    const DynInstPtr &head = rob->readHeadInst(tid);
+    if (!rob->isEmpty(tid) && head->isLoad() && head->isIssued() &&
+            !head->readyToCommit()) {
+        StallingLoad &load = stallingLoad[tid];
+        if (load.inst != head) {
+            attributeLoad(tid);
+            load.inst = head;
+        }
+        load.slots += unused;
+        loadBoundSlots += unused;
+    } else if (cause == StoreQueueFull) {
+        storeBoundSlots += unused;
+    }
+}
+
+void
+TopDown::retire(const DynInstPtr &inst)
+{
+    retiredSlots++;
+
+    if (stallingLoad[inst->threadNumber].inst == inst)
+        attributeLoad(inst->threadNumber);
+}
+
+void
+TopDown::attributeLoad(ThreadID tid)
+{
+    StallingLoad &load = stallingLoad[tid];
+    if (load.inst && load.slots) {
+        int level = std::clamp<int>(load.inst->memAccessDepth, 0,
+                                    numLevels - 1);
+        int region = load.inst->getRegion();
+        loadBoundLevel[level] += load.slots;
+        loadBoundRegion[region == -1 ? MAX_CMD_REGIONS : region] +=
+            load.slots;
+    }
+    load.inst = nullptr;
+    load.slots = 0;
+}
+
+void
+TopDown::resetStats()
+{
+    statistics::Group::resetStats();
+
+    // Slots lost before the reset must not show up in the breakdown
+    for (auto &load : stallingLoad)
+        load.slots = 0;
+}
+
+} // namespace o3
+} // namespace gem5
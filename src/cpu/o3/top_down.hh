@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_TOP_DOWN_HH__
+#define __CPU_O3_TOP_DOWN_HH__
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/limits.hh"
+
+namespace gem5
+{
+
+struct BaseO3CPUParams;
+
+namespace o3
+{
+
+class CPU;
+class ROB;
+
+/**
+ * Top-down accounting of the pipeline slots of an O3 CPU, following
+ * Yasin's Top-Down Microarchitecture Analysis Method. A slot is one
+ * instruction that rename, the allocation stage of O3, could have sent
+ * to the back end in a cycle, so every cycle rename ticks provides
+ * renameWidth slots. Slots that carried an instruction end up either
+ * retiring or, when the instruction is squashed, as bad speculation.
+ * Slots rename left unused are attributed to the reason rename had
+ * nothing to send:
+ *  - bad speculation while a squash is being recovered from, until the
+ *    first instruction of the correct path is renamed again,
+ *  - back end bound when the ROB, IQ, LSQ or the free lists were full or
+ *    a serializing instruction was waiting,
+ *  - front end bound otherwise.
+ * Back end bound slots are memory bound when the head of the ROB is a
+ * load waiting for memory or, failing that, when the store queue was
+ * full. The rest are core bound. Load bound slots are further broken
+ * down by the memory level that served the stalling load and by its
+ * memory region; that breakdown is filled in when the load completes,
+ * so it trails the totals by the loads still outstanding.
+ */
+class TopDown : public statistics::Group
+{
+  public:
+    /** Why rename left the slots it did not fill in a cycle unused. */
+    enum StallCause
+    {
+        FrontEnd,
+        BadSpeculation,
+        BackEnd,
+        StoreQueueFull
+    };
+
+    /** Number of memory levels loads are attributed to. */
+    static constexpr int numLevels = 4;
+
+    TopDown(CPU *cpu, ROB *rob, const BaseO3CPUParams &params);
+
+    /**
+     * Accounts the slots of one rename cycle.
+     * @param renamed Instructions sent to the back end this cycle.
+     * @param cause Why the remaining slots were left unused.
+     * @param tid Thread that stalled rename, used to find the ROB head.
+     */
+    void renameCycle(unsigned renamed, StallCause cause, ThreadID tid);
+
+    /** Accounts the slot of an instruction that committed. */
+    void retire(const DynInstPtr &inst);
+
+    void resetStats() override;
+
+  private:
+    /** Attributes the load bound slots of a stalling load to its level and
+     * region. */
+    void attributeLoad(ThreadID tid);
+
+    ROB *rob;
+
+    /** Slots per cycle. */
+    const unsigned width;
+
+    /** The load at the ROB head that last held up rename of each thread
+     * and the slots lost to it so far. */
+    struct StallingLoad
+    {
+        DynInstPtr inst;
+        Counter slots = 0;
+    };
+    StallingLoad stallingLoad[MaxThreads];
+
+    statistics::Scalar slots;
+    statistics::Scalar renamedSlots;
+    statistics::Scalar retiredSlots;
+    statistics::Scalar recoverySlots;
+    statistics::Scalar frontEndSlots;
+    statistics::Scalar backEndSlots;
+    statistics::Scalar loadBoundSlots;
+    statistics::Scalar storeBoundSlots;
+    statistics::Vector loadBoundLevel;
+    statistics::Vector loadBoundRegion;
+
+    statistics::Formula frontEndBound;
+    statistics::Formula badSpeculation;
+    statistics::Formula retiring;
+    statistics::Formula backEndBound;
+    statistics::Formula memoryBound;
+    statistics::Formula coreBound;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_TOP_DOWN_HH__
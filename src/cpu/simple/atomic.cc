@@ -347,6 +347,7 @@ AtomicSimpleCPU::genMemFragmentRequest(const RequestPtr &req, Addr frag_addr,
     if (isAnyActiveElement(it_start, it_end)) {
         req->setVirt(frag_addr, frag_size, flags, dataRequestorId(),
                      inst_addr);
+        req->setRegion(getMemRegion(frag_addr));
         req->setByteEnable(std::vector<bool>(it_start, it_end));
     } else {
         predicate = false;
@@ -574,6 +575,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
     req->taskId(taskId());
     req->setVirt(addr, size, flags, dataRequestorId(),
                  thread->pcState().instAddr(), std::move(amo_op));
+    req->setRegion(getMemRegion(addr));
 
     // translate to physical address
     Fault fault = thread->mmu->translateAtomic(
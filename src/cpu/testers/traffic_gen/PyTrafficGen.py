@@ -62,6 +62,7 @@ class PyTrafficGen(BaseTrafficGen):
         PyBindMethod("createHybrid"),
         PyBindMethod("createNvm"),
         PyBindMethod("createStrided"),
+        PyBindMethod("createIndirect"),
     ]
 
     @cxxMethod(override=True)
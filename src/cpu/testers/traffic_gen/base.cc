@@ -47,6 +47,7 @@
 #include "cpu/testers/traffic_gen/exit_gen.hh"
 #include "cpu/testers/traffic_gen/hybrid_gen.hh"
 #include "cpu/testers/traffic_gen/idle_gen.hh"
+#include "cpu/testers/traffic_gen/indirect_gen.hh"
 #include "cpu/testers/traffic_gen/linear_gen.hh"
 #include "cpu/testers/traffic_gen/nvm_gen.hh"
 #include "cpu/testers/traffic_gen/random_gen.hh"
@@ -260,13 +261,18 @@ BaseTrafficGen::scheduleUpdate()
     // Has the generator run out of work? In that case, force a
     // transition if a transition period hasn't been configured.
     while (activeGenerator &&
-           nextPacketTick == MaxTick && nextTransitionTick == MaxTick) {
+           nextPacketTick == MaxTick && nextTransitionTick == MaxTick &&
+           !activeGenerator->waitingForResponse()) {
         transition();
     }
 
     if (!activeGenerator)
         return;
 
+    // A generator waiting for responses is woken up by recvTimingResp
+    if (nextPacketTick == MaxTick && nextTransitionTick == MaxTick)
+        return;
+
     // schedule next update event based on either the next execute
     // tick or the next transition, which ever comes first
     const Tick nextEventTick = std::min(nextPacketTick, nextTransitionTick);
@@ -542,6 +548,33 @@ BaseTrafficGen::createStrided(Tick duration,
                                                   read_percent, data_limit));
 }
 
+std::shared_ptr<BaseGen>
+BaseTrafficGen::createIndirect(Tick duration,
+                               Addr index_addr, unsigned index_size,
+                               Addr target_addr, unsigned word_size,
+                               const std::string &access,
+                               const std::string &distribution,
+                               const std::string &index_file,
+                               Addr num_indices, Addr num_targets,
+                               double skew, unsigned mlp,
+                               uint8_t cond_percent,
+                               Tick min_period, Tick max_period,
+                               Addr data_limit)
+{
+    std::vector<uint64_t> indices = IndirectGen::makeIndices(
+        IndirectGen::parseDistribution(distribution), index_file,
+        num_indices, num_targets, skew);
+
+    return std::shared_ptr<BaseGen>(new IndirectGen(*this, requestorId,
+                                        duration, index_addr, index_size,
+                                        target_addr, word_size,
+                                        system->cacheLineSize(),
+                                        IndirectGen::parseAccess(access),
+                                        std::move(indices), mlp,
+                                        cond_percent, min_period,
+                                        max_period, data_limit));
+}
+
 std::shared_ptr<BaseGen>
 BaseTrafficGen::createTrace(Tick duration,
                             const std::string& trace_file, Addr addr_offset)
@@ -577,12 +610,23 @@ BaseTrafficGen::recvTimingResp(PacketPtr pkt)
 
     waitingResp.erase(iter);
 
+    // Requests of the active generator may depend on this response
+    const bool wake = activeGenerator && activeGenerator->recvResponse(pkt);
+
     delete pkt;
 
     // Sends up the request if we were blocked
     if (blockedWaitingResp) {
         blockedWaitingResp = false;
         retryReq();
+    } else if (wake && retryPkt == NULL && nextPacketTick == MaxTick &&
+               drainState() == DrainState::Running) {
+        // The generator was waiting for responses, find out when it
+        // can send again
+        if (updateEvent.scheduled())
+            deschedule(updateEvent);
+        nextPacketTick = activeGenerator->nextPacketTick(elasticReq, 0);
+        scheduleUpdate();
     }
 
     return true;
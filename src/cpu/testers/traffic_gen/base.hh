@@ -325,6 +325,16 @@ class BaseTrafficGen : public ClockedObject
         Tick min_period, Tick max_period,
         uint8_t read_percent, Addr data_limit);
 
+    std::shared_ptr<BaseGen> createIndirect(
+        Tick duration,
+        Addr index_addr, unsigned index_size,
+        Addr target_addr, unsigned word_size,
+        const std::string &access, const std::string &distribution,
+        const std::string &index_file,
+        Addr num_indices, Addr num_targets, double skew,
+        unsigned mlp, uint8_t cond_percent,
+        Tick min_period, Tick max_period, Addr data_limit);
+
     std::shared_ptr<BaseGen> createTrace(
         Tick duration,
         const std::string& trace_file, Addr addr_offset);
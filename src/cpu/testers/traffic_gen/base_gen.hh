@@ -134,6 +134,26 @@ class BaseGen
      */
     virtual Tick nextPacketTick(bool elastic, Tick delay) const = 0;
 
+    /**
+     * Pass a response to the generator. Generators whose requests
+     * depend on earlier responses use this to make progress; the
+     * response may belong to an earlier generator.
+     *
+     * @param pkt response to a request of the traffic generator
+     * @return true if the generator may have new packets to send
+     */
+    virtual bool recvResponse(PacketPtr pkt) { return false; }
+
+    /**
+     * Is the generator waiting for responses to create more packets?
+     * When it is, nextPacketTick() returning MaxTick does not mean the
+     * generator is done, and recvResponse() will tell when it can
+     * continue.
+     *
+     * @return true if more packets will follow outstanding responses
+     */
+    virtual bool waitingForResponse() const { return false; }
+
 };
 
 class StochasticGen : public BaseGen
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/indirect_gen.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/random.hh"
+#include "base/trace.hh"
+#include "debug/TrafficGen.hh"
+
+namespace gem5
+{
+
+IndirectGen::IndirectGen(SimObject &obj,
+                         RequestorID requestor_id, Tick _duration,
+                         Addr index_addr, unsigned index_size,
+                         Addr target_addr, unsigned word_size,
+                         Addr cacheline_size, Access _access,
+                         std::vector<uint64_t> _indices,
+                         unsigned _mlp, uint8_t cond_percent,
+                         Tick min_period, Tick max_period, Addr data_limit)
+    : BaseGen(obj, requestor_id, _duration),
+      indexAddr(index_addr), indexSize(index_size),
+      targetAddr(target_addr), wordSize(word_size),
+      cacheLineSize(cacheline_size), access(_access),
+      indices(std::move(_indices)), mlp(_mlp), condPercent(cond_percent),
+      minPeriod(min_period), maxPeriod(max_period), dataLimit(data_limit),
+      indexLinesInFlight(0), nextIndex(0), rmwReadsInFlight(0),
+      dataManipulated(0)
+{
+    if (!isPowerOf2(indexSize) || indexSize > cacheLineSize)
+        fatal("%s index size (%d) must be a power of two no larger than "
+              "the cache line size (%d)\n", name(), indexSize,
+              cacheLineSize);
+
+    if (indexAddr % indexSize)
+        fatal("%s index array at %#x is not aligned to the index size\n",
+              name(), indexAddr);
+
+    if (wordSize == 0 || wordSize > cacheLineSize)
+        fatal("%s word size (%d) must be between 1 and the cache line "
+              "size (%d)\n", name(), wordSize, cacheLineSize);
+
+    if (mlp == 0)
+        fatal("%s needs to allow at least one request in flight\n", name());
+
+    if (condPercent > 100)
+        fatal("%s cannot access more than 100% of the elements", name());
+
+    if (min_period > max_period)
+        fatal("%s cannot have min_period > max_period", name());
+}
+
+void
+IndirectGen::enter()
+{
+    // Start over at the beginning of the index array. Responses to
+    // requests from an earlier activation are ignored.
+    pending.clear();
+    ready.clear();
+    indexLinesInFlight = 0;
+    nextIndex = 0;
+    rmwReadsInFlight = 0;
+    dataManipulated = 0;
+}
+
+bool
+IndirectGen::done() const
+{
+    if (dataLimit && dataManipulated >= dataLimit)
+        return true;
+
+    return nextIndex >= indices.size() && indexLinesInFlight == 0 &&
+        ready.empty() && rmwReadsInFlight == 0;
+}
+
+bool
+IndirectGen::canIssue() const
+{
+    if (done() || pending.size() >= mlp)
+        return false;
+
+    return !ready.empty() || nextIndex < indices.size();
+}
+
+bool
+IndirectGen::issueIndexLine() const
+{
+    if (nextIndex >= indices.size())
+        return false;
+
+    // Fetch the next line of indices once we run low on targets, and
+    // never have more than one line in flight while there is still
+    // work queued.
+    return ready.empty() ||
+        (indexLinesInFlight == 0 && ready.size() < cacheLineSize / indexSize);
+}
+
+PacketPtr
+IndirectGen::getNextPacket()
+{
+    assert(canIssue());
+
+    PacketPtr pkt;
+    if (issueIndexLine()) {
+        // Read the rest of the cache line holding the next index
+        const Addr addr = indexAddr + nextIndex * indexSize;
+        const Addr line_end = roundDown(addr, cacheLineSize) + cacheLineSize;
+        const uint64_t count = std::min<uint64_t>(
+            (line_end - addr) / indexSize, indices.size() - nextIndex);
+
+        DPRINTF(TrafficGen, "IndirectGen::getNextPacket: indices %d-%d "
+                "at addr %x\n", nextIndex, nextIndex + count - 1, addr);
+
+        pkt = getPacket(addr, count * indexSize, MemCmd::ReadReq);
+        pending[pkt->req] = {Pending::Kind::IndexLine, nextIndex, count, 0};
+        nextIndex += count;
+        ++indexLinesInFlight;
+        dataManipulated += count * indexSize;
+    } else {
+        auto [cmd, addr] = ready.front();
+        ready.pop_front();
+
+        DPRINTF(TrafficGen, "IndirectGen::getNextPacket: %c to target "
+                "addr %x, size %d\n", cmd == MemCmd::ReadReq ? 'r' : 'w',
+                addr, wordSize);
+
+        pkt = getPacket(addr, wordSize, cmd);
+        if (access == Access::Rmw && cmd == MemCmd::ReadReq) {
+            pending[pkt->req] = {Pending::Kind::TargetRead, 0, 0, addr};
+            ++rmwReadsInFlight;
+        } else {
+            pending[pkt->req] = {Pending::Kind::Target, 0, 0, addr};
+        }
+        dataManipulated += wordSize;
+    }
+
+    return pkt;
+}
+
+void
+IndirectGen::indicesArrived(uint64_t first, uint64_t count)
+{
+    const MemCmd::Command cmd = access == Access::Store ?
+        MemCmd::WriteReq : MemCmd::ReadReq;
+
+    for (uint64_t i = first; i < first + count; ++i) {
+        // Masked off elements are not accessed at all
+        if (condPercent < 100 && random_mt.random(0, 99) >= condPercent)
+            continue;
+
+        ready.emplace_back(cmd, targetAddr + indices[i] * wordSize);
+    }
+}
+
+bool
+IndirectGen::recvResponse(PacketPtr pkt)
+{
+    auto it = pending.find(pkt->req);
+    if (it == pending.end())
+        return false;
+
+    const Pending p = it->second;
+    pending.erase(it);
+
+    switch (p.kind) {
+      case Pending::Kind::IndexLine:
+        --indexLinesInFlight;
+        indicesArrived(p.first, p.count);
+        break;
+      case Pending::Kind::TargetRead:
+        // Write the updated value back before moving on
+        --rmwReadsInFlight;
+        ready.emplace_front(MemCmd::WriteReq, p.addr);
+        break;
+      case Pending::Kind::Target:
+        break;
+    }
+
+    // Either way a request slot has been freed
+    return true;
+}
+
+bool
+IndirectGen::waitingForResponse() const
+{
+    return !done() && !canIssue();
+}
+
+Tick
+IndirectGen::nextPacketTick(bool elastic, Tick delay) const
+{
+    if (!canIssue()) {
+        if (done())
+            DPRINTF(TrafficGen, "IndirectGen is done.\n");
+        return MaxTick;
+    }
+
+    Tick wait = random_mt.random(minPeriod, maxPeriod);
+
+    // compensate for the delay experienced to not be elastic, by
+    // default the value we generate is from the time we are
+    // asked, so the elasticity happens automatically
+    if (!elastic) {
+        if (wait < delay)
+            wait = 0;
+        else
+            wait -= delay;
+    }
+
+    return curTick() + wait;
+}
+
+IndirectGen::Access
+IndirectGen::parseAccess(const std::string &name)
+{
+    if (name == "load")
+        return Access::Load;
+    else if (name == "store")
+        return Access::Store;
+    else if (name == "rmw")
+        return Access::Rmw;
+
+    fatal("Unknown indirect access type '%s', expected load, store or rmw\n",
+          name);
+}
+
+IndirectGen::Distribution
+IndirectGen::parseDistribution(const std::string &name)
+{
+    if (name == "uniform")
+        return Distribution::Uniform;
+    else if (name == "zipf")
+        return Distribution::Zipf;
+    else if (name == "powerlaw")
+        return Distribution::PowerLaw;
+    else if (name == "file")
+        return Distribution::File;
+    else if (name == "mtx")
+        return Distribution::MatrixMarket;
+
+    fatal("Unknown index distribution '%s', expected uniform, zipf, "
+          "powerlaw, file or mtx\n", name);
+}
+
+namespace
+{
+
+/** Pick a position with probability proportional to its weight. */
+uint64_t
+pickWeighted(const std::vector<double> &cumulative)
+{
+    const double x = random_mt.random<double>() * cumulative.back();
+    auto it = std::upper_bound(cumulative.begin(), cumulative.end(), x);
+    return std::min<uint64_t>(it - cumulative.begin(),
+                              cumulative.size() - 1);
+}
+
+std::vector<uint64_t>
+readIndexFile(const std::string &file)
+{
+    std::ifstream in(file);
+    fatal_if(!in, "Could not open index file %s\n", file);
+
+    std::vector<uint64_t> indices;
+    uint64_t index;
+    while (in >> index)
+        indices.push_back(index);
+
+    fatal_if(!in.eof(), "Malformed index in %s after %d indices\n",
+             file, indices.size());
+    return indices;
+}
+
+std::vector<uint64_t>
+readMatrixMarket(const std::string &file, uint64_t &num_cols)
+{
+    std::ifstream in(file);
+    fatal_if(!in, "Could not open Matrix Market file %s\n", file);
+
+    std::string line;
+    std::getline(in, line);
+    std::string banner, object, format, field, symmetry;
+    std::istringstream(line) >> banner >> object >> format >> field >>
+        symmetry;
+    fatal_if(banner != "%%MatrixMarket" || object != "matrix" ||
+             format != "coordinate",
+             "%s is not a Matrix Market coordinate matrix\n", file);
+    const bool mirror = symmetry == "symmetric" ||
+        symmetry == "skew-symmetric" || symmetry == "hermitian";
+
+    // Skip the comments up to the size line
+    while (std::getline(in, line) && (line.empty() || line[0] == '%'))
+        ;
+
+    uint64_t rows, nnz;
+    fatal_if(!(std::istringstream(line) >> rows >> num_cols >> nnz),
+             "Malformed size line in %s\n", file);
+
+    std::vector<std::pair<uint64_t, uint64_t>> entries;
+    entries.reserve(mirror ? 2 * nnz : nnz);
+    for (uint64_t n = 0; n < nnz; ++n) {
+        uint64_t i, j;
+        fatal_if(!std::getline(in, line) ||
+                 !(std::istringstream(line) >> i >> j) ||
+                 i < 1 || i > rows || j < 1 || j > num_cols,
+                 "Malformed entry %d in %s\n", n, file);
+
+        entries.emplace_back(i - 1, j - 1);
+        if (mirror && i != j)
+            entries.emplace_back(j - 1, i - 1);
+    }
+
+    // The column indices in row-major (CSR) order
+    std::sort(entries.begin(), entries.end());
+    std::vector<uint64_t> indices;
+    indices.reserve(entries.size());
+    for (const auto &entry: entries)
+        indices.push_back(entry.second);
+    return indices;
+}
+
+} // anonymous namespace
+
+std::vector<uint64_t>
+IndirectGen::makeIndices(Distribution dist, const std::string &file,
+                         uint64_t num_indices, uint64_t num_targets,
+                         double skew)
+{
+    std::vector<uint64_t> indices;
+
+    switch (dist) {
+      case Distribution::File:
+      case Distribution::MatrixMarket:
+        {
+            uint64_t num_cols = 0;
+            indices = dist == Distribution::File ? readIndexFile(file) :
+                readMatrixMarket(file, num_cols);
+            if (num_indices && indices.size() > num_indices)
+                indices.resize(num_indices);
+
+            const uint64_t limit = num_targets ? num_targets : num_cols;
+            if (limit) {
+                for (uint64_t index: indices) {
+                    fatal_if(index >= limit, "Index %d in %s is outside "
+                             "the %d element target array\n", index, file,
+                             limit);
+                }
+            }
+            return indices;
+        }
+      default:
+        break;
+    }
+
+    fatal_if(num_targets == 0,
+             "A synthetic index distribution needs the number of targets\n");
+
+    switch (dist) {
+      case Distribution::Uniform:
+        fatal_if(num_indices == 0,
+                 "A uniform index distribution needs the number of "
+                 "indices\n");
+        indices.reserve(num_indices);
+        for (uint64_t i = 0; i < num_indices; ++i)
+            indices.push_back(random_mt.random<uint64_t>(0, num_targets - 1));
+        break;
+      case Distribution::Zipf:
+        {
+            fatal_if(num_indices == 0,
+                     "A Zipf index distribution needs the number of "
+                     "indices\n");
+            fatal_if(skew <= 0, "The Zipf exponent must be positive\n");
+
+            std::vector<double> cumulative(num_targets);
+            double sum = 0;
+            for (uint64_t k = 0; k < num_targets; ++k) {
+                sum += 1.0 / std::pow(double(k + 1), skew);
+                cumulative[k] = sum;
+            }
+
+            // Scatter the popular elements over the target array rather
+            // than packing them into its first few cache lines
+            std::vector<uint64_t> position(num_targets);
+            for (uint64_t k = 0; k < num_targets; ++k)
+                position[k] = k;
+            for (uint64_t k = num_targets - 1; k > 0; --k) {
+                std::swap(position[k],
+                          position[random_mt.random<uint64_t>(0, k)]);
+            }
+
+            indices.reserve(num_indices);
+            for (uint64_t i = 0; i < num_indices; ++i)
+                indices.push_back(position[pickWeighted(cumulative)]);
+        }
+        break;
+      case Distribution::PowerLaw:
+        {
+            fatal_if(skew <= 1, "The power-law exponent must be larger "
+                     "than 1\n");
+
+            // Vertex degrees from a Pareto distribution with minimum 1
+            std::vector<uint64_t> degree(num_targets);
+            std::vector<double> cumulative(num_targets);
+            double sum = 0;
+            for (uint64_t v = 0; v < num_targets; ++v) {
+                const double u = 1.0 - random_mt.random<double>();
+                const double d = std::pow(u, -1.0 / (skew - 1.0));
+                degree[v] = std::min<double>(d, num_targets);
+                sum += degree[v];
+                cumulative[v] = sum;
+            }
+
+            // Emit the neighbours of each vertex in turn, as the column
+            // indices of the adjacency matrix in CSR order would be
+            for (uint64_t v = 0; v < num_targets; ++v) {
+                for (uint64_t e = 0; e < degree[v]; ++e) {
+                    if (num_indices && indices.size() >= num_indices)
+                        return indices;
+                    indices.push_back(pickWeighted(cumulative));
+                }
+            }
+        }
+        break;
+      default:
+        panic("Unhandled index distribution\n");
+    }
+
+    return indices;
+}
+
+} // namespace gem5
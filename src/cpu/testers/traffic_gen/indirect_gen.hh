@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the indirect generator that gathers, scatters or
+ * updates a target array through an index array.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_INDIRECT_GEN_HH__
+#define __CPU_TRAFFIC_GEN_INDIRECT_GEN_HH__
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base_gen.hh"
+#include "mem/packet.hh"
+
+namespace gem5
+{
+
+/**
+ * The indirect generator walks an index array and accesses a target
+ * array at the positions it names, i.e. target[index[i]] for each i,
+ * like a gather (load), scatter (store) or read-modify-write loop.
+ *
+ * The index array is read from memory a cache line at a time, and the
+ * target accesses for the indices in a line are only issued once that
+ * line has been returned: they depend on it exactly like they would in
+ * a program. A read-modify-write issues the write when the read
+ * returns. At most mlp requests are in flight at any time, and a
+ * percentage of the elements can be masked off to model a conditional
+ * access.
+ *
+ * The index values come from a file or from a synthetic distribution,
+ * see Distribution.
+ */
+class IndirectGen : public BaseGen
+{
+  public:
+
+    /** What to do with each target element */
+    enum class Access
+    {
+        Load,
+        Store,
+        Rmw
+    };
+
+    /** Where the index values come from */
+    enum class Distribution
+    {
+        /** Uniformly distributed over the target array */
+        Uniform,
+        /** Zipf distributed with exponent skew, hot elements scattered */
+        Zipf,
+        /**
+         * Column indices of a graph in CSR order, with vertex degrees
+         * drawn from a power law with exponent skew and neighbours
+         * chosen in proportion to their degree
+         */
+        PowerLaw,
+        /** Whitespace separated indices in a text file */
+        File,
+        /** Column indices of a Matrix Market matrix in CSR order */
+        MatrixMarket
+    };
+
+    /**
+     * Create an indirect access generator.
+     *
+     * @param obj SimObject owning this generator
+     * @param requestor_id RequestorID related to the memory requests
+     * @param _duration duration of this state before transitioning
+     * @param index_addr Start address of the index array
+     * @param index_size Size of one index in bytes
+     * @param target_addr Start address of the target array
+     * @param word_size Size of one target element in bytes
+     * @param cacheline_size cache line size in the system
+     * @param access Access to perform on each target element
+     * @param _indices The index values, in program order
+     * @param _mlp Maximum number of requests in flight
+     * @param cond_percent Percent of the elements that are accessed
+     * @param min_period Lower limit of random inter-transaction time
+     * @param max_period Upper limit of random inter-transaction time
+     * @param data_limit Upper limit on how much data to read/write
+     */
+    IndirectGen(SimObject &obj,
+                RequestorID requestor_id, Tick _duration,
+                Addr index_addr, unsigned index_size,
+                Addr target_addr, unsigned word_size,
+                Addr cacheline_size, Access access,
+                std::vector<uint64_t> _indices,
+                unsigned _mlp, uint8_t cond_percent,
+                Tick min_period, Tick max_period, Addr data_limit);
+
+    void enter() override;
+
+    PacketPtr getNextPacket() override;
+
+    Tick nextPacketTick(bool elastic, Tick delay) const override;
+
+    bool recvResponse(PacketPtr pkt) override;
+
+    bool waitingForResponse() const override;
+
+    /** Parse the name of an access type, as used by the Python API. */
+    static Access parseAccess(const std::string &name);
+
+    /** Parse the name of a distribution, as used by the Python API. */
+    static Distribution parseDistribution(const std::string &name);
+
+    /**
+     * Produce the index values for a generator.
+     *
+     * @param dist Where the index values come from
+     * @param file Index or Matrix Market file for the file based sources
+     * @param num_indices Number of indices to produce, 0 for all of the
+     *        file or, for a power-law graph, all of its edges
+     * @param num_targets Size of the target array in elements, 0 to
+     *        derive it from the file
+     * @param skew Exponent of the Zipf or power-law distributions
+     */
+    static std::vector<uint64_t> makeIndices(Distribution dist,
+                                             const std::string &file,
+                                             uint64_t num_indices,
+                                             uint64_t num_targets,
+                                             double skew);
+
+  private:
+    /** Can a packet be sent right now? */
+    bool canIssue() const;
+
+    /** Should the next packet fetch a line of the index array? */
+    bool issueIndexLine() const;
+
+    /** Have all the accesses of this activation been issued? */
+    bool done() const;
+
+    /** Queue the target accesses of indices [first, first + count). */
+    void indicesArrived(uint64_t first, uint64_t count);
+
+    const Addr indexAddr;
+    const unsigned indexSize;
+    const Addr targetAddr;
+    const unsigned wordSize;
+    const Addr cacheLineSize;
+    const Access access;
+    const std::vector<uint64_t> indices;
+    const unsigned mlp;
+    const uint8_t condPercent;
+    const Tick minPeriod;
+    const Tick maxPeriod;
+    const Addr dataLimit;
+
+    /** What an outstanding request was for */
+    struct Pending
+    {
+        enum class Kind
+        {
+            IndexLine,
+            TargetRead,
+            Target
+        };
+
+        Kind kind;
+        /** First index and number of indices in an index line */
+        uint64_t first;
+        uint64_t count;
+        /** Target address of a read-modify-write read */
+        Addr addr;
+    };
+
+    /** Outstanding requests of this activation */
+    std::unordered_map<RequestPtr, Pending> pending;
+
+    /** Number of index lines in flight */
+    unsigned indexLinesInFlight;
+
+    /** Next index to fetch from the index array */
+    uint64_t nextIndex;
+
+    /** Target accesses ready to issue, as (command, address) */
+    std::deque<std::pair<MemCmd::Command, Addr>> ready;
+
+    /** Read-modify-write reads waiting for their data */
+    uint64_t rmwReadsInFlight;
+
+    /** Amount of data read and written so far */
+    Addr dataManipulated;
+};
+
+} // namespace gem5
+
+#endif
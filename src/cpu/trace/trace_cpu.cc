@@ -610,6 +610,10 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
         req->setReqInstSeqNum(node_ptr->seqNum);
     }
 
+    // Tag the request with the memory region it was recorded in so that
+    // the per-region cache statistics are kept during replay.
+    req->setRegion(node_ptr->region);
+
     PacketPtr pkt;
     uint8_t* pkt_data = new uint8_t[req->getSize()];
     if (node_ptr->isLoad()) {
@@ -1287,6 +1291,11 @@ TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
         else
             element->pc = 0;
 
+        if (pkt_msg.has_region())
+            element->region = pkt_msg.region();
+        else
+            element->region = -1;
+
         // ROB occupancy number
         ++microOpCount;
         if (pkt_msg.has_weight()) {
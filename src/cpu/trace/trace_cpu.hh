@@ -575,6 +575,9 @@ class TraceCPU : public ClockedObject
             /** Instruction PC */
             Addr pc;
 
+            /** Memory region tag of the request, -1 if untagged */
+            int8_t region;
+
             /** List of order dependencies. */
             RobDepList robDep;
 
@@ -6,6 +6,7 @@
 #include "mem/MAA/SPD.hh"
 #include "mem/MAA/StreamAccess.hh"
 #include "mem/MAA/MAA.hh"
+#include "mem/MAA/MAATrace.hh"
 
 #include "base/addr_range.hh"
 #include "base/logging.hh"
@@ -110,6 +111,26 @@ void MAA::recvTimingReq(PacketPtr pkt) {
     for (int i = 0; i < pkt->getSize(); i++) {
         DPRINTF(MAACpuPort, "%02x %s\n", pkt->getPtr<uint8_t>()[i], pkt->req->getByteEnable()[i] ? "True" : "False");
     }
+    if (traceWriter != nullptr) {
+        // The replay starts from the memory that the first request saw
+        if (!traceWriter->hasRequests()) {
+            std::vector<AddrRange> ranges;
+            for (const auto &store : system->getPhysMem().getBackingStore()) {
+                if (store.inAddrMap) {
+                    ranges.push_back(store.range);
+                }
+            }
+            traceWriter->recordMemory(system->physProxy, ranges);
+        }
+        // The requestor waits on the last instruction word and on ready reads
+        bool blocking = false;
+        if (pkt->cmd == MemCmd::WriteReq && address_range.getType() == AddressRangeType::Type::INSTRUCTION_RANGE) {
+            blocking = (address_range.getOffset() % (num_instructions * sizeof(uint64_t))) / sizeof(uint64_t) == 2;
+        } else if (pkt->cmd == MemCmd::ReadReq && address_range.getType() == AddressRangeType::Type::SPD_READY_RANGE) {
+            blocking = true;
+        }
+        traceWriter->recordRequest(pkt, blocking);
+    }
     switch (pkt->cmd.toInt()) {
     case MemCmd::WriteReq: {
         bool respond_immediately = true;
@@ -281,6 +302,7 @@ void MAA::recvTimingReq(PacketPtr pkt) {
                 Tick old_header_delay = pkt->headerDelay;
                 pkt->headerDelay = pkt->payloadDelay = 0;
                 cpuSidePort.schedTimingResp(pkt, getClockEdge(Cycles(1)) + old_header_delay);
+                recordBlockingResponse(getClockEdge(Cycles(1)) + old_header_delay);
             } else {
                 panic_if(my_outstanding_ready_pkt, "Received multiple ready read packets\n");
                 my_outstanding_ready_pkt = true;
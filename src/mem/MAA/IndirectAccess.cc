@@ -1495,6 +1495,9 @@ bool IndirectAccessUnit::recvData(const Addr addr, uint8_t *dataptr, bool is_blo
 }
 Addr IndirectAccessUnit::translatePacket(Addr vaddr) {
     /**** Address translation ****/
+    if (maa->translateFromTrace(vaddr, my_translated_addr)) {
+        return my_translated_addr;
+    }
     RequestPtr translation_req = std::make_shared<Request>(vaddr,
                                                            block_size,
                                                            flags, maa->requestorId,
@@ -1505,6 +1508,7 @@ Addr IndirectAccessUnit::translatePacket(Addr vaddr) {
     // The above function immediately does the translation and calls the finish function
     assert(my_translation_done);
     my_translation_done = false;
+    maa->recordTranslation(vaddr, my_translated_addr);
     return my_translated_addr;
 }
 void IndirectAccessUnit::finish(const Fault &fault, const RequestPtr &req, ThreadContext *tc, BaseMMU::Mode mode) {
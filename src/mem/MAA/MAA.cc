@@ -6,6 +6,7 @@
 #include "mem/MAA/SPD.hh"
 #include "mem/MAA/StreamAccess.hh"
 #include "mem/MAA/MAA.hh"
+#include "mem/MAA/MAATrace.hh"
 
 #include "base/addr_range.hh"
 #include "base/logging.hh"
@@ -17,6 +18,7 @@
 #include "debug/MAACachePort.hh"
 #include "debug/MAAMemPort.hh"
 #include "debug/MAAController.hh"
+#include "sim/core.hh"
 #include "sim/cur_tick.hh"
 #include <cassert>
 #include <cstdint>
@@ -38,6 +40,7 @@ MAA::MAA(const MAAParams &p)
     : ClockedObject(p),
       cpuSidePort(p.name + ".cpu_side_port", *this, "CpuSidePort"),
       cacheSidePort(p.name + ".cache_side_port", this, "CacheSidePort"),
+      traceWriter(nullptr),
       addrRanges(p.addr_ranges.begin(), p.addr_ranges.end()),
       num_tiles(p.num_tiles),
       num_tile_elements(p.num_tile_elements),
@@ -116,6 +119,10 @@ MAA::MAA(const MAAParams &p)
         std::string portName = csprintf("%s.mem_side_port[%d]", p.name, i);
         memSidePorts.push_back(new MemSidePort(portName, this, "MemSidePort"));
     }
+    if (p.trace_file != "") {
+        traceWriter = new MAATraceWriter(p.trace_file);
+        registerExitCallback([this]() { traceWriter->close(); });
+    }
 }
 
 void MAA::init() {
@@ -127,6 +134,8 @@ void MAA::init() {
 MAA::~MAA() {
     for (auto port : memSidePorts)
         delete port;
+    if (traceWriter != nullptr)
+        delete traceWriter;
 }
 
 Port &MAA::getPort(const std::string &if_name, PortID idx) {
@@ -186,6 +195,30 @@ void MAA::addRamulator(memory::Ramulator2 *_ramulator2) {
                                         this);
     }
 }
+void MAA::addTracedTranslation(Addr vpage, Addr ppage) {
+    assert((vpage & (MAATraceWriter::PageBytes - 1)) == 0);
+    tracedTranslations[vpage] = ppage;
+}
+bool MAA::translateFromTrace(Addr vaddr, Addr &paddr) const {
+    if (tracedTranslations.empty()) {
+        return false;
+    }
+    Addr offset = vaddr & (MAATraceWriter::PageBytes - 1);
+    auto it = tracedTranslations.find(vaddr - offset);
+    panic_if(it == tracedTranslations.end(), "No translation for 0x%lx in the replayed MAA trace\n", vaddr);
+    paddr = it->second + offset;
+    return true;
+}
+void MAA::recordTranslation(Addr vaddr, Addr paddr) {
+    if (traceWriter != nullptr) {
+        traceWriter->recordTranslation(vaddr, paddr);
+    }
+}
+void MAA::recordBlockingResponse(Tick when) {
+    if (traceWriter != nullptr) {
+        traceWriter->recordBlockingResponse(when);
+    }
+}
 // RoBaRaCoCh address mapping taking from the Ramulator2
 int slice_lower_bits(uint64_t &addr, int bits) {
     int lbits = addr & ((1 << bits) - 1);
@@ -401,6 +434,7 @@ void MAA::dispatchInstruction() {
             my_instruction_pkt->makeTimingResponse();
             my_instruction_pkt->headerDelay = my_instruction_pkt->payloadDelay = 0;
             cpuSidePort.schedTimingResp(my_instruction_pkt, getClockEdge(Cycles(1)));
+            recordBlockingResponse(getClockEdge(Cycles(1)));
             scheduleIssueInstructionEvent(1);
             my_outstanding_instruction_pkt = false;
         } else {
@@ -461,6 +495,7 @@ void MAA::setTileReady(int tileID, int wordSize) {
         my_ready_pkt->makeTimingResponse();
         my_instruction_pkt->headerDelay = my_instruction_pkt->payloadDelay = 0;
         cpuSidePort.schedTimingResp(my_ready_pkt, getClockEdge(Cycles(1)));
+        recordBlockingResponse(getClockEdge(Cycles(1)));
         my_outstanding_ready_pkt = false;
     }
     spd->setTileReady(tileID, wordSize);
@@ -7,6 +7,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <unordered_map>
 
 #include "base/trace.hh"
 #include "base/types.hh"
@@ -40,6 +41,7 @@ class Invalidator;
 class ALUUnit;
 class RangeFuserUnit;
 class Instruction;
+class MAATraceWriter;
 
 /**
  * A basic cache interface. Implements some common functions for speed.
@@ -297,6 +299,14 @@ public:
     bool sendPacketCache(uint8_t func_unit_type, int func_unit_id, PacketPtr pkt);
     bool sendSnoopPacketCpu(uint8_t func_unit_type, int func_unit_id, PacketPtr pkt);
 
+    // Trace recording and replay of the CPU-side request stream
+    MAATraceWriter *traceWriter;
+    std::unordered_map<Addr, Addr> tracedTranslations;
+    void addTracedTranslation(Addr vpage, Addr ppage);
+    bool translateFromTrace(Addr vaddr, Addr &paddr) const;
+    void recordTranslation(Addr vaddr, Addr paddr);
+    void recordBlockingResponse(Tick when);
+
 protected:
     /**
      * Performs the access specified by the request.
@@ -50,5 +50,7 @@ class MAA(ClockedObject):
 
     system = Param.System(Parent.any, "System we belong to")
 
+    trace_file = Param.String("", "Record the CPU-side request stream to this file in the output directory, and the memory it starts from to <file>.mem (empty disables recording)")
+
     def addRamulatorInstance(self, simObj):
         self.getCCObject().addRamulator(simObj.getCCObject())
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "mem/MAA/MAATrace.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/MAATrace.hh"
+#include "sim/cur_tick.hh"
+#include <algorithm>
+#include <cstring>
+
+#ifndef TRACING_ON
+#define TRACING_ON 1
+#endif
+
+namespace gem5 {
+
+static const char maa_trace_magic[8] = {'M', 'A', 'A', 'T', 'R', 'A', 'C', 'E'};
+static const uint32_t maa_trace_version = 1;
+static const char maa_memory_magic[8] = {'M', 'A', 'A', 'M', 'E', 'M', 'O', 'R'};
+static const uint32_t maa_memory_version = 1;
+
+MAATraceWriter::MAATraceWriter(const std::string &_filename)
+    : filename(_filename),
+      num_requests(0),
+      last_tick(0),
+      last_blocking_resp_tick(0),
+      outstanding_blocking(0) {
+    stream = simout.create(filename, true, true);
+    fatal_if(stream == nullptr, "Could not create MAA trace %s\n", filename);
+    MAATraceHeader header;
+    memcpy(header.magic, maa_trace_magic, sizeof(header.magic));
+    header.version = maa_trace_version;
+    header.record_size = sizeof(MAATraceRecord);
+    stream->stream()->write((const char *)&header, sizeof(header));
+}
+MAATraceWriter::~MAATraceWriter() {
+    close();
+}
+void MAATraceWriter::write(const MAATraceRecord &record) {
+    assert(stream != nullptr);
+    stream->stream()->write((const char *)&record, sizeof(record));
+}
+void MAATraceWriter::recordRequest(PacketPtr pkt, bool blocking) {
+    MAATraceRecord record;
+    memset(&record, 0, sizeof(record));
+    record.tick = curTick();
+    Tick base = last_tick;
+    if (outstanding_blocking > 0) {
+        record.flags |= MAATraceRecord::Overlapped;
+    } else {
+        base = std::max(base, last_blocking_resp_tick);
+    }
+    record.delay = record.tick > base ? record.tick - base : 0;
+    record.addr = pkt->getAddr();
+    record.size = pkt->getSize();
+    record.cmd = pkt->cmd.toInt();
+    if (pkt->isWrite()) {
+        panic_if(pkt->getSize() > sizeof(record.data), "MAA trace cannot record a %d-byte write\n", pkt->getSize());
+        memcpy(&record.data, pkt->getConstPtr<uint8_t>(), pkt->getSize());
+    }
+    record.pc = pkt->req->hasPC() ? pkt->req->getPC() : 0;
+    record.context_id = pkt->req->hasContextId() ? pkt->req->contextId() : 0;
+    if (blocking) {
+        record.flags |= MAATraceRecord::Blocking;
+        outstanding_blocking++;
+    }
+    DPRINTF(MAATrace, "%s: %s delay: %lu flags: %x\n", __func__, pkt->print(), record.delay, record.flags);
+    last_tick = record.tick;
+    num_requests++;
+    write(record);
+}
+void MAATraceWriter::recordBlockingResponse(Tick when) {
+    assert(outstanding_blocking > 0);
+    outstanding_blocking--;
+    last_blocking_resp_tick = std::max(last_blocking_resp_tick, when);
+}
+void MAATraceWriter::recordTranslation(Addr vaddr, Addr paddr) {
+    Addr vpage = vaddr & ~(PageBytes - 1);
+    if (translated_pages.insert(vpage).second == false) {
+        return;
+    }
+    MAATraceRecord record;
+    memset(&record, 0, sizeof(record));
+    record.tick = curTick();
+    record.addr = vpage;
+    record.data = paddr & ~(PageBytes - 1);
+    record.flags = MAATraceRecord::Translation;
+    DPRINTF(MAATrace, "%s: page 0x%lx -> 0x%lx\n", __func__, record.addr, record.data);
+    write(record);
+}
+void MAATraceWriter::recordMemory(PortProxy &proxy, const std::vector<AddrRange> &ranges) {
+    std::string image_name = memoryImageName(filename);
+    inform("Writing the MAA trace memory image %s\n", image_name);
+    OutputStream *image = simout.create(image_name, true, true);
+    fatal_if(image == nullptr, "Could not create MAA trace memory image %s\n", image_name);
+    MAAMemoryImageHeader header;
+    memcpy(header.magic, maa_memory_magic, sizeof(header.magic));
+    header.version = maa_memory_version;
+    header.page_size = PageBytes;
+    image->stream()->write((const char *)&header, sizeof(header));
+
+    std::vector<uint8_t> page(PageBytes);
+    uint64_t num_pages = 0;
+    for (const auto &range : ranges) {
+        for (Addr addr = range.start(); addr < range.end(); addr += PageBytes) {
+            uint64_t size = std::min<uint64_t>(PageBytes, range.end() - addr);
+            std::fill(page.begin(), page.end(), 0);
+            proxy.readBlob(addr, page.data(), size);
+            if (std::all_of(page.begin(), page.end(), [](uint8_t b) { return b == 0; })) {
+                continue;
+            }
+            uint64_t paddr = addr;
+            image->stream()->write((const char *)&paddr, sizeof(paddr));
+            image->stream()->write((const char *)page.data(), PageBytes);
+            num_pages++;
+        }
+    }
+    fatal_if(!image->stream()->good(), "Could not write MAA trace memory image %s\n", image_name);
+    DPRINTF(MAATrace, "%s: %lu non-zero pages\n", __func__, num_pages);
+    simout.close(image);
+}
+void MAATraceWriter::close() {
+    if (stream != nullptr) {
+        simout.close(stream);
+        stream = nullptr;
+    }
+}
+
+MAATraceReader::MAATraceReader(const std::string &_filename)
+    : filename(_filename) {
+    reset();
+}
+void MAATraceReader::reset() {
+    stream.close();
+    stream.clear();
+    stream.open(filename, std::ios::in | std::ios::binary);
+    fatal_if(!stream.good(), "Could not open MAA trace %s\n", filename);
+    MAATraceHeader header;
+    stream.read((char *)&header, sizeof(header));
+    fatal_if(!stream.good() || memcmp(header.magic, maa_trace_magic, sizeof(header.magic)) != 0,
+             "%s is not an MAA trace\n", filename);
+    fatal_if(header.version != maa_trace_version || header.record_size != sizeof(MAATraceRecord),
+             "MAA trace %s has version %d and %d-byte records, expected version %d and %d-byte records\n",
+             filename, header.version, header.record_size, maa_trace_version, sizeof(MAATraceRecord));
+}
+void MAATraceReader::loadMemory(const std::string &image_file, PortProxy &proxy) {
+    std::ifstream image(image_file, std::ios::in | std::ios::binary);
+    fatal_if(!image.good(),
+             "Could not open MAA trace memory image %s. The MAA reads data such as indices from memory, "
+             "so a trace can only be replayed together with the image recorded with it\n",
+             image_file);
+    MAAMemoryImageHeader header;
+    image.read((char *)&header, sizeof(header));
+    fatal_if(!image.good() || memcmp(header.magic, maa_memory_magic, sizeof(header.magic)) != 0,
+             "%s is not an MAA trace memory image\n", image_file);
+    fatal_if(header.version != maa_memory_version || header.page_size != MAATraceWriter::PageBytes,
+             "MAA trace memory image %s has version %d and %d-byte pages, expected version %d and %d-byte pages\n",
+             image_file, header.version, header.page_size, maa_memory_version, MAATraceWriter::PageBytes);
+
+    std::vector<uint8_t> page(header.page_size);
+    uint64_t paddr;
+    while (image.read((char *)&paddr, sizeof(paddr))) {
+        image.read((char *)page.data(), page.size());
+        panic_if(!image.good(), "Truncated page in MAA trace memory image %s\n", image_file);
+        proxy.writeBlob(paddr, page.data(), page.size());
+    }
+}
+bool MAATraceReader::read(MAATraceRecord &record) {
+    stream.read((char *)&record, sizeof(record));
+    if (stream.gcount() == 0) {
+        return false;
+    }
+    panic_if(stream.gcount() != sizeof(record), "Truncated record in MAA trace %s\n", filename);
+    return true;
+}
+
+} // namespace gem5
@@ -0,0 +1,129 @@
+#ifndef __MEM_MAA_MAATRACE_HH__
+#define __MEM_MAA_MAATRACE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/types.hh"
+#include "mem/packet.hh"
+#include "mem/port_proxy.hh"
+
+namespace gem5 {
+
+/**
+ * One entry of an MAA trace. A trace is a small header followed by a flat
+ * array of these fixed-size records, in the order the MAA received them.
+ * Request records carry the CPU-side packet (command, address, size and,
+ * for scalar/instruction writes, the data). Translation records carry one
+ * virtual-to-physical page mapping that the MAA used while executing.
+ */
+struct MAATraceRecord {
+    enum Flags : uint8_t {
+        // The requestor waited for the response of this request before
+        // issuing anything else (instruction word 2, SPD ready reads)
+        Blocking = 0x1,
+        // Issued while an earlier blocking request was still outstanding
+        Overlapped = 0x2,
+        // Not a request: addr is a virtual page and data its physical page
+        Translation = 0x4
+    };
+
+    // Tick at which the MAA received the request
+    uint64_t tick;
+    // Think time since the previous request or the last blocking response
+    uint64_t delay;
+    uint64_t addr;
+    uint64_t data;
+    uint64_t pc;
+    uint16_t size;
+    uint8_t cmd;
+    uint8_t flags;
+    int32_t context_id;
+
+    bool isTranslation() const { return flags & Translation; }
+    bool isBlocking() const { return flags & Blocking; }
+    bool isOverlapped() const { return flags & Overlapped; }
+};
+static_assert(sizeof(MAATraceRecord) == 48, "MAA trace records must stay 48 bytes");
+
+struct MAATraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+};
+
+/**
+ * The memory image stored next to a trace, in <trace>.mem. It holds the
+ * physical memory as it was when the first request was recorded, as a
+ * header followed by the physical address and contents of every page
+ * that was not all zero. The MAA loads data such as indices from memory,
+ * so a replay has to start from this image.
+ *
+ * The image is only taken once. Memory written by the CPUs after the
+ * first MAA request, e.g. indices computed between two MAA phases, is
+ * not in the trace, and the MAA reads the old data when replaying. Such
+ * a replay diverges from the recorded run without further notice, so
+ * only traces whose MAA inputs are set up before the first MAA request
+ * replay faithfully.
+ */
+struct MAAMemoryImageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t page_size;
+};
+
+class MAATraceWriter {
+public:
+    // Granularity of the recorded address translations
+    static const Addr PageBytes = 4096;
+
+    MAATraceWriter(const std::string &filename);
+    ~MAATraceWriter();
+
+    void recordRequest(PacketPtr pkt, bool blocking);
+    void recordBlockingResponse(Tick when);
+    void recordTranslation(Addr vaddr, Addr paddr);
+    // Write the memory image of the trace. Memory is read through proxy,
+    // so data that is only dirty in the caches is included.
+    void recordMemory(PortProxy &proxy, const std::vector<AddrRange> &ranges);
+    bool hasRequests() const { return num_requests > 0; }
+    void close();
+
+    // Name of the memory image that belongs to a trace
+    static std::string memoryImageName(const std::string &trace_file) { return trace_file + ".mem"; }
+
+protected:
+    void write(const MAATraceRecord &record);
+
+    std::string filename;
+    uint64_t num_requests;
+    OutputStream *stream;
+    Tick last_tick;
+    Tick last_blocking_resp_tick;
+    int outstanding_blocking;
+    std::unordered_set<Addr> translated_pages;
+};
+
+class MAATraceReader {
+public:
+    MAATraceReader(const std::string &filename);
+
+    bool read(MAATraceRecord &record);
+    void reset();
+
+    // Write the pages of a memory image recorded with the trace through proxy
+    static void loadMemory(const std::string &image_file, PortProxy &proxy);
+
+protected:
+    std::string filename;
+    std::ifstream stream;
+};
+
+} // namespace gem5
+
+#endif // __MEM_MAA_MAATRACE_HH__
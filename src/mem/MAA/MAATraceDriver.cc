@@ -0,0 +1,190 @@
+#include "mem/MAA/MAATraceDriver.hh"
+#include "mem/MAA/MAA.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/MAATrace.hh"
+#include "mem/request.hh"
+#include "params/MAATraceDriver.hh"
+#include "sim/cur_tick.hh"
+#include "sim/sim_exit.hh"
+#include "sim/system.hh"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#ifndef TRACING_ON
+#define TRACING_ON 1
+#endif
+
+namespace gem5 {
+
+MAATraceDriver::MAATraceDriver(const MAATraceDriverParams &p)
+    : ClockedObject(p),
+      port(p.name + ".port", *this),
+      maa(p.maa),
+      system(p.system),
+      reader(p.trace_file),
+      memory_image(p.memory_image != "" ? p.memory_image : MAATraceWriter::memoryImageName(p.trace_file)),
+      requestorId(p.system->getRequestorId(this)),
+      exit_when_done(p.exit_when_done),
+      has_next_record(false),
+      retry_pkt(nullptr),
+      outstanding_pkts(0),
+      last_issue_tick(0),
+      last_blocking_resp_tick(0),
+      issueEvent([this] { issueRequest(); }, name()),
+      stats(this) {
+}
+
+void MAATraceDriver::init() {
+    if (!port.isConnected())
+        fatal("Port of %s is not connected\n", name());
+    // Install all recorded translations up front, the MAA may need them
+    // long before their record shows up in the request stream
+    MAATraceRecord record;
+    while (reader.read(record)) {
+        if (record.isTranslation()) {
+            maa->addTracedTranslation(record.addr, record.data);
+            stats.numTranslations++;
+        }
+    }
+    reader.reset();
+}
+void MAATraceDriver::initState() {
+    // Not needed when restoring a checkpoint, which holds the memory
+    MAATraceReader::loadMemory(memory_image, system->physProxy);
+    warn("Replaying MAA trace from memory image %s, taken at the first MAA request. "
+         "Data the CPUs wrote to memory after that is not replayed.\n",
+         memory_image);
+}
+void MAATraceDriver::startup() {
+    last_issue_tick = curTick();
+    last_blocking_resp_tick = curTick();
+    fetchNextRecord();
+}
+Port &MAATraceDriver::getPort(const std::string &if_name, PortID idx) {
+    if (if_name == "port") {
+        return port;
+    } else {
+        return ClockedObject::getPort(if_name, idx);
+    }
+}
+PacketPtr MAATraceDriver::createPacket(const MAATraceRecord &record) {
+    MemCmd cmd((MemCmd::Command)record.cmd);
+    Request::Flags flags = 0;
+    if (cmd == MemCmd::ReadReq || cmd == MemCmd::WriteReq) {
+        // Scalar, instruction, size and ready accesses are MMIO
+        flags = Request::UNCACHEABLE | Request::STRICT_ORDER;
+    }
+    RequestPtr req = std::make_shared<Request>(record.addr,
+                                               record.size,
+                                               flags,
+                                               requestorId,
+                                               record.pc,
+                                               record.context_id);
+    req->setByteEnable(std::vector<bool>(record.size, true));
+    PacketPtr pkt = new Packet(req, cmd);
+    pkt->allocate();
+    if (pkt->isWrite()) {
+        assert(record.size <= sizeof(record.data));
+        pkt->setData((const uint8_t *)&record.data);
+    }
+    return pkt;
+}
+void MAATraceDriver::fetchNextRecord() {
+    while (reader.read(next_record)) {
+        if (next_record.isTranslation() == false) {
+            has_next_record = true;
+            scheduleNextIssue();
+            return;
+        }
+    }
+    has_next_record = false;
+    checkDone();
+}
+void MAATraceDriver::scheduleNextIssue() {
+    if (!has_next_record || retry_pkt != nullptr || issueEvent.scheduled()) {
+        return;
+    }
+    Tick base = last_issue_tick;
+    if (next_record.isOverlapped() == false) {
+        if (blocking_pkts.empty() == false) {
+            DPRINTF(MAATrace, "%s: waiting for %d blocking responses\n", __func__, blocking_pkts.size());
+            return;
+        }
+        base = std::max(base, last_blocking_resp_tick);
+    }
+    schedule(issueEvent, std::max(curTick(), base + next_record.delay));
+}
+void MAATraceDriver::issueRequest() {
+    assert(has_next_record);
+    assert(retry_pkt == nullptr);
+    PacketPtr pkt = createPacket(next_record);
+    DPRINTF(MAATrace, "%s: sending %s\n", __func__, pkt->print());
+    if (port.sendTimingReq(pkt)) {
+        requestSent(pkt);
+    } else {
+        DPRINTF(MAATrace, "%s: send failed, waiting for retry...\n", __func__);
+        retry_pkt = pkt;
+    }
+}
+void MAATraceDriver::requestSent(PacketPtr pkt) {
+    last_issue_tick = curTick();
+    outstanding_pkts++;
+    stats.numRequests++;
+    if (next_record.isBlocking()) {
+        blocking_pkts[pkt] = curTick();
+        stats.numBlockingRequests++;
+    }
+    fetchNextRecord();
+}
+void MAATraceDriver::recvReqRetry() {
+    assert(retry_pkt != nullptr);
+    PacketPtr pkt = retry_pkt;
+    if (port.sendTimingReq(pkt)) {
+        retry_pkt = nullptr;
+        requestSent(pkt);
+    }
+}
+bool MAATraceDriver::recvTimingResp(PacketPtr pkt) {
+    DPRINTF(MAATrace, "%s: received %s\n", __func__, pkt->print());
+    assert(outstanding_pkts > 0);
+    outstanding_pkts--;
+    auto it = blocking_pkts.find(pkt);
+    if (it != blocking_pkts.end()) {
+        stats.blockedTicks += curTick() - it->second;
+        last_blocking_resp_tick = curTick();
+        blocking_pkts.erase(it);
+    }
+    delete pkt;
+    scheduleNextIssue();
+    checkDone();
+    return true;
+}
+void MAATraceDriver::checkDone() {
+    if (has_next_record || outstanding_pkts != 0 || retry_pkt != nullptr) {
+        return;
+    }
+    DPRINTF(MAATrace, "%s: replayed %d requests\n", __func__, (uint64_t)stats.numRequests.value());
+    if (exit_when_done) {
+        exitSimLoop(name() + " finished replaying the MAA trace.\n");
+    }
+}
+
+bool MAATraceDriver::DriverPort::recvTimingResp(PacketPtr pkt) {
+    return driver.recvTimingResp(pkt);
+}
+void MAATraceDriver::DriverPort::recvReqRetry() {
+    driver.recvReqRetry();
+}
+
+MAATraceDriver::MAATraceDriverStats::MAATraceDriverStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(numRequests, statistics::units::Count::get(), "number of replayed requests"),
+      ADD_STAT(numBlockingRequests, statistics::units::Count::get(), "number of replayed requests the driver waited on"),
+      ADD_STAT(numTranslations, statistics::units::Count::get(), "number of recorded page translations installed in the MAA"),
+      ADD_STAT(blockedTicks, statistics::units::Tick::get(), "ticks spent waiting on blocking requests") {
+}
+
+} // namespace gem5
@@ -0,0 +1,98 @@
+#ifndef __MEM_MAA_MAATRACEDRIVER_HH__
+#define __MEM_MAA_MAATRACEDRIVER_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/MAA/MAATrace.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "sim/clocked_object.hh"
+
+namespace gem5 {
+
+struct MAATraceDriverParams;
+class MAA;
+class System;
+
+/**
+ * Replays an MAA trace recorded by MAA::trace_file against an MAA without
+ * a CPU model. Requests are issued in the recorded order with the recorded
+ * think times; requests that the original requestor waited on (instruction
+ * dispatch and SPD ready reads) stall the replay until they are answered,
+ * so the replayed timing follows the MAA and memory configuration under
+ * test rather than the recorded one. The recorded address translations are
+ * installed in the MAA before the replay starts, and memory is initialized
+ * from the image recorded with the trace, as the MAA reads data such as
+ * indices from memory.
+ */
+class MAATraceDriver : public ClockedObject {
+    class DriverPort : public RequestPort {
+    public:
+        DriverPort(const std::string &_name, MAATraceDriver &_driver)
+            : RequestPort(_name), driver(_driver) {}
+
+    protected:
+        bool recvTimingResp(PacketPtr pkt) override;
+        void recvReqRetry() override;
+        // The driver caches nothing, so invalidations are always satisfied
+        void recvTimingSnoopReq(PacketPtr pkt) override {}
+        void recvRangeChange() override {}
+
+        MAATraceDriver &driver;
+    };
+
+public:
+    MAATraceDriver(const MAATraceDriverParams &p);
+
+    void init() override;
+    void initState() override;
+    void startup() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx = InvalidPortID) override;
+
+protected:
+    PacketPtr createPacket(const MAATraceRecord &record);
+    void fetchNextRecord();
+    void scheduleNextIssue();
+    void issueRequest();
+    void requestSent(PacketPtr pkt);
+    bool recvTimingResp(PacketPtr pkt);
+    void recvReqRetry();
+    void checkDone();
+
+    DriverPort port;
+    MAA *maa;
+    System *system;
+    MAATraceReader reader;
+    std::string memory_image;
+    RequestorID requestorId;
+    bool exit_when_done;
+
+    MAATraceRecord next_record;
+    bool has_next_record;
+    PacketPtr retry_pkt;
+    std::unordered_map<PacketPtr, Tick> blocking_pkts;
+    int outstanding_pkts;
+    Tick last_issue_tick;
+    Tick last_blocking_resp_tick;
+    EventFunctionWrapper issueEvent;
+
+    struct MAATraceDriverStats : public statistics::Group {
+        MAATraceDriverStats(statistics::Group *parent);
+
+        statistics::Scalar numRequests;
+        statistics::Scalar numBlockingRequests;
+        statistics::Scalar numTranslations;
+        statistics::Scalar blockedTicks;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __MEM_MAA_MAATRACEDRIVER_HH__
@@ -0,0 +1,17 @@
+from m5.objects.ClockedObject import ClockedObject
+from m5.params import *
+from m5.proxy import *
+
+class MAATraceDriver(ClockedObject):
+    type = "MAATraceDriver"
+    cxx_header = "mem/MAA/MAATraceDriver.hh"
+    cxx_class = "gem5::MAATraceDriver"
+
+    trace_file = Param.String("MAA trace recorded with MAA.trace_file")
+    memory_image = Param.String("", "Memory image recorded with the trace (<trace_file>.mem if empty)")
+    maa = Param.MAA("MAA the trace is replayed against")
+    exit_when_done = Param.Bool(True, "Exit the simulation once the whole trace is replayed")
+
+    port = RequestPort("Port connected to the cpu_side port of the MAA")
+
+    system = Param.System(Parent.any, "System we belong to")
@@ -540,6 +540,9 @@ bool StreamAccessUnit::recvData(const Addr addr, uint8_t *dataptr) {
 }
 Addr StreamAccessUnit::translatePacket(Addr vaddr) {
     /**** Address translation ****/
+    if (maa->translateFromTrace(vaddr, my_translated_addr)) {
+        return my_translated_addr;
+    }
     RequestPtr translation_req = std::make_shared<Request>(vaddr,
                                                            block_size,
                                                            flags,
@@ -551,6 +554,7 @@ Addr StreamAccessUnit::translatePacket(Addr vaddr) {
     // The above function immediately does the translation and calls the finish function
     assert(my_translation_done);
     my_translation_done = false;
+    maa->recordTranslation(vaddr, my_translated_addr);
     return my_translated_addr;
 }
 void StreamAccessUnit::finish(const Fault &fault,
@@ -24,6 +24,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from m5.params import *
+from m5.proxy import *
 from m5.SimObject import SimObject
 
 
@@ -39,8 +40,14 @@ class ThreadBridge(SimObject):
     the issue. The receiver side is expected to use the same EventQueue that
     the ThreadBridge is using.
 
-    Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    Atomic and functional accesses are carried out directly. Timing packets
+    are delayed by `delay`, and exchanged between the threads at quantum
+    boundaries, so that parallel runs are reproducible. The delay is the
+    lookahead between the threads and has to be at least the simulation
+    quantum. The side of in_port runs on the event queue in_eventq_index.
+    Timing snoops cannot cross threads, so the two sides must not share
+    memory that is cached on the in_port side. Such a snoop is a fatal
+    error, and configurations should avoid it up front.
 
     Example:
 
@@ -58,3 +65,10 @@ class ThreadBridge(SimObject):
 
     in_port = ResponsePort("Incoming port")
     out_port = RequestPort("Outgoing port")
+
+    delay = Param.Latency(
+        "0ns", "Latency of timing packets, at least the simulation quantum"
+    )
+    in_eventq_index = Param.UInt32(
+        Parent.eventq_index, "Event queue of the in_port side"
+    )
@@ -62,6 +62,7 @@ AbstractMemory::AbstractMemory(const Params &p) :
              (MemBackdoor::Flags)(p.writeable ?
                  MemBackdoor::Readable | MemBackdoor::Writeable :
                  MemBackdoor::Readable)),
+    dirtyPages(nullptr), backdoorUntracked(false),
     confTableReported(p.conf_table_reported), inAddrMap(p.in_addr_map),
     kvmMap(p.kvm_map), writeable(p.writeable), _system(NULL),
     stats(*this)
@@ -107,7 +108,7 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
 {
     // If there was an existing backdoor, let everybody know it's going away.
     if (backdoor.ptr())
-        backdoor.invalidate();
+        invalidateBackdoor();
 
     // The back door can't handle interleaved memory.
     backdoor.ptr(range.interleaved() ? nullptr : pmem_addr);
@@ -115,6 +116,27 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     pmemAddr = pmem_addr;
 }
 
+void
+AbstractMemory::setDirtyPageMap(DirtyPageMap *dirty_pages)
+{
+    // Writes through a backdoor handed out before cannot be tracked
+    if (backdoor.ptr())
+        invalidateBackdoor();
+
+    dirtyPages = dirty_pages;
+}
+
+void
+AbstractMemory::invalidateBackdoor()
+{
+    backdoor.invalidate();
+
+    if (backdoorUntracked) {
+        dirtyPages->removeUntracked(pmemAddr);
+        backdoorUntracked = false;
+    }
+}
+
 AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
     : statistics::Group(&_mem), mem(_mem),
     ADD_STAT(bytesRead, statistics::units::Byte::get(),
@@ -278,7 +300,7 @@ AbstractMemory::trackLoadLocked(PacketPtr pkt)
     DPRINTF(LLSC, "Adding lock record: context %d addr %#x\n",
             req->contextId(), paddr);
     lockedAddrList.push_front(LockedAddr(req));
-    backdoor.invalidate();
+    invalidateBackdoor();
 }
 
 
@@ -400,6 +422,7 @@ AbstractMemory::access(PacketPtr pkt)
             if (pmemAddr) {
                 pkt->setData(host_addr);
                 (*(pkt->getAtomicOp()))(host_addr);
+                markDirty(host_addr, pkt->getSize());
             }
         } else {
             std::vector<uint8_t> overwrite_val(pkt->getSize());
@@ -428,8 +451,10 @@ AbstractMemory::access(PacketPtr pkt)
                     panic("Invalid size for conditional read/write\n");
             }
 
-            if (overwrite_mem)
+            if (overwrite_mem) {
                 std::memcpy(host_addr, &overwrite_val[0], pkt->getSize());
+                markDirty(host_addr, pkt->getSize());
+            }
 
             assert(!pkt->req->isInstFetch());
             TRACE_PACKET("Read/Write");
@@ -461,6 +486,7 @@ AbstractMemory::access(PacketPtr pkt)
         if (writeOK(pkt)) {
             if (pmemAddr) {
                 pkt->writeData(host_addr);
+                markDirty(host_addr, pkt->getSize());
                 DPRINTF(MemoryAccess, "%s write due to %s\n",
                         __func__, pkt->print());
             }
@@ -494,6 +520,7 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
     } else if (pkt->isWrite()) {
         if (pmemAddr) {
             pkt->writeData(host_addr);
+            markDirty(host_addr, pkt->getSize());
         }
         TRACE_PACKET("Write");
         pkt->makeResponse();
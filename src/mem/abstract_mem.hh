@@ -47,6 +47,7 @@
 #define __MEM_ABSTRACT_MEMORY_HH__
 
 #include "mem/backdoor.hh"
+#include "mem/dirty_page_map.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/clocked_object.hh"
@@ -120,6 +121,14 @@ class AbstractMemory : public ClockedObject
     // Backdoor to access this memory.
     MemBackdoor backdoor;
 
+    // Pages of the backing store written since the last checkpoint,
+    // null if they are not tracked
+    DirtyPageMap *dirtyPages;
+
+    // Writes through the backdoor cannot be tracked, so the memory is
+    // untracked while it is handed out
+    bool backdoorUntracked;
+
     // Enable specific memories to be reported to the configuration table
     const bool confTableReported;
 
@@ -134,6 +143,17 @@ class AbstractMemory : public ClockedObject
 
     std::list<LockedAddr> lockedAddrList;
 
+    // Record a write to the backing store for delta checkpoints
+    void
+    markDirty(const uint8_t *host_addr, uint64_t size) const
+    {
+        if (dirtyPages)
+            dirtyPages->mark(host_addr, size);
+    }
+
+    // Let the holders of the backdoor know it is going away
+    void invalidateBackdoor();
+
     // helper function for checkLockedAddrs(): we really want to
     // inline a quick check for an empty locked addr list (hopefully
     // the common case), and do the full list search (if necessary) in
@@ -241,11 +261,34 @@ class AbstractMemory : public ClockedObject
      */
     void setBackingStore(uint8_t* pmem_addr);
 
+    /**
+     * Track the pages of the backing store written by this memory.
+     *
+     * @param dirty_pages Dirty page map of the backing store
+     */
+    void setDirtyPageMap(DirtyPageMap *dirty_pages);
+
+    /**
+     * Hand out the back door to this memory, if it has one.
+     *
+     * @param bd_ptr Set to the back door
+     * @param write Whether the requestor may write through it, which
+     *              stops writes from being tracked in the dirty page map.
+     *              Requestors which write through a back door requested
+     *              for reading mark the pages with
+     *              PhysicalMemory::markDirty() instead.
+     */
     void
-    getBackdoor(MemBackdoorPtr &bd_ptr)
+    getBackdoor(MemBackdoorPtr &bd_ptr, bool write=true)
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
+        if (lockedAddrList.empty() && backdoor.ptr()) {
+            if (write && dirtyPages && !backdoorUntracked &&
+                    backdoor.writeable()) {
+                dirtyPages->addUntracked(pmemAddr, range.size());
+                backdoorUntracked = true;
+            }
             bd_ptr = &backdoor;
+        }
     }
 
     /**
@@ -263,7 +306,7 @@ class AbstractMemory : public ClockedObject
     void
     addLockedAddr(LockedAddr addr)
     {
-        backdoor.invalidate();
+        invalidateBackdoor();
         lockedAddrList.push_back(addr);
     }
 
@@ -177,6 +177,17 @@ class BaseCache(ClockedObject):
     # data cache.
     write_allocator = Param.WriteAllocator(NULL, "Write allocator")
 
+    # Functionally warm this cache from the accesses that bypass it
+    # while the system is in atomic_noncaching mode, e.g. when fast
+    # forwarding with an atomic CPU. Only the tags, the replacement
+    # state and the prefetcher are updated; the data of the cached
+    # blocks is reloaded from memory once the cache leaves the
+    # bypass mode. Mostly exclusive caches are only warmed by fills,
+    # as the victims of the caches above them stay there.
+    functional_warming = Param.Bool(
+        False, "Warm the cache while it is bypassed"
+    )
+
     stats_pc_list = VectorParam.Addr([], "Monitor PC list in stats")
 
 class Cache(BaseCache):
@@ -108,6 +108,9 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       isReadOnly(p.is_read_only),
       replaceExpansions(p.replace_expansions),
       moveContractions(p.move_contractions),
+      functionalWarming(p.functional_warming),
+      warmDataStale(false),
+      warmPrefetchData(blk_size),
       blocked(0),
       order(0),
       noTargetMSHR(nullptr),
@@ -1703,6 +1706,134 @@ void BaseCache::invalidateBlock(CacheBlk *blk) {
     }
 }
 
+void BaseCache::warmAccess(PacketPtr pkt) {
+    // An access that hit further upstream leaves this cache alone
+    if (pkt->isWarmHit() || !(pkt->isRead() || pkt->isWrite()) ||
+        pkt->req->isCacheMaintenance() || isUncacheablePkt(pkt)) {
+        return;
+    }
+
+    Cycles lat;
+    CacheBlk *blk = tags->accessBlock(pkt, lat);
+    fatal_if(blk && blk->isSet(CacheBlk::DirtyBit),
+             "%s has dirty blocks, they must be written back before "
+             "functional warming\n", name());
+
+    DPRINTF(CacheVerbose, "%s: %s %s\n", __func__, pkt->print(),
+            blk ? "hit" : "miss");
+
+    // Train the prefetcher before the prefetched state of the block
+    // is consumed
+    warmPrefetchAddrs.clear();
+    if (prefetcher) {
+        prefetcher->warmNotify(CacheAccessProbeArg(pkt, accessor), !blk,
+                               warmPrefetchAddrs);
+    }
+
+    bool allocated_above = pkt->isWarmAllocated();
+    if (blk) {
+        stats.warmHits++;
+        pkt->setWarmHit();
+        if (prefetcher && blk->wasPrefetched()) {
+            prefetcher->prefetchHit(CacheAccessProbeArg(pkt, accessor),
+                                    false);
+            blk->clearPrefetched();
+        }
+        // A mostly exclusive cache hands the block to the cache above
+        if (clusivity == enums::mostly_excl && allocated_above) {
+            invalidateBlock(blk);
+        }
+    } else {
+        stats.warmMisses++;
+        if (clusivity == enums::mostly_incl || !allocated_above) {
+            if (warmAllocate(pkt)) {
+                pkt->setWarmAllocated();
+            }
+        }
+    }
+
+    for (Addr pf_addr : warmPrefetchAddrs) {
+        warmPrefetch(pf_addr, pkt);
+    }
+}
+
+CacheBlk *
+BaseCache::warmAllocate(const PacketPtr pkt) {
+    std::vector<CacheBlk *> evict_blks;
+    CacheBlk *victim = tags->findVictim(pkt->getAddr(), pkt->isSecure(),
+                                        blkSize * 8, evict_blks);
+    if (!victim)
+        return nullptr;
+
+    for (const auto &blk : evict_blks) {
+        if (blk->isValid()) {
+            fatal_if(blk->isSet(CacheBlk::DirtyBit),
+                     "%s has dirty blocks, they must be written back "
+                     "before functional warming\n", name());
+            (*stats.replacements[MAX_CMD_REGIONS])++;
+            if (blk->getRegion() != -1)
+                (*stats.replacements[blk->getRegion()])++;
+            invalidateBlock(blk);
+        }
+    }
+
+    tags->insertBlock(pkt, victim);
+    victim->setCoherenceBits(CacheBlk::ReadableBit);
+    warmDataStale = true;
+
+    return victim;
+}
+
+void BaseCache::warmPrefetch(Addr addr, const PacketPtr pkt) {
+    if (tags->findBlock(addr, pkt->isSecure()) || !system->isMemAddr(addr) ||
+        inExclRange(addr)) {
+        return;
+    }
+
+    RequestPtr req = std::make_shared<Request>(
+        addr, blkSize, 0, prefetcher->getRequestorId());
+    req->setRegion(pkt->req->getRegion());
+    if (pkt->isSecure()) {
+        req->setFlags(Request::SECURE);
+    }
+    Packet pf_pkt(req, MemCmd::HardPFReq);
+
+    CacheBlk *blk = warmAllocate(&pf_pkt);
+    if (!blk)
+        return;
+    blk->setPrefetched();
+    blk->setPrefetchedAllocate();
+    stats.warmPrefetches++;
+
+    // Let the caches below see the prefetch as they would see its fill
+    pf_pkt.setWarmAllocated();
+    pf_pkt.dataStatic(warmPrefetchData.data());
+    memSidePort.sendAtomic(&pf_pkt);
+}
+
+void BaseCache::refreshWarmedBlocks() {
+    tags->forEachBlk([this](CacheBlk &blk) {
+        if (!blk.isValid())
+            return;
+        assert(!blk.isSet(CacheBlk::DirtyBit));
+
+        RequestPtr request = std::make_shared<Request>(
+            regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
+        if (blk.isSecure()) {
+            request->setFlags(Request::SECURE);
+        }
+
+        Packet packet(request, MemCmd::ReadReq);
+        packet.dataStatic(blk.data);
+        packet.setWarmRefresh();
+
+        memSidePort.sendFunctional(&packet);
+
+        blk.clearCoherenceBits(CacheBlk::WritableBit);
+    });
+    warmDataStale = false;
+}
+
 void BaseCache::evictBlock(CacheBlk *blk, PacketList &writebacks) {
     PacketPtr pkt = evictBlock(blk);
     if (pkt) {
@@ -1811,9 +1942,20 @@ void BaseCache::memWriteback() {
 }
 
 void BaseCache::memInvalidate() {
+    if (functionalWarming) {
+        // Keep the blocks warm, their data is reloaded on resume
+        warmDataStale = true;
+        return;
+    }
     tags->forEachBlk([this](CacheBlk &blk) { invalidateVisitor(blk); });
 }
 
+void BaseCache::drainResume() {
+    if (warmDataStale && !system->bypassCaches()) {
+        refreshWarmedBlocks();
+    }
+}
+
 bool BaseCache::isDirty() const {
     return tags->anyBlk([](CacheBlk &blk) { return blk.isSet(CacheBlk::DirtyBit); });
 }
@@ -2165,6 +2307,12 @@ void BaseCache::CacheCmdStats::regStatsFromParent() {
 
 BaseCache::CacheStats::CacheStats(BaseCache &c)
     : statistics::Group(&c), cache(c),
+      ADD_STAT(warmHits, statistics::units::Count::get(),
+               "number of functional warming hits"),
+      ADD_STAT(warmMisses, statistics::units::Count::get(),
+               "number of functional warming misses"),
+      ADD_STAT(warmPrefetches, statistics::units::Count::get(),
+               "number of blocks prefetched while functionally warming"),
       cmd(MemCmd::NUM_MEM_CMDS),
       cmdRegions(MAX_CMD_REGIONS) {
     for (int idx = 0; idx < MAX_CMD_REGIONS + 1; ++idx) {
@@ -2593,7 +2741,10 @@ bool BaseCache::CpuSidePort::recvTimingReq(PacketPtr pkt) {
 
 Tick BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt) {
     if (cache.system->bypassCaches()) {
-        // Forward the request if the system is in cache bypass mode.
+        // Forward the request if the system is in cache bypass mode,
+        // warming the cache on the way if asked to.
+        if (cache.functionalWarming)
+            cache.warmAccess(pkt);
         return cache.memSidePort.sendAtomic(pkt);
     } else {
         return cache.recvAtomic(pkt);
@@ -49,6 +49,7 @@
 #include <cassert>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/compiler.hh"
@@ -804,6 +805,42 @@ protected:
      */
     void invalidateBlock(CacheBlk *blk);
 
+    /**
+     * Functionally warm the cache with an access that bypasses it. The
+     * tags, the replacement state and the prefetcher are updated as a
+     * demand access would, but no data is moved, no MSHR is allocated
+     * and no timing is modelled. Blocks are allocated readable only,
+     * and their data is reloaded once the bypass mode is left.
+     *
+     * @param pkt The request on its way to memory.
+     */
+    void warmAccess(PacketPtr pkt);
+
+    /**
+     * Allocate a block for a functional warming access, dropping the
+     * victims without writing them back.
+     *
+     * @param pkt Packet holding the address of the block.
+     * @return The allocated block, nullptr if there is no victim.
+     */
+    CacheBlk *warmAllocate(const PacketPtr pkt);
+
+    /**
+     * Install a block the prefetcher asked for during functional
+     * warming and pass the prefetch on to the caches below.
+     *
+     * @param addr Block address of the prefetch.
+     * @param pkt The demand access that triggered the prefetch.
+     */
+    void warmPrefetch(Addr addr, const PacketPtr pkt);
+
+    /**
+     * Reload the data of all blocks from memory after functional
+     * warming and downgrade them to shared, as the caches did not see
+     * each other's accesses while warming.
+     */
+    void refreshWarmedBlocks();
+
     /**
      * Create a writeback request for the given block.
      *
@@ -835,10 +872,16 @@ protected:
      *
      * @warn Dirty cache lines will not be written back to
      * memory. Make sure to call functionalWriteback() first if you
-     * want the to write them to memory.
+     * want the to write them to memory. A cache doing functional
+     * warming keeps its blocks and reloads their data on resume.
      */
     virtual void memInvalidate() override;
 
+    /**
+     * Reload the data of the blocks once functional warming is over.
+     */
+    void drainResume() override;
+
     /**
      * Determine if there are any dirty blocks in the cache.
      *
@@ -947,6 +990,21 @@ protected:
      */
     const bool moveContractions;
 
+    /** Are accesses that bypass the cache used to warm it? */
+    const bool functionalWarming;
+
+    /**
+     * Has the cache been warmed or kept across an invalidation, such
+     * that the data of its blocks may be out of date?
+     */
+    bool warmDataStale;
+
+    /** Prefetch candidates of the current functional warming access. */
+    std::vector<Addr> warmPrefetchAddrs;
+
+    /** Data buffer for the prefetches passed on while warming. */
+    std::vector<uint8_t> warmPrefetchData;
+
     /**
      * Bit vector of the blocking reasons for the access path.
      * @sa #BlockedCause
@@ -1141,6 +1199,13 @@ public:
          */
         std::vector<statistics::Scalar *> dataContractions;
 
+        /** Number of functional warming accesses that hit. */
+        statistics::Scalar warmHits;
+        /** Number of functional warming accesses that missed. */
+        statistics::Scalar warmMisses;
+        /** Number of blocks prefetched during functional warming. */
+        statistics::Scalar warmPrefetches;
+
         /** Per-command statistics */
         std::vector<std::unique_ptr<CacheCmdStats>> cmd;
         std::vector<std::vector<std::unique_ptr<CacheCmdStats>>> cmdRegions;
@@ -695,8 +695,9 @@ void Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk) {
         // don't need to respond now, so pop it off to prevent the loop
         // below from generating another response.
         assert(initial_tgt->pkt->cmd == MemCmd::LockedRMWReadReq);
+        PacketPtr rmw_pkt = initial_tgt->pkt;
         mshr->popTarget();
-        delete initial_tgt->pkt;
+        delete rmw_pkt;
         initial_tgt = nullptr;
     }
 
@@ -48,6 +48,7 @@
 
 #include <cassert>
 #include <string>
+#include <utility>
 
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -215,6 +216,15 @@ void MSHR::TargetList::replaceUpgrades() {
     hasUpgrade = false;
 }
 
+void MSHR::TargetList::append(TargetList &src, iterator first,
+                              iterator last) {
+    assert(&src != this);
+    for (auto t = first; t != last; t++) {
+        push_back(std::move(*t));
+    }
+    src.erase(first, last);
+}
+
 void MSHR::TargetList::clearDownstreamPending(MSHR::TargetList::iterator begin,
                                               MSHR::TargetList::iterator end) {
     for (auto t = begin; t != end; t++) {
@@ -517,16 +527,17 @@ MSHR::extractServiceableTargets(PacketPtr pkt) {
         // Leave the Locked RMW Read until the corresponding Locked Write
         // request comes in
         if (it->pkt->cmd != MemCmd::LockedRMWReadReq) {
-            it = targets.erase(it);
-            while (it != targets.end()) {
-                if (it->source == Target::FromCPU) {
-                    it++;
-                } else {
-                    assert(it->source == Target::FromSnoop);
-                    ready_targets.push_back(*it);
-                    it = targets.erase(it);
-                }
-            }
+            // Take the snoops out in a single pass, as erasing them one
+            // at a time is quadratic in the number of targets
+            targets.erase_if(std::next(it),
+                [&ready_targets](const Target &target) {
+                    if (target.source == Target::FromCPU)
+                        return false;
+                    assert(target.source == Target::FromSnoop);
+                    ready_targets.push_back(target);
+                    return true;
+                });
+            targets.erase(targets.begin());
         }
         ready_targets.populateFlags();
     } else {
@@ -539,8 +550,10 @@ MSHR::extractServiceableTargets(PacketPtr pkt) {
                 // line is now "locked".
                 break;
             }
-            it = targets.erase(it);
+            it++;
         }
+        // Erase the serviced targets at once rather than one at a time
+        targets.erase(targets.begin(), it);
         ready_targets.populateFlags();
     }
     targets.populateFlags();
@@ -567,14 +580,13 @@ bool MSHR::promoteDeferredTargets() {
         // then we can promote provided the targets list is empty and
         // we can service it on its own
         if (targets.empty()) {
-            targets.splice(targets.end(), deferredTargets, it);
+            targets.append(deferredTargets, it, it + 1);
         }
     } else {
         // if a cache maintenance operation exists, we promote all the
         // deferred targets that precede it, or all deferred targets
         // otherwise
-        targets.splice(targets.end(), deferredTargets,
-                       deferredTargets.begin(), it);
+        targets.append(deferredTargets, deferredTargets.begin(), it);
     }
 
     deferredTargets.populateFlags();
@@ -599,8 +611,7 @@ void MSHR::promoteIf(const std::function<bool(Target &)> &pred) {
     // the downstreamPending flag and move them to the target list
     deferredTargets.clearDownstreamPending(deferredTargets.begin(),
                                            last_it);
-    targets.splice(targets.end(), deferredTargets,
-                   deferredTargets.begin(), last_it);
+    targets.append(deferredTargets, deferredTargets.begin(), last_it);
     // We need to update the flags for the target lists after the
     // modifications
     deferredTargets.populateFlags();
@@ -53,6 +53,7 @@
 #include <vector>
 
 #include "base/printable.hh"
+#include "base/small_vector.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "debug/MSHR.hh"
@@ -166,7 +167,11 @@ class MSHR : public QueueEntry, public Printable
         {}
     };
 
-    class TargetList : public std::list<Target>, public Named
+    /**
+     * A list of targets. Most MSHRs only see a handful of targets, which
+     * are kept inline so that adding and removing them does not allocate.
+     */
+    class TargetList : public SmallVector<Target, 4>, public Named
     {
 
       public:
@@ -266,6 +271,16 @@ class MSHR : public QueueEntry, public Printable
          * Used to rejig ordering between targets waiting on an MSHR. */
         void replaceUpgrades();
 
+        /**
+         * Move the targets in [first, last) of another list to the end
+         * of this list.
+         *
+         * @param src The list to take the targets from
+         * @param first First target to move
+         * @param last Target following the last target to move
+         */
+        void append(TargetList &src, iterator first, iterator last);
+
         void clearDownstreamPending();
         void clearDownstreamPending(iterator begin, iterator end);
         bool trySatisfyFunctional(PacketPtr pkt);
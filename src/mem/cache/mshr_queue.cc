@@ -63,13 +63,12 @@ MSHRQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
     assert(!freeList.empty());
     MSHR *mshr = freeList.front();
     assert(mshr->getNumTargets() == 0);
-    freeList.pop_front();
 
     DPRINTF(MSHR, "Allocating new MSHR. Number in use will be %lu/%lu\n",
             allocatedList.size() + 1, numEntries);
 
     mshr->allocate(blk_addr, blk_size, pkt, when_ready, order, alloc_on_fill);
-    mshr->allocIter = allocatedList.insert(allocatedList.end(), mshr);
+    mshr->allocIter = addToAllocatedList(mshr);
     mshr->readyIter = addToReadyList(mshr);
 
     allocated += 1;
@@ -87,8 +86,7 @@ void MSHRQueue::deallocate(MSHR *mshr) {
 void MSHRQueue::moveToFront(MSHR *mshr) {
     if (!mshr->inService) {
         assert(mshr == *(mshr->readyIter));
-        readyList.erase(mshr->readyIter);
-        mshr->readyIter = readyList.insert(readyList.begin(), mshr);
+        readyList.splice(readyList.begin(), readyList, mshr->readyIter);
     }
 }
 
@@ -103,7 +101,7 @@ void MSHRQueue::delay(MSHR *mshr, Tick delay_ticks) {
 
 void MSHRQueue::markInService(MSHR *mshr, bool pending_modified_resp) {
     mshr->markInService(pending_modified_resp);
-    readyList.erase(mshr->readyIter);
+    removeNode(readyList, mshr->readyIter);
     _numInService += 1;
 }
 
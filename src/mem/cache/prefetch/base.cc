@@ -224,26 +224,32 @@ Addr Base::pageIthBlockAddress(Addr page, uint32_t blockIndex) const {
     return page + (blockIndex << lBlkSize);
 }
 
-void Base::probeNotify(const CacheAccessProbeArg &acc, bool miss) {
+bool Base::observeProbe(const CacheAccessProbeArg &acc, bool miss) const {
     const PacketPtr pkt = acc.pkt;
     const CacheAccessor &cache = acc.cache;
 
     // Don't notify prefetcher on SWPrefetch, cache maintenance
     // operations or for writes that we are coaslescing.
     if (pkt->cmd.isSWPrefetch())
-        return;
+        return false;
     if (pkt->req->isCacheMaintenance())
-        return;
+        return false;
     if (pkt->isWrite() && cache.coalesce())
-        return;
+        return false;
     if (!pkt->req->hasPaddr()) {
         panic("Request must have a physical address");
     }
 
-    bool has_been_prefetched = acc.cache.hasBeenPrefetched(pkt->getAddr(), pkt->isSecure());
+    bool has_been_prefetched = cache.hasBeenPrefetched(pkt->getAddr(), pkt->isSecure());
 
     // Verify this access type is observed by prefetcher
-    if (observeAccess(pkt, miss, has_been_prefetched)) {
+    return observeAccess(pkt, miss, has_been_prefetched);
+}
+
+void Base::probeNotify(const CacheAccessProbeArg &acc, bool miss) {
+    const PacketPtr pkt = acc.pkt;
+
+    if (observeProbe(acc, miss)) {
         if (useVirtualAddresses && pkt->req->hasVaddr()) {
             PrefetchInfo pfi(pkt, pkt->req->getVaddr(), miss);
             notify(acc, pfi);
@@ -254,6 +260,21 @@ void Base::probeNotify(const CacheAccessProbeArg &acc, bool miss) {
     }
 }
 
+void Base::warmNotify(const CacheAccessProbeArg &acc, bool miss,
+                      std::vector<Addr> &addresses) {
+    const PacketPtr pkt = acc.pkt;
+
+    if (observeProbe(acc, miss)) {
+        if (useVirtualAddresses && pkt->req->hasVaddr()) {
+            PrefetchInfo pfi(pkt, pkt->req->getVaddr(), miss);
+            calculateWarmPrefetch(acc, pfi, addresses);
+        } else if (!useVirtualAddresses) {
+            PrefetchInfo pfi(pkt, pkt->req->getPaddr(), miss);
+            calculateWarmPrefetch(acc, pfi, addresses);
+        }
+    }
+}
+
 void Base::prefetchHit(const CacheAccessProbeArg &acc, bool miss) {
     const PacketPtr pkt = acc.pkt;
     const CacheAccessor &cache = acc.cache;
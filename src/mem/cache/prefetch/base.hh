@@ -47,6 +47,7 @@
 #define __MEM_CACHE_PREFETCH_BASE_HH__
 
 #include <cstdint>
+#include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "base/compiler.hh"
@@ -333,6 +334,27 @@ protected:
      */
     bool observeAccess(const PacketPtr &pkt, bool miss, bool prefetched) const;
 
+    /**
+     * Determine if the access of a probe notification should be
+     * observed, see observeAccess().
+     * @param acc probe arg encapsulating the memory request
+     * @param miss whether this event comes from a cache miss
+     */
+    bool observeProbe(const CacheAccessProbeArg &acc, bool miss) const;
+
+    /**
+     * Calculate the prefetches of a functional warming access, see
+     * warmNotify(). Prefetchers that do not implement it are not
+     * trained while the cache is warmed.
+     * @param acc probe arg encapsulating the memory request
+     * @param pfi information of the access
+     * @param addresses block addresses the prefetcher asks for
+     */
+    virtual void
+    calculateWarmPrefetch(const CacheAccessProbeArg &acc,
+                          const PrefetchInfo &pfi,
+                          std::vector<Addr> &addresses) {}
+
     /** Determine if addresses are on the same page */
     bool samePage(Addr a, Addr b) const;
     /** Determine the address of the block in which a lays */
@@ -414,12 +436,26 @@ public:
     /** Notify prefetcher of cache eviction */
     virtual void notifyEvict(const EvictionInfo &info) {}
 
+    /**
+     * Train the prefetcher on an access made while the cache is
+     * functionally warmed. Nothing is queued or issued; the blocks the
+     * prefetcher would have requested are appended to addresses
+     * instead, for the cache to install directly.
+     * @param acc probe arg encapsulating the memory request
+     * @param miss whether the access missed in the cache
+     * @param addresses block addresses the prefetcher asks for
+     */
+    virtual void warmNotify(const CacheAccessProbeArg &acc, bool miss,
+                            std::vector<Addr> &addresses);
+
     virtual PacketPtr getPacket() = 0;
 
     virtual Tick nextPrefetchReadyTime() const = 0;
 
     void prefetchHit(const CacheAccessProbeArg &acc, bool miss);
 
+    RequestorID getRequestorId() const { return requestorId; }
+
     void
     prefetchUnused() {
         prefetchStats.pfUnused++;
@@ -70,6 +70,14 @@ Multi::nextPrefetchReadyTime() const
     return next_ready;
 }
 
+void
+Multi::warmNotify(const CacheAccessProbeArg &acc, bool miss,
+                  std::vector<Addr> &addresses)
+{
+    for (auto pf : prefetchers)
+        pf->warmNotify(acc, miss, addresses);
+}
+
 PacketPtr
 Multi::getPacket()
 {
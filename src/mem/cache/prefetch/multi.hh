@@ -73,6 +73,10 @@ class Multi : public Base
     void notifyFill(const CacheAccessProbeArg &arg) override {};
     /** @} */
 
+    /** Let every sub-prefetcher train on a functional warming access. */
+    void warmNotify(const CacheAccessProbeArg &acc, bool miss,
+                    std::vector<Addr> &addresses) override;
+
   protected:
     /** List of sub-prefetchers ordered by priority. */
     std::vector<Base*> prefetchers;
@@ -235,6 +235,30 @@ void Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi) {
     }
 }
 
+void Queued::calculateWarmPrefetch(const CacheAccessProbeArg &acc,
+                                   const PrefetchInfo &pfi,
+                                   std::vector<Addr> &addresses) {
+    std::vector<AddrPriority> candidates;
+    calculatePrefetch(pfi, candidates, acc.cache);
+
+    if (useVirtualAddresses) {
+        return;
+    }
+
+    size_t max_pfs = getMaxPermittedPrefetches(candidates.size());
+    size_t num_pfs = 0;
+    for (const AddrPriority &addr_prio : candidates) {
+        if (num_pfs == max_pfs) {
+            break;
+        }
+        Addr blk_addr = blockAddress(addr_prio.first);
+        if (samePage(blk_addr, pfi.getAddr())) {
+            addresses.push_back(blk_addr);
+            num_pfs += 1;
+        }
+    }
+}
+
 PacketPtr
 Queued::getPacket() {
     DPRINTF(HWPrefetch, "Requesting a prefetch to issue.\n");
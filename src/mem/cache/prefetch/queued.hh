@@ -262,6 +262,16 @@ protected:
 
     RequestPtr createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                      PacketPtr pkt);
+
+    /**
+     * Calculate the prefetches of a functional warming access. Page
+     * crossing candidates and candidates of prefetchers trained on
+     * virtual addresses are not returned, as they would need a
+     * translation.
+     */
+    void calculateWarmPrefetch(const CacheAccessProbeArg &acc,
+                               const PrefetchInfo &pfi,
+                               std::vector<Addr> &addresses) override;
 };
 
 } // namespace prefetch
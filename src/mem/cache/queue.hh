@@ -48,7 +48,9 @@
 #include <cassert>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -101,21 +103,107 @@ class Queue : public Drainable, public Named
     /** Holds non allocated entries. */
     typename Entry::List freeList;
 
+    /**
+     * Unused list nodes. Entries are added to and removed from the lists
+     * above by splicing nodes from and to this list, so that queue
+     * operations do not allocate.
+     */
+    typename Entry::List spareNodes;
+
+    /** Number of bits used to select a bucket of the match index. */
+    const unsigned matchBits;
+
+    /**
+     * Index of the allocated entries by block address, used by
+     * findMatch(). Each bucket holds a chain of entries in allocation
+     * order, linked through matchNext.
+     */
+    std::vector<Entry *> matchBuckets;
+
+    /** Next entry in the match index chain, indexed like entries. */
+    std::vector<Entry *> matchNext;
+
+    unsigned
+    matchBucket(Addr blk_addr) const
+    {
+        return (blk_addr * 0x9e3779b97f4a7c15ULL) >> (64 - matchBits);
+    }
+
+    Entry *&
+    nextInChain(const Entry *entry)
+    {
+        return matchNext[entry - entries.data()];
+    }
+
+    /**
+     * Insert an entry in a list using a spare node.
+     *
+     * @param list The list to insert the entry in.
+     * @param pos The position to insert the entry at.
+     * @param entry The entry to insert.
+     * @return Iterator to the inserted entry.
+     */
+    typename Entry::Iterator
+    insertNode(typename Entry::List &list, typename Entry::Iterator pos,
+               Entry *entry)
+    {
+        assert(!spareNodes.empty());
+        auto node = spareNodes.begin();
+        *node = entry;
+        list.splice(pos, spareNodes, node);
+        return node;
+    }
+
+    /**
+     * Remove an entry from a list, keeping its node as a spare.
+     *
+     * @param list The list to remove the entry from.
+     * @param it Iterator to the entry.
+     */
+    void
+    removeNode(typename Entry::List &list, typename Entry::Iterator it)
+    {
+        spareNodes.splice(spareNodes.begin(), list, it);
+    }
+
     typename Entry::Iterator addToReadyList(Entry* entry)
     {
         if (readyList.empty() ||
             readyList.back()->readyTime <= entry->readyTime) {
-            return readyList.insert(readyList.end(), entry);
+            return insertNode(readyList, readyList.end(), entry);
         }
 
         for (auto i = readyList.begin(); i != readyList.end(); ++i) {
             if ((*i)->readyTime > entry->readyTime) {
-                return readyList.insert(i, entry);
+                return insertNode(readyList, i, entry);
             }
         }
         panic("Failed to add to ready list.");
     }
 
+    /**
+     * Take an entry from the free list and add it to the allocated
+     * list. The entry must already hold its block address, which is used
+     * to add it to the match index.
+     *
+     * @param entry The entry to allocate, the head of the free list.
+     * @return Iterator to the entry on the allocated list.
+     */
+    typename Entry::Iterator addToAllocatedList(Entry *entry)
+    {
+        assert(freeList.front() == entry);
+        removeNode(freeList, freeList.begin());
+
+        Entry **link = &matchBuckets[matchBucket(entry->blkAddr)];
+        while (*link) {
+            link = &nextInChain(*link);
+        }
+        *link = entry;
+        nextInChain(entry) = nullptr;
+
+        return insertNode(allocatedList, allocatedList.end(), entry);
+    }
+
     /** The number of entries that are in service. */
     int _numInService;
 
@@ -135,11 +223,17 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
+        matchBits(ceilLog2(numEntries) + 1),
+        matchBuckets(1ULL << matchBits, nullptr),
+        matchNext(numEntries, nullptr),
         _numInService(0), allocated(0)
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
         }
+        // Every entry is either free or allocated, and can also be on
+        // the ready list
+        spareNodes.resize(numEntries, nullptr);
     }
 
     bool isEmpty() const
@@ -168,7 +262,8 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
+        for (Entry *entry = matchBuckets[matchBucket(blk_addr)]; entry;
+             entry = matchNext[entry - entries.data()]) {
             // we ignore any entries allocated for uncacheable
             // accesses and simply ignore them when matching, in the
             // cache we never check for matches when adding new
@@ -240,13 +335,20 @@ class Queue : public Drainable, public Named
     virtual void
     deallocate(Entry *entry)
     {
-        allocatedList.erase(entry->allocIter);
-        freeList.push_front(entry);
+        Entry **link = &matchBuckets[matchBucket(entry->blkAddr)];
+        while (*link != entry) {
+            assert(*link);
+            link = &nextInChain(*link);
+        }
+        *link = nextInChain(entry);
+
+        removeNode(allocatedList, entry->allocIter);
+        insertNode(freeList, freeList.begin(), entry);
         allocated--;
         if (entry->inService) {
             _numInService--;
         } else {
-            readyList.erase(entry->readyIter);
+            removeNode(readyList, entry->readyIter);
         }
         entry->deallocate();
         if (drainState() == DrainState::Draining && allocated == 0) {
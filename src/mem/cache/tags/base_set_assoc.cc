@@ -55,7 +55,8 @@ namespace gem5
 BaseSetAssoc::BaseSetAssoc(const Params &p)
     :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
      sequentialAccess(p.sequential_access),
-     replacementPolicy(p.replacement_policy)
+     replacementPolicy(p.replacement_policy),
+     setIndexing(dynamic_cast<SetAssociative *>(indexingPolicy))
 {
     // There must be a indexing policy
     fatal_if(!p.indexing_policy, "An indexing policy is required");
@@ -83,6 +84,11 @@ BaseSetAssoc::tagsInit()
         // Associate a replacement data entry to the block
         blk->replacementData = replacementPolicy->instantiateEntry();
     }
+
+    // All blocks start invalid
+    if (setIndexing) {
+        packedTags.init(numBlocks / allocAssoc, allocAssoc);
+    }
 }
 
 void
@@ -95,6 +101,28 @@ BaseSetAssoc::invalidate(CacheBlk *blk)
 
     // Invalidate replacement data
     replacementPolicy->invalidate(blk->replacementData);
+
+    updatePackedTag(blk);
+}
+
+CacheBlk*
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    if (!setIndexing) {
+        return BaseTags::findBlock(addr, is_secure);
+    }
+
+    const uint32_t set = setIndexing->getSetIndex(addr);
+    const int way = packedTags.find(set, extractTag(addr), is_secure);
+    if (way < 0) {
+        // Did not find block
+        return nullptr;
+    }
+
+    CacheBlk *blk =
+        static_cast<CacheBlk *>(setIndexing->getEntry(set, way));
+    assert(blk->matchTag(extractTag(addr), is_secure));
+    return blk;
 }
 
 void
@@ -107,6 +135,9 @@ BaseSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
     // the one that is being moved.
     replacementPolicy->invalidate(src_blk->replacementData);
     replacementPolicy->reset(dest_blk->replacementData);
+
+    updatePackedTag(src_blk);
+    updatePackedTag(dest_blk);
 }
 
 } // namespace gem5
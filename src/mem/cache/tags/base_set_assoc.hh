@@ -59,6 +59,8 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/packed_tags.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -85,6 +87,31 @@ protected:
     /** Replacement policy */
     replacement_policy::Base *replacementPolicy;
 
+    /**
+     * The indexing policy if it is a plain set-associative one, in which
+     * case lookups use the packed tag array. Null otherwise.
+     */
+    SetAssociative *setIndexing;
+
+    /**
+     * Copy of the tags of all blocks, used for lookups with
+     * set-associative indexing. It is kept in sync by insertBlock(),
+     * invalidate() and moveBlock().
+     */
+    PackedTags packedTags;
+
+    /**
+     * Update the packed tag of a block after its tag or valid bit changed.
+     *
+     * @param blk The block to update.
+     */
+    void updatePackedTag(const CacheBlk *blk) {
+        if (setIndexing) {
+            packedTags.update(blk->getSet(), blk->getWay(), blk->isValid(),
+                              blk->getTag(), blk->isSecure());
+        }
+    }
+
 public:
     /** Convenience typedef. */
     typedef BaseSetAssocParams Params;
@@ -112,6 +139,17 @@ public:
      */
     void invalidate(CacheBlk *blk) override;
 
+    /**
+     * Find the block with the given address. With set-associative
+     * indexing, the tags of the set are compared using the packed tag
+     * array instead of visiting each block.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -165,13 +203,19 @@ public:
     CacheBlk *findVictim(Addr addr, const bool is_secure,
                          const std::size_t size,
                          std::vector<CacheBlk *> &evict_blks) override {
-        // Get possible entries to be victimized
-        const std::vector<ReplaceableEntry *> entries =
-            indexingPolicy->getPossibleEntries(addr);
-
-        // Choose replacement victim from replacement candidates
-        CacheBlk *victim = static_cast<CacheBlk *>(replacementPolicy->getVictim(
-            entries));
+        // Choose replacement victim from replacement candidates. With
+        // set-associative indexing the set is used in place, which avoids
+        // copying the candidates.
+        CacheBlk *victim;
+        if (setIndexing) {
+            victim = static_cast<CacheBlk *>(replacementPolicy->getVictim(
+                setIndexing->getSetEntries(setIndexing->getSetIndex(addr))));
+        } else {
+            const std::vector<ReplaceableEntry *> entries =
+                indexingPolicy->getPossibleEntries(addr);
+            victim = static_cast<CacheBlk *>(replacementPolicy->getVictim(
+                entries));
+        }
 
         // There is only one eviction for this replacement
         evict_blks.push_back(victim);
@@ -188,6 +232,7 @@ public:
     void insertBlock(const PacketPtr pkt, CacheBlk *blk) override {
         // Insert block
         BaseTags::insertBlock(pkt, blk);
+        updatePackedTag(blk);
 
         // Increment tag counter
         stats.tagsInUse++;
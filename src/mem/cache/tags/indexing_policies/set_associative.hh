@@ -106,6 +106,26 @@ class SetAssociative : public BaseIndexingPolicy
      */
     ~SetAssociative() {};
 
+    /**
+     * Get the set an address maps to.
+     *
+     * @param addr The address to calculate the set for.
+     * @return The set index.
+     */
+    uint32_t getSetIndex(const Addr addr) const { return extractSet(addr); }
+
+    /**
+     * Get all entries of a set without copying them.
+     *
+     * @param set The set index.
+     * @return The entries in all ways of the set.
+     */
+    const std::vector<ReplaceableEntry*> &
+    getSetEntries(const uint32_t set) const
+    {
+        return sets[set];
+    }
+
     /**
      * Find all possible entries for insertion and replacement of an address.
      * Should be called immediately before ReplacementPolicy's findVictim()
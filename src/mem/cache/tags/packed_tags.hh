@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a packed array of the tags of a set-associative store.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PACKED_TAGS_HH__
+#define __MEM_CACHE_TAGS_PACKED_TAGS_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A contiguous copy of the tags of a set-associative store, so that the
+ * tags of a set can be compared without visiting each block. Valid ways
+ * hold (tag << 1) | secure, while invalid ways and padding hold MaxAddr,
+ * which no valid tag can match.
+ */
+class PackedTags
+{
+  public:
+    /**
+     * Number of tags compared in one batch. The batch is compared
+     * without early exits so that the compiler can vectorize it.
+     */
+    static constexpr unsigned lanes = 8;
+
+    /**
+     * Size the array and mark all ways invalid.
+     *
+     * @param num_sets The number of sets.
+     * @param assoc The number of ways in each set.
+     */
+    void
+    init(uint32_t num_sets, uint32_t assoc)
+    {
+        stride = roundUp(assoc, lanes);
+        tags.assign((size_t)num_sets * stride, MaxAddr);
+    }
+
+    /**
+     * Update a way after its tag or valid bit changed.
+     *
+     * @param set The set of the way.
+     * @param way The way within the set.
+     * @param valid Whether the way holds a valid block.
+     * @param tag The tag of the block.
+     * @param is_secure Whether the block is in the secure space.
+     */
+    void
+    update(uint32_t set, uint32_t way, bool valid, Addr tag, bool is_secure)
+    {
+        tags[(size_t)set * stride + way] =
+            valid ? (tag << 1) | is_secure : MaxAddr;
+    }
+
+    /**
+     * Find the way of a set holding a valid block with the given tag.
+     *
+     * @param set The set to search.
+     * @param tag The tag to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return The way, or -1 if no way matches.
+     */
+    int
+    find(uint32_t set, Addr tag, bool is_secure) const
+    {
+        const Addr key = (tag << 1) | is_secure;
+        const Addr *set_tags = &tags[(size_t)set * stride];
+
+        for (unsigned first = 0; first < stride; first += lanes) {
+            uint32_t match = 0;
+            for (unsigned i = 0; i < lanes; i++)
+                match |= uint32_t(set_tags[first + i] == key) << i;
+
+            if (match)
+                return first + ctz32(match);
+        }
+        return -1;
+    }
+
+  private:
+    /** Entries per set, the associativity rounded up to lanes. */
+    unsigned stride = 0;
+
+    std::vector<Addr> tags;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_PACKED_TAGS_HH__
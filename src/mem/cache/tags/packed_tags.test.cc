@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/packed_tags.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** The state of a way, as a block in the tags would hold it. */
+struct Way
+{
+    bool valid = false;
+    Addr tag = 0;
+    bool secure = false;
+};
+
+/** Find a tag by visiting each way, like BaseTags::findBlock(). */
+int
+findByScan(const std::vector<Way> &set, Addr tag, bool is_secure)
+{
+    for (int way = 0; way < (int)set.size(); way++) {
+        if (set[way].valid && set[way].tag == tag &&
+                set[way].secure == is_secure) {
+            return way;
+        }
+    }
+    return -1;
+}
+
+} // anonymous namespace
+
+TEST(PackedTagsTest, StartsInvalid)
+{
+    PackedTags tags;
+    tags.init(4, 12);
+    EXPECT_EQ(-1, tags.find(0, 0, false));
+    EXPECT_EQ(-1, tags.find(3, 0, true));
+}
+
+TEST(PackedTagsTest, FindMatchesSecureBit)
+{
+    PackedTags tags;
+    tags.init(2, 12);
+    tags.update(1, 3, true, 0x1234, false);
+    tags.update(1, 11, true, 0x1234, true);
+
+    EXPECT_EQ(3, tags.find(1, 0x1234, false));
+    EXPECT_EQ(11, tags.find(1, 0x1234, true));
+    EXPECT_EQ(-1, tags.find(0, 0x1234, false));
+
+    tags.update(1, 3, false, 0x1234, false);
+    EXPECT_EQ(-1, tags.find(1, 0x1234, false));
+    EXPECT_EQ(11, tags.find(1, 0x1234, true));
+}
+
+/**
+ * Random inserts and invalidations give the same lookup results as
+ * scanning the ways, for associativities below, at and across multiples
+ * of the batch size.
+ */
+TEST(PackedTagsTest, MatchesScan)
+{
+    std::mt19937 rng(1);
+    for (unsigned assoc : {1, 2, 7, 8, 12, 16, 20, 32}) {
+        const unsigned num_sets = 8;
+        PackedTags tags;
+        tags.init(num_sets, assoc);
+        std::vector<std::vector<Way>> ways(num_sets,
+                                           std::vector<Way>(assoc));
+
+        for (int i = 0; i < 20000; i++) {
+            const uint32_t set = rng() % num_sets;
+            const uint32_t way = rng() % assoc;
+            // Few distinct tags, so that lookups often hit
+            const Addr tag = rng() % (2 * assoc);
+            const bool secure = rng() % 4 == 0;
+
+            Way &w = ways[set][way];
+            if (rng() % 3 == 0) {
+                w.valid = false;
+            } else if (findByScan(ways[set], tag, secure) < 0) {
+                w = Way{true, tag, secure};
+            }
+            tags.update(set, way, w.valid, w.tag, w.secure);
+
+            const Addr find_tag = rng() % (2 * assoc);
+            const bool find_secure = rng() % 4 == 0;
+            ASSERT_EQ(findByScan(ways[set], find_tag, find_secure),
+                      tags.find(set, find_tag, find_secure))
+                << "assoc " << assoc << " step " << i;
+        }
+    }
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark of tag lookups in a set-associative store. It compares
+ * PackedTags against the lookup of BaseTags::findBlock(), which copies
+ * the candidate blocks of the set and then checks the tag of each one.
+ * The blocks are stand-ins padded to about the size of a CacheBlk, so
+ * that visiting them touches as much memory as in the cache.
+ *
+ * Usage: packed_tags_time [sets] [lookups per run]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "mem/cache/tags/packed_tags.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Block
+{
+    bool valid = false;
+    bool secure = false;
+    Addr tag = 0;
+    uint8_t state[112];
+
+    bool
+    matchTag(Addr t, bool is_secure) const
+    {
+        return valid && tag == t && secure == is_secure;
+    }
+};
+
+struct Store
+{
+    unsigned assoc;
+    std::vector<Block> blocks;
+    std::vector<std::vector<Block *>> sets;
+    PackedTags packed;
+    std::vector<Addr> keys;
+    std::vector<bool> keySecure;
+
+    Store(unsigned num_sets, unsigned assoc, uint64_t lookups)
+        : assoc(assoc), blocks((size_t)num_sets * assoc), sets(num_sets)
+    {
+        std::mt19937 rng(1);
+        packed.init(num_sets, assoc);
+        for (unsigned set = 0; set < num_sets; set++) {
+            for (unsigned way = 0; way < assoc; way++) {
+                Block &blk = blocks[(size_t)set * assoc + way];
+                // Leave some ways invalid, as in a warming cache
+                blk.valid = rng() % 8 != 0;
+                blk.tag = way;
+                blk.secure = false;
+                sets[set].push_back(&blk);
+                packed.update(set, way, blk.valid, blk.tag, blk.secure);
+            }
+        }
+
+        // Mostly hits at random ways, and some misses
+        for (uint64_t i = 0; i < lookups; i++) {
+            keys.push_back(rng() % (assoc + assoc / 4 + 1));
+            keySecure.push_back(false);
+        }
+    }
+
+    const Block *
+    findByScan(uint32_t set, Addr tag, bool is_secure) const
+    {
+        const std::vector<Block *> entries = sets[set];
+        for (const auto *blk : entries) {
+            if (blk->matchTag(tag, is_secure))
+                return blk;
+        }
+        return nullptr;
+    }
+
+    const Block *
+    findPacked(uint32_t set, Addr tag, bool is_secure) const
+    {
+        const int way = packed.find(set, tag, is_secure);
+        return way < 0 ? nullptr : sets[set][way];
+    }
+};
+
+template <typename Find>
+double
+run(const Store &store, Find find)
+{
+    const uint32_t num_sets = store.sets.size();
+    uint64_t hits = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < store.keys.size(); i++) {
+        const uint32_t set = (i * 2654435761u) % num_sets;
+        hits += find(set, store.keys[i], store.keySecure[i]) != nullptr;
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    // Keep the lookups from being optimized away
+    if (hits == store.keys.size() + 1)
+        cprintf("\n");
+    return store.keys.size() / elapsed.count();
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const unsigned num_sets = argc > 1 ? std::atoi(argv[1]) : 2048;
+    const uint64_t lookups = argc > 2 ? std::atoll(argv[2]) : 4000000;
+
+    cprintf("%6s %14s %14s %8s\n", "assoc", "scan look/s", "packed look/s",
+            "speedup");
+    for (unsigned assoc : {4, 8, 16, 32, 64}) {
+        const Store store(num_sets, assoc, lookups);
+
+        // Both lookups must find the same blocks
+        for (size_t i = 0; i < 10000 && i < store.keys.size(); i++) {
+            const uint32_t set = i % num_sets;
+            if (store.findByScan(set, store.keys[i], store.keySecure[i]) !=
+                    store.findPacked(set, store.keys[i],
+                                     store.keySecure[i])) {
+                cprintf("lookup mismatch at assoc %d\n", assoc);
+                return 1;
+            }
+        }
+
+        const double scan = run(store,
+            [&store](uint32_t set, Addr tag, bool is_secure) {
+                return store.findByScan(set, tag, is_secure);
+            });
+        const double packed = run(store,
+            [&store](uint32_t set, Addr tag, bool is_secure) {
+                return store.findPacked(set, tag, is_secure);
+            });
+        cprintf("%6d %14d %14d %8.2f\n", assoc, (uint64_t)scan,
+                (uint64_t)packed, packed / scan);
+    }
+
+    return 0;
+}
@@ -52,6 +52,7 @@
 #include <string>
 
 #include "base/printable.hh"
+#include "base/small_vector.hh"
 #include "base/types.hh"
 #include "mem/cache/queue_entry.hh"
 #include "mem/packet.hh"
@@ -75,7 +76,11 @@ class WriteQueueEntry : public QueueEntry, public Printable
     friend class WriteQueue;
 
   public:
-    class TargetList : public std::list<Target>
+    /**
+     * A list of targets. Write queue entries rarely hold more than
+     * one target, which is kept inline.
+     */
+    class TargetList : public SmallVector<Target, 1>
     {
 
       public:
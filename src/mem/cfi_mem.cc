@@ -131,8 +131,9 @@ CfiMemory::ProgramBuffer::writeback()
     if (parent.blocks.isLocked(blockPointer)) {
         return false;
     } else {
-        std::memcpy(parent.toHostAddr(parent.start() + blockPointer),
-            buffer.data(), bytesWritten);
+        uint8_t *host_addr = parent.toHostAddr(parent.start() + blockPointer);
+        std::memcpy(host_addr, buffer.data(), bytesWritten);
+        parent.markDirty(host_addr, bytesWritten);
         return true;
     }
 }
@@ -756,6 +757,7 @@ CfiMemory::BlockData::erase(PacketPtr pkt)
 {
     auto host_address = parent.toHostAddr(pkt->getAddr());
     std::memset(host_address, 0xff, blockSize);
+    parent.markDirty(host_address, blockSize);
 }
 
 } // namespace memory
@@ -983,6 +983,12 @@ void CoherentXBar::recvFunctional(PacketPtr pkt, PortID cpu_side_port_id) {
                 cpuSidePorts[cpu_side_port_id]->name(), pkt->print());
     }
 
+    // a cache above reloads a block it allocated while functionally
+    // warming, which this snoop filter has not seen yet
+    if (snoopFilter && pkt->isWarmRefresh()) {
+        snoopFilter->addHolder(pkt, *cpuSidePorts[cpu_side_port_id]);
+    }
+
     if (!system->bypassCaches()) {
         // forward to all snoopers but the source
         forwardFunctional(pkt, cpu_side_port_id);
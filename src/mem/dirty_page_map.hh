@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_DIRTY_PAGE_MAP_HH__
+#define __MEM_DIRTY_PAGE_MAP_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A bitmap of the pages of a backing store that were written since it
+ * was last cleared, used to write checkpoints that only hold the pages
+ * that changed since the previous one.
+ *
+ * Writes that do not go through the memories, e.g. through a writeable
+ * back door or from a KVM guest, cannot be observed. The host ranges
+ * they may write to are registered as untracked, and every page in
+ * them is considered dirty until they are removed again.
+ */
+class DirtyPageMap
+{
+  public:
+    /**
+     * @param base Host address of the backing store
+     * @param size Size of the backing store in bytes
+     * @param page_size Size of a page, a power of two
+     */
+    DirtyPageMap(const uint8_t *base, uint64_t size, uint64_t page_size)
+        : base(base), size(size), pageShift(floorLog2(page_size)),
+          bits(divCeil(divCeil(size, page_size), 64), 0)
+    {
+        fatal_if(!isPowerOf2(page_size),
+                 "Dirty page size %d is not a power of two\n", page_size);
+    }
+
+    /** Mark the pages covering a host address range as dirty */
+    void
+    mark(const uint8_t *addr, uint64_t len)
+    {
+        const uint64_t offset = addr - base;
+        const uint64_t last = (offset + len - 1) >> pageShift;
+        for (uint64_t page = offset >> pageShift; page <= last; page++)
+            bits[page / 64] |= 1ULL << (page % 64);
+    }
+
+    /** Mark every page as dirty */
+    void
+    markAll()
+    {
+        mark(base, size);
+    }
+
+    /**
+     * Consider every page in a host address range dirty until the
+     * range is removed again.
+     */
+    void
+    addUntracked(const uint8_t *addr, uint64_t len)
+    {
+        untracked.emplace_back(addr, len);
+        mark(addr, len);
+    }
+
+    /**
+     * Stop considering a range dirty. The pages it covers stay dirty
+     * until the next clear(), as they may have been written while the
+     * range was untracked.
+     */
+    void
+    removeUntracked(const uint8_t *addr)
+    {
+        untracked.erase(std::remove_if(untracked.begin(), untracked.end(),
+                                       [addr](const auto &r) {
+                                           return r.first == addr;
+                                       }),
+                        untracked.end());
+    }
+
+    /** Start tracking from a clean state */
+    void
+    clear()
+    {
+        std::fill(bits.begin(), bits.end(), 0);
+        for (const auto &r : untracked)
+            mark(r.first, r.second);
+    }
+
+    uint64_t numPages() const { return divCeil(size, 1ULL << pageShift); }
+
+    bool
+    isDirty(uint64_t page) const
+    {
+        return bits[page / 64] & (1ULL << (page % 64));
+    }
+
+    /** Get the numbers of the dirty pages in increasing order */
+    std::vector<uint64_t>
+    dirtyPages() const
+    {
+        std::vector<uint64_t> pages;
+        for (uint64_t w = 0; w < bits.size(); w++) {
+            for (uint64_t word = bits[w]; word; word &= word - 1)
+                pages.push_back(w * 64 + ctz64(word));
+        }
+        return pages;
+    }
+
+  private:
+    const uint8_t *const base;
+    const uint64_t size;
+    const unsigned pageShift;
+
+    std::vector<uint64_t> bits;
+
+    /** Host ranges that can be written without being marked */
+    std::vector<std::pair<const uint8_t *, uint64_t>> untracked;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_DIRTY_PAGE_MAP_HH__
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "mem/dirty_page_map.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+const uint64_t pageSize = 4096;
+
+} // anonymous namespace
+
+TEST(DirtyPageMapTest, StartsClean)
+{
+    std::vector<uint8_t> mem(10 * pageSize + 100);
+    DirtyPageMap map(mem.data(), mem.size(), pageSize);
+    EXPECT_EQ(11, map.numPages());
+    EXPECT_TRUE(map.dirtyPages().empty());
+}
+
+TEST(DirtyPageMapTest, MarkCoversPages)
+{
+    std::vector<uint8_t> mem(200 * pageSize);
+    DirtyPageMap map(mem.data(), mem.size(), pageSize);
+
+    map.mark(mem.data() + 3 * pageSize + 10, 8);
+    map.mark(mem.data() + 70 * pageSize - 4, 8);
+    map.mark(mem.data() + 199 * pageSize, pageSize);
+
+    EXPECT_EQ(std::vector<uint64_t>({3, 69, 70, 199}), map.dirtyPages());
+    EXPECT_TRUE(map.isDirty(69));
+    EXPECT_FALSE(map.isDirty(68));
+}
+
+TEST(DirtyPageMapTest, ClearAndMarkAll)
+{
+    std::vector<uint8_t> mem(5 * pageSize + 1);
+    DirtyPageMap map(mem.data(), mem.size(), pageSize);
+
+    map.markAll();
+    EXPECT_EQ(std::vector<uint64_t>({0, 1, 2, 3, 4, 5}), map.dirtyPages());
+    map.clear();
+    EXPECT_TRUE(map.dirtyPages().empty());
+}
+
+TEST(DirtyPageMapTest, UntrackedRanges)
+{
+    std::vector<uint8_t> mem(8 * pageSize);
+    DirtyPageMap map(mem.data(), mem.size(), pageSize);
+
+    map.addUntracked(mem.data() + 2 * pageSize, 2 * pageSize);
+    EXPECT_EQ(std::vector<uint64_t>({2, 3}), map.dirtyPages());
+
+    // Untracked pages stay dirty across clears
+    map.clear();
+    map.mark(mem.data(), 1);
+    EXPECT_EQ(std::vector<uint64_t>({0, 2, 3}), map.dirtyPages());
+
+    // and until the next clear once they are tracked again
+    map.removeUntracked(mem.data() + 2 * pageSize);
+    EXPECT_EQ(std::vector<uint64_t>({0, 2, 3}), map.dirtyPages());
+    map.clear();
+    EXPECT_TRUE(map.dirtyPages().empty());
+}
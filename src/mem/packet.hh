@@ -347,7 +347,17 @@ private:
 
         // Signal block present to squash prefetch and cache evict packets
         // through express snoop flag
-        BLOCK_CACHED = 0x00010000
+        BLOCK_CACHED = 0x00010000,
+
+        /// Functional warming: an upstream cache hit on this access,
+        /// so caches further downstream leave their state untouched.
+        WARM_HIT = 0x00020000,
+        /// Functional warming: an upstream cache allocated the block.
+        WARM_ALLOCATED = 0x00040000,
+        /// Functional read reloading the data of a block after
+        /// functional warming. Snoop filters on the way record the
+        /// requesting port as a holder of the block.
+        WARM_REFRESH = 0x00080000
     };
 
     Flags flags;
@@ -738,6 +748,13 @@ public:
     bool isBlockCached() const { return flags.isSet(BLOCK_CACHED); }
     void clearBlockCached() { flags.clear(BLOCK_CACHED); }
 
+    void setWarmHit() { flags.set(WARM_HIT); }
+    bool isWarmHit() const { return flags.isSet(WARM_HIT); }
+    void setWarmAllocated() { flags.set(WARM_ALLOCATED); }
+    bool isWarmAllocated() const { return flags.isSet(WARM_ALLOCATED); }
+    void setWarmRefresh() { flags.set(WARM_REFRESH); }
+    bool isWarmRefresh() const { return flags.isSet(WARM_REFRESH); }
+
     /**
      * QoS Value getter
      * Returns 0 if QoS value was never set (constructor default).
@@ -53,6 +53,9 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
+    const unsigned log_bytes = floorLog2(_pageSize);
+    splitLarge(vaddr, size);
+
     while (size > 0) {
         auto it = pTable.find(vaddr);
         if (it != pTable.end()) {
@@ -60,9 +63,9 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
             panic_if(!clobber,
                      "EmulationPageTable::allocate: addr %#x already mapped",
                      vaddr);
-            it->second = Entry(paddr, flags);
+            it->second = Entry(paddr, flags, log_bytes);
         } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
+            pTable.emplace(vaddr, Entry(paddr, flags, log_bytes));
         }
 
         size -= _pageSize;
@@ -71,6 +74,61 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
     }
 }
 
+void
+EmulationPageTable::mapLarge(Addr vaddr, Addr paddr, unsigned log_bytes,
+                             uint64_t flags)
+{
+    const Addr size = 1ULL << log_bytes;
+    assert(size > _pageSize);
+    assert((vaddr & mask(log_bytes)) == 0 && (paddr & mask(log_bytes)) == 0);
+    panic_if(!isUnmapped(vaddr, size),
+             "EmulationPageTable::mapLarge: %#x-%#x already mapped",
+             vaddr, vaddr + size);
+
+    DPRINTF(MMU, "Allocating large page: %#x-%#x\n", vaddr, vaddr + size);
+
+    largePages.emplace(vaddr, Entry(paddr, flags, log_bytes));
+}
+
+const EmulationPageTable::Entry *
+EmulationPageTable::lookupLarge(Addr vaddr) const
+{
+    auto it = largePages.upper_bound(vaddr);
+    if (it == largePages.begin())
+        return nullptr;
+    --it;
+    if ((vaddr - it->first) >> it->second.logBytes)
+        return nullptr;
+    return &it->second;
+}
+
+void
+EmulationPageTable::splitLarge(Addr vaddr, int64_t size)
+{
+    // The first page that might overlap the region
+    auto it = largePages.upper_bound(vaddr);
+    if (it != largePages.begin()) {
+        auto prev = std::prev(it);
+        if (!((vaddr - prev->first) >> prev->second.logBytes))
+            it = prev;
+    }
+
+    const unsigned log_bytes = floorLog2(_pageSize);
+    while (it != largePages.end() && it->first < vaddr + size) {
+        const Entry &large = it->second;
+        DPRINTF(MMU, "Splitting large page: %#x-%#x\n", it->first,
+                it->first + (1ULL << large.logBytes));
+
+        for (Addr offset = 0; offset < (1ULL << large.logBytes);
+                offset += _pageSize) {
+            pTable.emplace(it->first + offset,
+                           Entry(large.paddr + offset, large.flags,
+                                 log_bytes));
+        }
+        it = largePages.erase(it);
+    }
+}
+
 void
 EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
 {
@@ -80,6 +138,8 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
+    splitLarge(vaddr, size);
+
     while (size > 0) {
         [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
         auto old_it = pTable.find(vaddr);
@@ -98,6 +158,13 @@ EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
     for (auto &iter : pTable)
         addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    for (auto &iter : largePages) {
+        for (Addr offset = 0; offset < (1ULL << iter.second.logBytes);
+                offset += _pageSize) {
+            addr_maps->push_back(std::make_pair(iter.first + offset,
+                                                iter.second.paddr + offset));
+        }
+    }
 }
 
 void
@@ -107,6 +174,8 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
+    splitLarge(vaddr, size);
+
     while (size > 0) {
         auto it = pTable.find(vaddr);
         assert(it != pTable.end());
@@ -122,6 +191,25 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
+    // A large page overlapping the region starts before its end, and
+    // ends after its start
+    auto it = largePages.lower_bound(vaddr + size);
+    if (it != largePages.begin()) {
+        --it;
+        if (it->first + (1ULL << it->second.logBytes) > vaddr)
+            return false;
+    }
+
+    // Look for mapped pages in the region, or for the region of each
+    // page if there are fewer of those
+    if (size / _pageSize > (int64_t)pTable.size()) {
+        for (const auto &pte : pTable) {
+            if (pte.first >= vaddr && pte.first - vaddr < (Addr)size)
+                return false;
+        }
+        return true;
+    }
+
     for (int64_t offset = 0; offset < size; offset += _pageSize)
         if (pTable.find(vaddr + offset) != pTable.end())
             return false;
@@ -135,7 +223,7 @@ EmulationPageTable::lookup(Addr vaddr)
     Addr page_addr = pageAlign(vaddr);
     PTableItr iter = pTable.find(page_addr);
     if (iter == pTable.end())
-        return nullptr;
+        return largePages.empty() ? nullptr : lookupLarge(vaddr);
     return &(iter->second);
 }
 
@@ -147,7 +235,7 @@ EmulationPageTable::translate(Addr vaddr, Addr &paddr)
         DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
         return false;
     }
-    paddr = pageOffset(vaddr) + entry->paddr;
+    paddr = entry->translate(vaddr);
     DPRINTF(MMU, "Translating: %#x->%#x\n", vaddr, paddr);
     return true;
 }
@@ -171,14 +259,19 @@ EmulationPageTable::translate(const RequestPtr &req)
 void
 EmulationPageTable::PageTableTranslationGen::translate(Range &range) const
 {
-    const Addr page_size = pt->pageSize();
+    const Entry *entry = pt->lookup(range.vaddr);
+    const Addr page_size =
+        entry ? (1ULL << entry->logBytes) : pt->pageSize();
 
+    // Translate up to the end of the page, which can be a large one
     Addr next = roundUp(range.vaddr, page_size);
     if (next == range.vaddr)
         next += page_size;
     range.size = std::min(range.size, next - range.vaddr);
 
-    if (!pt->translate(range.vaddr, range.paddr))
+    if (entry)
+        range.paddr = entry->translate(range.vaddr);
+    else
         range.fault = Fault(new GenericPageTableFault(range.vaddr));
 }
 
@@ -197,6 +290,22 @@ EmulationPageTable::serialize(CheckpointOut &cp) const
         paramOut(cp, "flags", pte.second.flags);
     }
     assert(count == pTable.size());
+
+    if (largePages.empty())
+        return;
+
+    ScopedCheckpointSection large_sec(cp, "large");
+    paramOut(cp, "size", largePages.size());
+
+    count = 0;
+    for (auto &pte : largePages) {
+        ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
+
+        paramOut(cp, "vaddr", pte.first);
+        paramOut(cp, "paddr", pte.second.paddr);
+        paramOut(cp, "flags", pte.second.flags);
+        paramOut(cp, "log_bytes", pte.second.logBytes);
+    }
 }
 
 void
@@ -216,7 +325,28 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        pTable.emplace(vaddr, Entry(paddr, flags, floorLog2(_pageSize)));
+    }
+
+    if (!cp.sectionExists(Serializable::currentSection() + ".large"))
+        return;
+
+    ScopedCheckpointSection large_sec(cp, "large");
+    paramIn(cp, "size", count);
+
+    for (int i = 0; i < count; ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("Entry%d", i));
+
+        Addr vaddr;
+        UNSERIALIZE_SCALAR(vaddr);
+        Addr paddr;
+        uint64_t flags;
+        unsigned log_bytes;
+        UNSERIALIZE_SCALAR(paddr);
+        UNSERIALIZE_SCALAR(flags);
+        UNSERIALIZE_SCALAR(log_bytes);
+
+        largePages.emplace(vaddr, Entry(paddr, flags, log_bytes));
     }
 }
 
@@ -227,6 +357,8 @@ EmulationPageTable::externalize() const
     for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
         ss << std::hex << it->first << ":" << it->second.paddr << ";";
     }
+    for (const auto &pte : largePages)
+        ss << std::hex << pte.first << ":" << pte.second.paddr << ";";
     return ss.str();
 }
 
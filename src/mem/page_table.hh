@@ -35,6 +35,7 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <map>
 #include <string>
 #include <unordered_map>
 
@@ -55,11 +56,22 @@ class EmulationPageTable : public Serializable
   public:
     struct Entry
     {
+        // The base of the physical page.
         Addr paddr;
         uint64_t flags;
+        // The size of the page, in address bits.
+        unsigned logBytes;
 
-        Entry(Addr paddr, uint64_t flags) : paddr(paddr), flags(flags) {}
+        Entry(Addr paddr, uint64_t flags, unsigned log_bytes) :
+            paddr(paddr), flags(flags), logBytes(log_bytes)
+        {}
         Entry() {}
+
+        /** Translate an address within the page of this entry. */
+        Addr translate(Addr vaddr) const
+        {
+            return paddr + (vaddr & mask(logBytes));
+        }
     };
 
   protected:
@@ -67,6 +79,13 @@ class EmulationPageTable : public Serializable
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
+    /**
+     * Mappings of pages larger than the base page size, by the virtual
+     * address they start at. A single entry covers what would otherwise
+     * take up to 2^18 base page entries.
+     */
+    std::map<Addr, Entry> largePages;
+
     const Addr _pageSize;
     const Addr offsetMask;
 
@@ -123,6 +142,19 @@ class EmulationPageTable : public Serializable
      *              from MappingFlags enum.
      */
     virtual void map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags = 0);
+
+    /**
+     * Maps a single page larger than the base page size. Both addresses
+     * must be aligned to the size of the page, and the page must not
+     * overlap any existing mapping. Later changes to part of the page
+     * split it into base pages.
+     * @param vaddr The starting virtual address of the page.
+     * @param paddr The starting physical address of the page.
+     * @param log_bytes The size of the page in address bits.
+     * @param flags Generic mapping flags, see map().
+     */
+    void mapLarge(Addr vaddr, Addr paddr, unsigned log_bytes,
+                  uint64_t flags = 0);
     virtual void remap(Addr vaddr, int64_t size, Addr new_vaddr);
     virtual void unmap(Addr vaddr, int64_t size);
 
@@ -137,7 +169,8 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @return The page table entry corresponding to vaddr, which may map
+     *         a page larger than the base page size.
      */
     const Entry *lookup(Addr vaddr);
 
@@ -198,6 +231,16 @@ class EmulationPageTable : public Serializable
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
+
+  private:
+    /** Find the large page containing vaddr. */
+    const Entry *lookupLarge(Addr vaddr) const;
+
+    /**
+     * Split the large pages overlapping a region into base pages, so
+     * that the region can be changed page by page.
+     */
+    void splitLarge(Addr vaddr, int64_t size);
 };
 
 } // namespace gem5
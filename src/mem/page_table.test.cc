@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "mem/page_table.hh"
+#include "sim/faults.hh"
+
+using namespace gem5;
+
+namespace gem5
+{
+
+// The page table only constructs faults, it never invokes them.
+void FaultBase::invoke(ThreadContext *tc, const StaticInstPtr &inst) {}
+void
+GenericPageTableFault::invoke(ThreadContext *tc, const StaticInstPtr &inst)
+{}
+
+} // namespace gem5
+
+namespace
+{
+
+const Addr pageSize = 4096;
+const unsigned largeBits = 21;
+const Addr largeSize = 1ULL << largeBits;
+
+// A large page at 2 MiB mapped to 6 MiB
+const Addr largeVaddr = 0x200000;
+const Addr largePaddr = 0x600000;
+
+class PageTableTest : public testing::Test
+{
+  protected:
+    EmulationPageTable pt{"pt", 0, pageSize};
+
+    void mapLarge() { pt.mapLarge(largeVaddr, largePaddr, largeBits); }
+};
+
+} // anonymous namespace
+
+TEST_F(PageTableTest, MapAndLookup)
+{
+    pt.map(0x10000, 0x80000, 2 * pageSize);
+
+    const auto *entry = pt.lookup(0x10000 + pageSize + 8);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(floorLog2(pageSize), entry->logBytes);
+    EXPECT_EQ(0x80000 + pageSize + 8, entry->translate(0x11008));
+
+    EXPECT_EQ(nullptr, pt.lookup(0x10000 - 1));
+    EXPECT_EQ(nullptr, pt.lookup(0x10000 + 2 * pageSize));
+}
+
+TEST_F(PageTableTest, LookupLargePage)
+{
+    mapLarge();
+
+    for (Addr offset : {(Addr)0, largeSize / 2 + 12, largeSize - 1}) {
+        const auto *entry = pt.lookup(largeVaddr + offset);
+        ASSERT_NE(nullptr, entry) << "offset " << offset;
+        EXPECT_EQ(largeBits, entry->logBytes);
+
+        Addr paddr;
+        ASSERT_TRUE(pt.translate(largeVaddr + offset, paddr));
+        EXPECT_EQ(largePaddr + offset, paddr);
+    }
+
+    // The addresses just outside the page
+    EXPECT_EQ(nullptr, pt.lookup(largeVaddr - 1));
+    EXPECT_EQ(nullptr, pt.lookup(largeVaddr + largeSize));
+}
+
+TEST_F(PageTableTest, IsUnmappedLargePage)
+{
+    mapLarge();
+
+    EXPECT_FALSE(pt.isUnmapped(largeVaddr, pageSize));
+    EXPECT_FALSE(pt.isUnmapped(largeVaddr + largeSize - pageSize, pageSize));
+    EXPECT_FALSE(pt.isUnmapped(largeVaddr - pageSize, 2 * pageSize));
+    EXPECT_FALSE(pt.isUnmapped(largeVaddr + largeSize - pageSize,
+                               2 * pageSize));
+    EXPECT_FALSE(pt.isUnmapped(0, 4 * largeSize));
+
+    EXPECT_TRUE(pt.isUnmapped(largeVaddr - pageSize, pageSize));
+    EXPECT_TRUE(pt.isUnmapped(largeVaddr + largeSize, pageSize));
+}
+
+TEST_F(PageTableTest, MapSplitsLargePage)
+{
+    mapLarge();
+
+    const Addr vaddr = largeVaddr + 5 * pageSize;
+    pt.map(vaddr, 0x10000, pageSize, EmulationPageTable::Clobber);
+
+    const auto *entry = pt.lookup(vaddr + 4);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(floorLog2(pageSize), entry->logBytes);
+    EXPECT_EQ(0x10004, entry->translate(vaddr + 4));
+
+    // The rest of the large page keeps its translation in base pages
+    for (Addr offset : {(Addr)0, 4 * pageSize, 6 * pageSize,
+                        largeSize - 1}) {
+        entry = pt.lookup(largeVaddr + offset);
+        ASSERT_NE(nullptr, entry) << "offset " << offset;
+        EXPECT_EQ(floorLog2(pageSize), entry->logBytes);
+        EXPECT_EQ(largePaddr + offset, entry->translate(largeVaddr + offset));
+    }
+}
+
+TEST_F(PageTableTest, UnmapOverlappingLargePages)
+{
+    mapLarge();
+    pt.mapLarge(largeVaddr + largeSize, largePaddr + largeSize, largeBits);
+
+    // Unmap the end of the first page and the start of the second
+    const Addr vaddr = largeVaddr + largeSize - 2 * pageSize;
+    pt.unmap(vaddr, 4 * pageSize);
+
+    EXPECT_TRUE(pt.isUnmapped(vaddr, 4 * pageSize));
+    EXPECT_EQ(nullptr, pt.lookup(vaddr));
+    EXPECT_EQ(nullptr, pt.lookup(vaddr + 4 * pageSize - 1));
+
+    const auto *entry = pt.lookup(vaddr - 1);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(largePaddr + largeSize - 2 * pageSize - 1,
+              entry->translate(vaddr - 1));
+    entry = pt.lookup(vaddr + 4 * pageSize);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(largePaddr + largeSize + 2 * pageSize,
+              entry->translate(vaddr + 4 * pageSize));
+    EXPECT_FALSE(pt.isUnmapped(largeVaddr, 2 * largeSize));
+}
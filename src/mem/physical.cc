@@ -39,22 +39,32 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "sim/byteswap.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -76,14 +86,84 @@ namespace gem5
 namespace memory
 {
 
+namespace
+{
+
+/** Magic number and version of the sparse store format */
+const char sparseMagic[8] = { 'G', 'E', 'M', '5', 'S', 'P', 'R', 'S' };
+const uint32_t sparseVersion = 1;
+
+/** Number of pages compressed together in the sparse store format */
+const uint32_t sparsePagesPerChunk = 256;
+
+/** Fixed size header of the sparse store format */
+struct SparseHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t pageSize;
+    uint64_t rangeSize;
+    uint64_t numPages;
+    uint32_t pagesPerChunk;
+    uint32_t reserved;
+};
+
+/**
+ * Call a function for each index in [0, n) from the given number of
+ * threads, including the calling one.
+ */
+void
+parallelFor(unsigned threads, uint64_t n,
+            const std::function<void(uint64_t)> &func)
+{
+    std::atomic<uint64_t> next(0);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < n; i = next++)
+            func(i);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < std::min<uint64_t>(threads, n); t++)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+}
+
+bool
+isZeroPage(const uint8_t *page, uint64_t size)
+{
+    uint64_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, page + i, sizeof(word));
+        if (word)
+            return false;
+    }
+    for (; i < size; i++) {
+        if (page[i])
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
 PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               bool sparse_checkpoint,
+                               bool image_checkpoint,
+                               bool delta_checkpoint,
+                               unsigned checkpoint_threads) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), sparseCheckpoint(sparse_checkpoint),
+    imageCheckpoint(image_checkpoint), deltaCheckpoint(delta_checkpoint),
+    checkpointThreads(checkpoint_threads ? checkpoint_threads :
+                      std::max(1U, std::thread::hardware_concurrency()))
 {
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
@@ -93,6 +173,9 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
 
+    fatal_if(sparseCheckpoint && imageCheckpoint,
+             "Memory checkpoints cannot be both sparse and images\n");
+
     // add the memories from the system to the address map as
     // appropriate
     for (const auto& m : _memories) {
@@ -254,14 +337,102 @@ PhysicalMemory::createBackingStore(
                               conf_table_reported, in_addr_map, kvm_map,
                               shm_fd, map_offset);
 
+    if (deltaCheckpoint) {
+        dirtyPages.emplace_back(
+            std::make_unique<DirtyPageMap>(pmem, range.size(), pageSize));
+        // other processes may write to a shared backing store
+        if (shm_fd != -1)
+            dirtyPages.back()->addUntracked(pmem, range.size());
+    }
+
     // point the memories to their backing store
     for (const auto& m : _memories) {
         DPRINTF(AddrRanges, "Mapping memory %s to backing store\n",
                 m->name());
         m->setBackingStore(pmem);
+        if (deltaCheckpoint)
+            m->setDirtyPageMap(dirtyPages.back().get());
     }
 }
 
+void
+PhysicalMemory::untrackDirtyPages(unsigned store_id)
+{
+    if (!deltaCheckpoint)
+        return;
+
+    const BackingStoreEntry &s = backingStore[store_id];
+    DPRINTF(Checkpoint, "Not tracking the dirty pages of store %d\n",
+            store_id);
+    dirtyPages[store_id]->addUntracked(s.pmem, s.range.size());
+}
+
+void
+PhysicalMemory::markDirty(const uint8_t *host, uint64_t size)
+{
+    if (!deltaCheckpoint)
+        return;
+
+    for (unsigned store_id = 0; store_id < backingStore.size(); ++store_id) {
+        const BackingStoreEntry &s = backingStore[store_id];
+        if (host >= s.pmem && host + size <= s.pmem + s.range.size()) {
+            dirtyPages[store_id]->mark(host, size);
+            return;
+        }
+    }
+}
+
+bool
+PhysicalMemory::mapFile(Addr addr, uint64_t size, int fd, off_t offset)
+{
+    auto m = addrMap.contains(AddrRange(addr, addr + size));
+    if (m == addrMap.end() || m->second->isNull() ||
+        m->second->getAddrRange().interleaved())
+        return false;
+
+    uint8_t *host = m->second->toHostAddr(addr);
+    if ((uintptr_t)host % pageSize || offset % pageSize || size % pageSize)
+        return false;
+
+    for (unsigned store_id = 0; store_id < backingStore.size(); ++store_id) {
+        const BackingStoreEntry &s = backingStore[store_id];
+        if (host < s.pmem || host + size > s.pmem + s.range.size())
+            continue;
+
+        // Other processes see a shared backing store, which a private
+        // mapping would hide from them
+        if (s.shmFd != -1)
+            return false;
+
+        int map_flags = MAP_PRIVATE | MAP_FIXED;
+        if (mmapUsingNoReserve)
+            map_flags |= MAP_NORESERVE;
+
+        void *pmem = mmap(host, size, PROT_READ | PROT_WRITE, map_flags,
+                          fd, offset);
+        if (pmem == MAP_FAILED) {
+            // Most likely the process ran out of mappings
+            // (vm.max_map_count), so let the caller copy the pages
+            // instead. A failed fixed mapping may have unmapped the
+            // range already, so put fresh anonymous pages back.
+            warn_once("Could not map file pages (%s), copying them "
+                      "instead\n", strerror(errno));
+            pmem = mmap(host, size, PROT_READ | PROT_WRITE,
+                        map_flags | MAP_ANONYMOUS, -1, 0);
+            fatal_if(pmem != host, "Could not restore the backing store "
+                     "at %#x after failing to map file pages\n", addr);
+            return false;
+        }
+        panic_if(pmem != host, "File pages mapped at the wrong address\n");
+
+        // The pages changed without going through the memories
+        if (deltaCheckpoint)
+            dirtyPages[store_id]->mark(host, size);
+        return true;
+    }
+    return false;
+}
+
 PhysicalMemory::~PhysicalMemory()
 {
     // unmap the backing store
@@ -357,6 +528,13 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
         serializeStore(cp, store_id++, s.range, s.pmem);
     }
+
+    // the next checkpoint only has to hold the changes to this one
+    if (deltaCheckpoint) {
+        for (auto &d : dirtyPages)
+            d->clear();
+        referenceCheckpoint = CheckpointIn::dir();
+    }
 }
 
 void
@@ -365,19 +543,50 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 {
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
-    std::string filename =
-        name() + ".store" + std::to_string(store_id) + ".pmem";
+    const bool delta = deltaCheckpoint && !referenceCheckpoint.empty();
+    std::string filename = name() + ".store" + std::to_string(store_id) +
+        (delta ? ".dpmem" : sparseCheckpoint ? ".spmem" :
+         imageCheckpoint ? ".img" : ".pmem");
     long range_size = range.size();
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
             filename, range_size);
 
+    if (delta || sparseCheckpoint || imageCheckpoint) {
+        std::string format = delta ? "delta" :
+            sparseCheckpoint ? "sparse" : "image";
+        SERIALIZE_SCALAR(format);
+    }
+
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
 
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    if (delta) {
+        // refer to the previous checkpoint relative to this one, so
+        // that a directory holding both can be moved
+        std::error_code ec;
+        std::string base = std::filesystem::relative(
+            referenceCheckpoint, CheckpointIn::dir(), ec).string();
+        if (ec || base.empty()) {
+            base = std::filesystem::absolute(referenceCheckpoint,
+                                             ec).string();
+        }
+        SERIALIZE_SCALAR(base);
+
+        writeSparsePages(filepath, range, pmem,
+                         dirtyPages[store_id]->dirtyPages());
+        return;
+    } else if (sparseCheckpoint) {
+        serializeSparseStore(filepath, range, pmem);
+        return;
+    } else if (imageCheckpoint) {
+        serializeImageStore(filepath, range, pmem);
+        return;
+    }
+
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
@@ -406,6 +615,211 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 
 }
 
+void
+PhysicalMemory::serializeSparseStore(const std::string &filepath,
+                                     AddrRange range,
+                                     const uint8_t *pmem) const
+{
+    const uint64_t range_size = range.size();
+    const uint64_t num_pages = divCeil(range_size, pageSize);
+    auto page_bytes = [&](uint64_t page) {
+        return std::min<uint64_t>(pageSize, range_size - page * pageSize);
+    };
+
+    // Find the pages that are not all zero, scanning blocks of pages in
+    // parallel
+    const uint64_t pages_per_block = 4096;
+    std::vector<std::vector<uint64_t>> block_pages(
+        divCeil(num_pages, pages_per_block));
+    parallelFor(checkpointThreads, block_pages.size(), [&](uint64_t b) {
+        const uint64_t end = std::min(num_pages, (b + 1) * pages_per_block);
+        for (uint64_t p = b * pages_per_block; p < end; p++) {
+            if (!isZeroPage(pmem + p * pageSize, page_bytes(p)))
+                block_pages[b].push_back(p);
+        }
+    });
+
+    std::vector<uint64_t> pages;
+    for (const auto &bp : block_pages)
+        pages.insert(pages.end(), bp.begin(), bp.end());
+    block_pages.clear();
+
+    writeSparsePages(filepath, range, pmem, pages);
+}
+
+void
+PhysicalMemory::writeSparsePages(const std::string &filepath,
+                                 AddrRange range, const uint8_t *pmem,
+                                 const std::vector<uint64_t> &pages) const
+{
+    const uint64_t range_size = range.size();
+    const uint64_t num_pages = divCeil(range_size, pageSize);
+    auto page_bytes = [&](uint64_t page) {
+        return std::min<uint64_t>(pageSize, range_size - page * pageSize);
+    };
+
+    const uint64_t num_chunks = divCeil(pages.size(), sparsePagesPerChunk);
+    DPRINTF(Checkpoint, "Writing %d of %d pages in %d chunks to %s\n",
+            pages.size(), num_pages, num_chunks, filepath);
+
+    std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+    fatal_if(!out, "Can't open physical memory checkpoint file '%s'\n",
+             filepath);
+
+    SparseHeader header;
+    std::memcpy(header.magic, sparseMagic, sizeof(header.magic));
+    header.version = htole(sparseVersion);
+    header.pageSize = htole((uint32_t)pageSize);
+    header.rangeSize = htole(range_size);
+    header.numPages = htole((uint64_t)pages.size());
+    header.pagesPerChunk = htole(sparsePagesPerChunk);
+    header.reserved = 0;
+    out.write((const char *)&header, sizeof(header));
+
+    std::vector<uint64_t> index(pages.size());
+    std::transform(pages.begin(), pages.end(), index.begin(),
+                   [](uint64_t p) { return htole(p); });
+    out.write((const char *)index.data(), index.size() * sizeof(uint64_t));
+
+    // The chunk sizes are only known once the chunks are compressed, so
+    // leave room for them and fill them in at the end
+    const std::streampos sizes_pos = out.tellp();
+    std::vector<uint64_t> chunk_sizes(num_chunks, 0);
+    out.write((const char *)chunk_sizes.data(),
+              num_chunks * sizeof(uint64_t));
+
+    // Compress batches of chunks in parallel and write each batch in
+    // order, which bounds the memory held by compressed chunks
+    const uint64_t batch_size = 4 * checkpointThreads;
+    std::vector<std::vector<uint8_t>> compressed(batch_size);
+    // Only the main thread may call fatal(), so the workers just flag
+    // a failed compression
+    std::atomic<bool> failed(false);
+    for (uint64_t first = 0; first < num_chunks; first += batch_size) {
+        const uint64_t count = std::min(batch_size, num_chunks - first);
+        parallelFor(checkpointThreads, count, [&](uint64_t i) {
+            const uint64_t chunk = first + i;
+            const uint64_t begin = chunk * sparsePagesPerChunk;
+            const uint64_t end = std::min<uint64_t>(
+                pages.size(), begin + sparsePagesPerChunk);
+
+            std::vector<uint8_t> raw;
+            raw.reserve((end - begin) * pageSize);
+            for (uint64_t p = begin; p < end; p++) {
+                const uint64_t page = pages[p];
+                const uint8_t *data = pmem + page * pageSize;
+                raw.insert(raw.end(), data, data + page_bytes(page));
+            }
+
+            uLongf dest_len = compressBound(raw.size());
+            compressed[i].resize(dest_len);
+            if (compress2(compressed[i].data(), &dest_len, raw.data(),
+                          raw.size(), Z_BEST_SPEED) != Z_OK) {
+                failed = true;
+                return;
+            }
+            compressed[i].resize(dest_len);
+        });
+        fatal_if(failed, "Failed to compress physical memory checkpoint "
+                 "file '%s'\n", filepath);
+
+        for (uint64_t i = 0; i < count; i++) {
+            out.write((const char *)compressed[i].data(),
+                      compressed[i].size());
+            chunk_sizes[first + i] = htole((uint64_t)compressed[i].size());
+        }
+    }
+
+    out.seekp(sizes_pos);
+    out.write((const char *)chunk_sizes.data(),
+              num_chunks * sizeof(uint64_t));
+    out.close();
+    fatal_if(!out, "Write failed on physical memory checkpoint file '%s'\n",
+             filepath);
+}
+
+void
+PhysicalMemory::serializeImageStore(const std::string &filepath,
+                                    AddrRange range,
+                                    const uint8_t *pmem) const
+{
+    const uint64_t range_size = range.size();
+    const uint64_t num_pages = divCeil(range_size, pageSize);
+
+    // The image may be mapped as the backing store of this or another
+    // simulation, e.g. when checkpointing again into the checkpoint
+    // that was restored. Write a new file and rename it over the old
+    // one rather than truncating the old one, so that the existing
+    // mappings keep the contents of the old file.
+    const std::string tmppath = filepath + ".tmp";
+    int fd = open(tmppath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    fatal_if(fd < 0, "Can't open physical memory checkpoint file '%s'\n",
+             tmppath);
+
+    // Size the image up front so that the pages that are never written
+    // stay holes, and pad it to whole pages so that the last page can
+    // be mapped
+    fatal_if(ftruncate(fd, num_pages * pageSize),
+             "Setting size of physical memory checkpoint file '%s' "
+             "failed\n", tmppath);
+
+    // Only the main thread may call fatal(), so the workers just flag
+    // a failed write
+    std::atomic<bool> failed(false);
+    auto write_at = [&](const uint8_t *src, uint64_t len, uint64_t offset) {
+        while (len && !failed) {
+            ssize_t ret = pwrite(fd, src, len, offset);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0) {
+                failed = true;
+                return;
+            }
+            src += ret;
+            offset += ret;
+            len -= ret;
+        }
+    };
+
+    auto page_bytes = [&](uint64_t page) {
+        return std::min<uint64_t>(pageSize, range_size - page * pageSize);
+    };
+
+    // Write the runs of non-zero pages of each block of pages in
+    // parallel
+    const uint64_t pages_per_block = 4096;
+    parallelFor(checkpointThreads, divCeil(num_pages, pages_per_block),
+                [&](uint64_t b) {
+        const uint64_t end = std::min(num_pages, (b + 1) * pages_per_block);
+        uint64_t p = b * pages_per_block;
+        while (p < end) {
+            if (isZeroPage(pmem + p * pageSize, page_bytes(p))) {
+                p++;
+                continue;
+            }
+            uint64_t run_end = p + 1;
+            while (run_end < end &&
+                   !isZeroPage(pmem + run_end * pageSize,
+                               page_bytes(run_end))) {
+                run_end++;
+            }
+            const uint64_t offset = p * pageSize;
+            write_at(pmem + offset,
+                     std::min(run_end * pageSize, range_size) - offset,
+                     offset);
+            p = run_end;
+        }
+    });
+
+    fatal_if(failed, "Write failed on physical memory checkpoint file "
+             "'%s'\n", tmppath);
+    fatal_if(close(fd), "Close failed on physical memory checkpoint "
+             "file '%s'\n", tmppath);
+    fatal_if(rename(tmppath.c_str(), filepath.c_str()),
+             "Can't rename physical memory checkpoint file '%s' to '%s'\n",
+             tmppath, filepath);
+}
+
 void
 PhysicalMemory::unserialize(CheckpointIn &cp)
 {
@@ -429,6 +843,14 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
         unserializeStore(cp);
     }
 
+    // the memory now matches the checkpoint, so the next one can be a
+    // delta of it
+    if (deltaCheckpoint) {
+        for (auto &d : dirtyPages)
+            d->clear();
+        referenceCheckpoint = cp.getCptDir();
+    }
+
 }
 
 void
@@ -443,11 +865,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -462,6 +879,34 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // checkpoints without a format are in the original gzip one
+    std::string format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(format);
+    if (format == "sparse") {
+        unserializeSparseStore(filepath, range, pmem, true);
+        return;
+    } else if (format == "image") {
+        unserializeImageStore(filepath, backingStore[store_id]);
+        return;
+    } else if (format == "delta") {
+        // restore the checkpoint this one is based on first, in the
+        // same section, and then apply the pages that changed since
+        std::string base;
+        UNSERIALIZE_SCALAR(base);
+        DPRINTF(Checkpoint, "Physical memory %s is a delta of %s\n",
+                filename, base);
+        unserializeStore(cp.base(base));
+        unserializeSparseStore(filepath, range, pmem, false);
+        return;
+    }
+    fatal_if(format != "gzip",
+             "Unknown physical memory checkpoint format '%s'\n", format);
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -491,5 +936,223 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
               filename);
 }
 
+void
+PhysicalMemory::unserializeSparseStore(const std::string &filepath,
+                                       AddrRange range, uint8_t *pmem,
+                                       bool zero_missing)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open physical memory checkpoint file '%s'\n",
+             filepath);
+
+    // Called from the worker threads as well, so report failures to the
+    // caller rather than exiting from a worker
+    auto read_at = [&](void *buf, uint64_t len, uint64_t offset) {
+        uint8_t *dst = (uint8_t *)buf;
+        while (len) {
+            ssize_t ret = pread(fd, dst, len, offset);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0)
+                return false;
+            dst += ret;
+            offset += ret;
+            len -= ret;
+        }
+        return true;
+    };
+    auto read_or_fail = [&](void *buf, uint64_t len, uint64_t offset) {
+        fatal_if(!read_at(buf, len, offset), "Read failed on physical "
+                 "memory checkpoint file '%s'\n", filepath);
+    };
+
+    SparseHeader header;
+    read_or_fail(&header, sizeof(header), 0);
+    fatal_if(std::memcmp(header.magic, sparseMagic, sizeof(header.magic)) ||
+             letoh(header.version) != sparseVersion,
+             "Physical memory checkpoint file '%s' is not a sparse store\n",
+             filepath);
+
+    const uint64_t page_size = letoh(header.pageSize);
+    const uint64_t range_size = letoh(header.rangeSize);
+    const uint64_t num_pages = letoh(header.numPages);
+    const uint64_t pages_per_chunk = letoh(header.pagesPerChunk);
+    fatal_if(range_size != range.size(),
+             "Memory range size has changed! Saw %lld, expected %lld\n",
+             range_size, range.size());
+    fatal_if(page_size != pageSize,
+             "Page size of physical memory checkpoint file '%s' is %lld, "
+             "expected %lld\n", filepath, page_size, pageSize);
+    fatal_if(pages_per_chunk == 0,
+             "Physical memory checkpoint file '%s' has no pages per "
+             "chunk\n", filepath);
+
+    std::vector<uint64_t> pages(num_pages);
+    uint64_t offset = sizeof(header);
+    read_or_fail(pages.data(), num_pages * sizeof(uint64_t), offset);
+    offset += num_pages * sizeof(uint64_t);
+    for (auto &page : pages) {
+        page = letoh(page);
+        fatal_if(page * page_size >= range_size,
+                 "Page %#x out of range in physical memory checkpoint "
+                 "file '%s'\n", page, filepath);
+    }
+
+    const uint64_t num_chunks = divCeil(num_pages, pages_per_chunk);
+    std::vector<uint64_t> chunk_sizes(num_chunks);
+    read_or_fail(chunk_sizes.data(), num_chunks * sizeof(uint64_t), offset);
+    offset += num_chunks * sizeof(uint64_t);
+
+    std::vector<uint64_t> chunk_offsets(num_chunks);
+    for (uint64_t c = 0; c < num_chunks; c++) {
+        chunk_sizes[c] = letoh(chunk_sizes[c]);
+        chunk_offsets[c] = offset;
+        offset += chunk_sizes[c];
+    }
+
+    DPRINTF(Checkpoint, "Reading %d pages in %d chunks from %s\n",
+            num_pages, num_chunks, filepath);
+
+    auto page_bytes = [&](uint64_t page) {
+        return std::min(page_size, range_size - page * page_size);
+    };
+
+    // The store may hold data from before the restore, e.g. when it is
+    // shared or restored twice, so clear the pages the file leaves out.
+    // Pages that already read as zero are not written, which keeps the
+    // untouched parts of a fresh store unallocated.
+    if (zero_missing) {
+        const uint64_t range_pages = divCeil(range_size, page_size);
+        std::vector<bool> present(range_pages, false);
+        for (uint64_t page : pages)
+            present[page] = true;
+
+        const uint64_t pages_per_block = 4096;
+        parallelFor(checkpointThreads, divCeil(range_pages, pages_per_block),
+                    [&](uint64_t b) {
+            const uint64_t end =
+                std::min(range_pages, (b + 1) * pages_per_block);
+            for (uint64_t p = b * pages_per_block; p < end; p++) {
+                uint8_t *dst = pmem + p * page_size;
+                if (!present[p] && !isZeroPage(dst, page_bytes(p)))
+                    std::memset(dst, 0, page_bytes(p));
+            }
+        });
+    }
+
+    std::mutex error_lock;
+    std::string error;
+    auto set_error = [&](const std::string &msg) {
+        std::lock_guard<std::mutex> lock(error_lock);
+        if (error.empty())
+            error = msg;
+    };
+
+    parallelFor(checkpointThreads, num_chunks, [&](uint64_t c) {
+        const uint64_t begin = c * pages_per_chunk;
+        const uint64_t end = std::min(num_pages, begin + pages_per_chunk);
+
+        uint64_t raw_size = 0;
+        for (uint64_t p = begin; p < end; p++)
+            raw_size += page_bytes(pages[p]);
+
+        std::vector<uint8_t> compressed(chunk_sizes[c]);
+        if (!read_at(compressed.data(), compressed.size(),
+                     chunk_offsets[c])) {
+            set_error("Read failed");
+            return;
+        }
+
+        std::vector<uint8_t> raw(raw_size);
+        uLongf raw_len = raw_size;
+        if (uncompress(raw.data(), &raw_len, compressed.data(),
+                       compressed.size()) != Z_OK || raw_len != raw_size) {
+            set_error("Failed to decompress");
+            return;
+        }
+
+        const uint8_t *src = raw.data();
+        for (uint64_t p = begin; p < end; p++) {
+            const uint64_t len = page_bytes(pages[p]);
+            std::memcpy(pmem + pages[p] * page_size, src, len);
+            src += len;
+        }
+    });
+
+    close(fd);
+
+    fatal_if(!error.empty(), "%s physical memory checkpoint file '%s'\n",
+             error, filepath);
+}
+
+void
+PhysicalMemory::unserializeImageStore(const std::string &filepath,
+                                      const BackingStoreEntry &entry)
+{
+    const uint64_t range_size = entry.range.size();
+
+    int fd = open(filepath.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open physical memory checkpoint file '%s'\n",
+             filepath);
+
+    struct stat st;
+    fatal_if(fstat(fd, &st), "Can't stat physical memory checkpoint "
+             "file '%s'\n", filepath);
+    fatal_if((uint64_t)st.st_size < roundUp(range_size, pageSize),
+             "Physical memory checkpoint file '%s' is too small for a "
+             "range of size %lld\n", filepath, range_size);
+
+    if (entry.shmFd != -1) {
+        // Other processes see the backing store through the shared
+        // memory segment, so it cannot be replaced by a private
+        // mapping of the image and is filled in place instead
+        warn("Copying image %s into the shared backing store\n", filepath);
+
+        const uint64_t block_size = 1 << 20;
+        std::atomic<bool> failed(false);
+        parallelFor(checkpointThreads, divCeil(range_size, block_size),
+                    [&](uint64_t b) {
+            uint64_t offset = b * block_size;
+            uint64_t len = std::min(block_size, range_size - offset);
+            while (len && !failed) {
+                ssize_t ret = pread(fd, entry.pmem + offset, len, offset);
+                if (ret < 0 && errno == EINTR)
+                    continue;
+                if (ret <= 0) {
+                    failed = true;
+                    return;
+                }
+                offset += ret;
+                len -= ret;
+            }
+        });
+        fatal_if(failed, "Read failed on physical memory checkpoint "
+                 "file '%s'\n", filepath);
+    } else {
+        DPRINTF(Checkpoint, "Mapping %s copy-on-write at %#x\n",
+                filepath, (uint64_t)entry.pmem);
+
+        // Replace the anonymous mapping in place, which keeps the host
+        // pointers held by the memories valid
+        int map_flags = MAP_PRIVATE | MAP_FIXED;
+        if (mmapUsingNoReserve)
+            map_flags |= MAP_NORESERVE;
+
+        uint8_t *pmem = (uint8_t *)mmap(entry.pmem, range_size,
+                                        PROT_READ | PROT_WRITE, map_flags,
+                                        fd, 0);
+        if (pmem == (uint8_t *)MAP_FAILED) {
+            perror("mmap");
+            fatal("Could not map physical memory checkpoint file '%s'\n",
+                  filepath);
+        }
+        panic_if(pmem != entry.pmem, "Image %s mapped at the wrong address\n",
+                 filepath);
+    }
+
+    // the mapping keeps its own reference to the file
+    close(fd);
+}
+
 } // namespace memory
 } // namespace gem5
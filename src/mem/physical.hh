@@ -39,11 +39,13 @@
 #define __MEM_PHYSICAL_HH__
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "mem/dirty_page_map.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -158,10 +160,33 @@ class PhysicalMemory : public Serializable
 
     long pageSize;
 
+    // Write checkpoints in the sparse format instead of gzip
+    const bool sparseCheckpoint;
+
+    // Write checkpoints as uncompressed images that can be restored
+    // by mapping them copy-on-write
+    const bool imageCheckpoint;
+
+    // Write the checkpoints after the first one as deltas of the
+    // previous one
+    const bool deltaCheckpoint;
+
+    // Number of host threads used for sparse checkpoints, 0 for one
+    // per host core
+    const unsigned checkpointThreads;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // The pages of each backing store written since the last
+    // checkpoint, if delta checkpoints are enabled
+    std::vector<std::unique_ptr<DirtyPageMap>> dirtyPages;
+
+    // Directory of the checkpoint the dirty pages are relative to,
+    // empty if there is none yet. Taking a checkpoint moves it.
+    mutable std::string referenceCheckpoint;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +216,11 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   bool sparse_checkpoint=false,
+                   bool image_checkpoint=false,
+                   bool delta_checkpoint=false,
+                   unsigned checkpoint_threads=0);
 
     /**
      * Unmap all the backing store we have used.
@@ -245,6 +274,41 @@ class PhysicalMemory : public Serializable
     std::vector<BackingStoreEntry> getBackingStore() const
     { return backingStore; }
 
+    /**
+     * Stop tracking the pages written to a backing store, which is
+     * required when it is written without going through the memories,
+     * e.g. by a KVM guest. Delta checkpoints then hold every page of
+     * this store.
+     *
+     * @param store_id Index of the store in getBackingStore()
+     */
+    void untrackDirtyPages(unsigned store_id);
+
+    /**
+     * Mark a host range of a backing store as dirty, for requestors
+     * that write to it through a back door they requested for reading.
+     *
+     * @param host Host address of the start of the range
+     * @param size Size of the range
+     */
+    void markDirty(const uint8_t *host, uint64_t size);
+
+    /**
+     * Map part of a host file copy-on-write over the backing store of
+     * a range of guest memory, so that reading it does not require a
+     * copy. This is only possible if the range is a whole number of
+     * host pages in a private, non-interleaved backing store, and the
+     * file offset is host page aligned, and if the host can create
+     * another mapping.
+     *
+     * @param addr Start of the guest physical range
+     * @param size Size of the range
+     * @param fd Host file descriptor of the file
+     * @param offset Offset of the range in the file
+     * @return Whether the file was mapped
+     */
+    bool mapFile(Addr addr, uint64_t size, int fd, off_t offset);
+
     /**
      * Perform an untimed memory access and update all the state
      * (e.g. locked addresses) and statistics accordingly. The packet
@@ -284,6 +348,54 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Write a backing store in the sparse format. Only the pages that
+     * are not all zero are stored, in chunks of pages that are
+     * compressed in parallel. The file starts with a header and an
+     * index of the stored pages:
+     *
+     * - magic "GEM5SPRS", uint32 version, uint32 page size,
+     *   uint64 range size, uint64 number of stored pages,
+     *   uint32 pages per chunk, uint32 reserved
+     * - uint64 page number of each stored page, in increasing order
+     * - uint64 compressed size of each chunk
+     * - the zlib-compressed chunks, back to back
+     *
+     * All fields are little endian. util/cpt_upgrader.py converts
+     * between this format and the gzip one.
+     *
+     * @param filepath Path of the file to write
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeSparseStore(const std::string &filepath, AddrRange range,
+                              const uint8_t *pmem) const;
+
+    /**
+     * Write the given pages of a backing store in the sparse format,
+     * including the ones that are all zero.
+     *
+     * @param pages Numbers of the pages to write, in increasing order
+     */
+    void writeSparsePages(const std::string &filepath, AddrRange range,
+                          const uint8_t *pmem,
+                          const std::vector<uint64_t> &pages) const;
+
+    /**
+     * Write a backing store as an uncompressed image of the range,
+     * padded to a whole number of host pages. Pages that are all zero
+     * are left as holes, so the file is sparse on disk. The image is
+     * written to a temporary file that is then renamed over the
+     * target, so an image that is mapped by a running simulation is
+     * never modified in place.
+     *
+     * @param filepath Path of the file to write
+     * @param range The address range of this backing store
+     * @param pmem The host pointer to this backing store
+     */
+    void serializeImageStore(const std::string &filepath, AddrRange range,
+                             const uint8_t *pmem) const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
@@ -293,9 +405,36 @@ class PhysicalMemory : public Serializable
 
     /**
      * Unserialize a specific backing store, identified by a section.
+     * Delta stores first restore the store of the checkpoint they are
+     * based on, following the chain of checkpoints back to a full one.
      */
     void unserializeStore(CheckpointIn &cp);
 
+    /**
+     * Read a backing store written by serializeSparseStore() directly
+     * into the backing store, decompressing chunks in parallel.
+     *
+     * @param zero_missing Zero the pages that are not in the file. Set
+     *        for complete stores, clear when applying a delta on top of
+     *        the checkpoint it is based on.
+     */
+    void unserializeSparseStore(const std::string &filepath, AddrRange range,
+                                uint8_t *pmem, bool zero_missing);
+
+    /**
+     * Restore a backing store written by serializeImageStore() by
+     * mapping the image with MAP_PRIVATE over the existing backing
+     * store. Pages stay shared with every other process restoring
+     * from the same image through the host page cache until the
+     * simulation writes to them. The image must not be modified in
+     * place while the simulation runs; checkpoints written by
+     * serializeImageStore() replace the file instead. Backing stores
+     * that are shared with other processes (shared_backstore) are
+     * read into memory instead.
+     */
+    void unserializeImageStore(const std::string &filepath,
+                               const BackingStoreEntry &entry);
+
 };
 
 } // namespace memory
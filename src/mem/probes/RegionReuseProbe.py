@@ -0,0 +1,58 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.BaseMemProbe import BaseMemProbe
+from m5.params import *
+from m5.proxy import *
+
+
+class RegionReuseProbe(BaseMemProbe):
+    type = "RegionReuseProbe"
+    cxx_header = "mem/probes/region_reuse.hh"
+    cxx_class = "gem5::RegionReuseProbe"
+
+    system = Param.System(
+        Parent.any, "System pointer to filter out non-memory accesses"
+    )
+    line_size = Param.Unsigned(
+        Parent.cache_line_size, "Line size in bytes for reuse tracking"
+    )
+
+    sampling_rate = Param.Float(
+        0.01, "Initial fraction of the lines that are sampled"
+    )
+    max_sampled_lines = Param.Unsigned(
+        8192,
+        "Maximum number of sampled lines, the sampling rate is lowered "
+        "to stay below it (0 to disable)",
+    )
+
+    mrc_min_size = Param.MemorySize(
+        "4KiB", "Smallest cache size of the miss ratio curves"
+    )
+    mrc_max_size = Param.MemorySize(
+        "1GiB", "Largest cache size of the miss ratio curves"
+    )
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/region_reuse.hh"
+
+#include <algorithm>
+#include <string>
+
+#include "base/intmath.hh"
+#include "params/RegionReuseProbe.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Initial size of the logical time space */
+constexpr uint64_t minTimeSlots = 1024;
+
+std::string
+sizeName(uint64_t bytes)
+{
+    static const char *units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+    int unit = 0;
+    while (unit < 4 && bytes >= 1024 && bytes % 1024 == 0) {
+        bytes /= 1024;
+        unit++;
+    }
+    return std::to_string(bytes) + units[unit];
+}
+
+} // anonymous namespace
+
+RegionReuseProbe::RegionReuseProbe(const RegionReuseProbeParams &p)
+    : BaseMemProbe(p),
+      system(p.system),
+      lineSizeLg2(floorLog2(p.line_size)),
+      maxSampledLines(p.max_sampled_lines),
+      minCacheLinesLg2(floorLog2(p.mrc_min_size / p.line_size)),
+      maxCacheLinesLg2(floorLog2(p.mrc_max_size / p.line_size)),
+      threshold(p.sampling_rate * hashModulus),
+      rate(double(threshold) / hashModulus),
+      now(0),
+      epoch(0),
+      stats(this)
+{
+    fatal_if(!isPowerOf2(p.line_size),
+             "RegionReuseProbe expects line size is power of 2.");
+    fatal_if(p.sampling_rate <= 0 || p.sampling_rate > 1 || threshold == 0,
+             "RegionReuseProbe sampling rate must be in (0, 1], got %f.",
+             p.sampling_rate);
+    fatal_if(p.mrc_min_size < p.line_size ||
+             p.mrc_max_size < p.mrc_min_size,
+             "RegionReuseProbe miss ratio curve sizes are invalid.");
+    fatal_if(maxCacheLinesLg2 + 1 >= numBuckets,
+             "RegionReuseProbe miss ratio curve sizes are too large.");
+}
+
+RegionReuseProbe::RegionReuseProbeStats::RegionReuseProbeStats(
+    RegionReuseProbe *parent)
+    : statistics::Group(parent),
+      probe(*parent),
+      ADD_STAT(sampledAccesses, statistics::units::Count::get(),
+               "Number of sampled accesses"),
+      ADD_STAT(coldAccesses, statistics::units::Count::get(),
+               "Number of sampled accesses to lines not accessed before"),
+      ADD_STAT(footprint, statistics::units::Byte::get(),
+               "Estimated memory footprint"),
+      ADD_STAT(reuseDist, statistics::units::Count::get(),
+               "Number of sampled accesses per estimated reuse distance, in "
+               "lines"),
+      ADD_STAT(missRatio, statistics::units::Ratio::get(),
+               "Estimated miss ratio of a fully associative LRU cache per "
+               "cache size"),
+      ADD_STAT(samplingRate, statistics::units::Ratio::get(),
+               "Fraction of the lines that are sampled")
+{
+    using namespace statistics;
+
+    sampledAccesses.init(untaggedRow + 1).flags(nozero | nonan);
+    coldAccesses.init(untaggedRow + 1).flags(nozero | nonan);
+    footprint.init(untaggedRow + 1).flags(nozero | nonan);
+    reuseDist.init(untaggedRow + 1, numBuckets).flags(nozero | nonan);
+    missRatio
+        .init(allRow + 1,
+              parent->maxCacheLinesLg2 - parent->minCacheLinesLg2 + 1)
+        .flags(nozero | nonan);
+
+    for (int r = 0; r <= allRow; r++) {
+        const std::string name = r == untaggedRow ? "untagged" :
+                                 r == allRow ? "all" :
+                                 "region" + std::to_string(r);
+        if (r != allRow) {
+            sampledAccesses.subname(r, name);
+            coldAccesses.subname(r, name);
+            footprint.subname(r, name);
+            reuseDist.subname(r, name);
+        }
+        missRatio.subname(r, name);
+    }
+
+    reuseDist.ysubname(0, "0");
+    for (int b = 1; b < numBuckets; b++)
+        reuseDist.ysubname(b, std::to_string(1ULL << (b - 1)));
+
+    for (int k = parent->minCacheLinesLg2; k <= parent->maxCacheLinesLg2;
+         k++) {
+        missRatio.ysubname(k - parent->minCacheLinesLg2,
+                           sizeName(1ULL << (k + parent->lineSizeLg2)));
+    }
+
+    registerResetCallback([parent]() { parent->statReset(); });
+}
+
+void
+RegionReuseProbe::RegionReuseProbeStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    samplingRate = probe.rate;
+
+    // A sampled access misses in a cache of 2^k lines if it is cold or
+    // its reuse distance is at least 2^k lines, i.e., it falls in a
+    // bucket above k
+    const int num_sizes =
+        probe.maxCacheLinesLg2 - probe.minCacheLinesLg2 + 1;
+    std::vector<double> all_misses(num_sizes, 0);
+    double all_accesses = 0;
+    for (int r = 0; r <= untaggedRow; r++) {
+        const double accesses = sampledAccesses[r].value();
+        all_accesses += accesses;
+
+        double misses = coldAccesses[r].value();
+        for (int b = probe.maxCacheLinesLg2 + 2; b < numBuckets; b++)
+            misses += reuseDist[r][b].value();
+        for (int i = num_sizes - 1; i >= 0; i--) {
+            misses += reuseDist[r][probe.minCacheLinesLg2 + i + 1].value();
+            all_misses[i] += misses;
+            missRatio[r][i] = accesses ? misses / accesses : 0;
+        }
+    }
+    for (int i = 0; i < num_sizes; i++)
+        missRatio[allRow][i] = all_accesses ? all_misses[i] / all_accesses : 0;
+}
+
+uint64_t
+RegionReuseProbe::hashLine(Addr line)
+{
+    // 64-bit finalizer of MurmurHash3
+    line ^= line >> 33;
+    line *= 0xff51afd7ed558ccdULL;
+    line ^= line >> 33;
+    line *= 0xc4ceb9fe1a85ec53ULL;
+    line ^= line >> 33;
+    return line & (hashModulus - 1);
+}
+
+void
+RegionReuseProbe::markAccess(uint64_t time, int delta)
+{
+    for (uint64_t i = time + 1; i < lastAccesses.size(); i += i & -i)
+        lastAccesses[i] += delta;
+}
+
+uint64_t
+RegionReuseProbe::accessesBefore(uint64_t time) const
+{
+    uint64_t sum = 0;
+    for (uint64_t i = time; i > 0; i -= i & -i)
+        sum += lastAccesses[i];
+    return sum;
+}
+
+void
+RegionReuseProbe::compact()
+{
+    const uint64_t slots = std::max(minTimeSlots, 2 * lines.size());
+    std::vector<Addr> old_lines(slots, MaxAddr);
+    old_lines.swap(timeLines);
+    lastAccesses.assign(slots + 1, 0);
+
+    // Renumber the live lines in access order and rebuild the tree
+    now = 0;
+    for (Addr line : old_lines) {
+        if (line != MaxAddr) {
+            lines[line].time = now;
+            timeLines[now++] = line;
+        }
+    }
+    for (uint64_t i = 1; i <= slots; i++) {
+        lastAccesses[i] += i <= now;
+        const uint64_t parent = i + (i & -i);
+        if (parent <= slots)
+            lastAccesses[parent] += lastAccesses[i];
+    }
+}
+
+void
+RegionReuseProbe::shrinkSample()
+{
+    while (lines.size() > maxSampledLines) {
+        // Stop sampling the lines with the largest hash
+        threshold = linesByHash.top().first;
+        while (!linesByHash.empty() &&
+               linesByHash.top().first >= threshold) {
+            auto it = lines.find(linesByHash.top().second);
+            markAccess(it->second.time, -1);
+            timeLines[it->second.time] = MaxAddr;
+            lines.erase(it);
+            linesByHash.pop();
+        }
+    }
+    rate = double(threshold) / hashModulus;
+}
+
+void
+RegionReuseProbe::handleRequest(const probing::PacketInfo &pi)
+{
+    if (!(pi.cmd.isRead() || pi.cmd.isWrite()) ||
+        !system->isMemAddr(pi.addr)) {
+        return;
+    }
+
+    const Addr line = pi.addr >> lineSizeLg2;
+    const uint64_t hash = hashLine(line);
+    if (hash >= threshold)
+        return;
+
+    if (now == timeLines.size())
+        compact();
+
+    const int row = pi.region >= 0 && pi.region < MAX_CMD_REGIONS ?
+        pi.region : untaggedRow;
+    const double line_bytes = double(1ULL << lineSizeLg2) / rate;
+    stats.sampledAccesses[row]++;
+
+    auto it = lines.find(line);
+    if (it == lines.end()) {
+        stats.coldAccesses[row]++;
+        stats.footprint[row] += line_bytes;
+        it = lines.emplace(line, SampledLine{now, epoch}).first;
+        linesByHash.emplace(hash, line);
+    } else {
+        // Distinct sampled lines accessed since the last access
+        SampledLine &sl = it->second;
+        const uint64_t dist = (lines.size() - accessesBefore(sl.time + 1)) /
+            rate;
+        const int bucket = dist == 0 ? 0 :
+            std::min(floorLog2(dist) + 1, numBuckets - 1);
+        stats.reuseDist[row][bucket]++;
+
+        markAccess(sl.time, -1);
+        timeLines[sl.time] = MaxAddr;
+
+        if (sl.epoch != epoch) {
+            stats.footprint[row] += line_bytes;
+            sl.epoch = epoch;
+        }
+    }
+
+    it->second.time = now;
+    timeLines[now] = line;
+    markAccess(now, 1);
+    now++;
+
+    if (maxSampledLines && lines.size() > maxSampledLines)
+        shrinkSample();
+}
+
+void
+RegionReuseProbe::statReset()
+{
+    epoch++;
+}
+
+} // namespace gem5
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PROBES_REGION_REUSE_HH__
+#define __MEM_PROBES_REGION_REUSE_HH__
+
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "mem/packet.hh"
+#include "mem/probes/base.hh"
+#include "sim/stats.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+struct RegionReuseProbeParams;
+
+/**
+ * Probe that profiles the footprint and reuse distance of the memory
+ * regions registered with m5_add_mem_region, and estimates their miss
+ * ratio curves.
+ *
+ * Reuse (stack) distances are measured on the whole access stream, as
+ * seen by a fully associative LRU cache, and attributed to the region of
+ * each access. To keep the overhead low, only the lines whose address
+ * hash falls below a threshold are tracked (SHARDS spatial sampling), and
+ * distances measured among the sampled lines are scaled by the sampling
+ * rate. If max_sampled_lines is set, the threshold is lowered whenever
+ * more lines are tracked, which bounds memory use (fixed-size SHARDS).
+ */
+class RegionReuseProbe : public BaseMemProbe
+{
+  public:
+    RegionReuseProbe(const RegionReuseProbeParams &p);
+
+    /** Start a new footprint measurement on stat reset */
+    void statReset();
+
+  protected:
+    void handleRequest(const probing::PacketInfo &pkt_info) override;
+
+    /** Row of the stats used for accesses without a region */
+    static constexpr int untaggedRow = MAX_CMD_REGIONS;
+
+    /** Row of the miss ratio stats covering all accesses */
+    static constexpr int allRow = MAX_CMD_REGIONS + 1;
+
+    /** Number of reuse distance buckets, bucket b > 0 covers distances
+     * in [2^(b-1), 2^b) lines and bucket 0 covers immediate reuse */
+    static constexpr int numBuckets = 48;
+
+    /** Modulus of the sampling hash */
+    static constexpr uint64_t hashModulus = 1ULL << 24;
+
+    System *system;
+
+    /** Cache line size (log2) */
+    const uint8_t lineSizeLg2;
+
+    /** Maximum number of sampled lines, 0 if unbounded */
+    const uint64_t maxSampledLines;
+
+    /** Smallest and largest cache size of the miss ratio curves, in
+     * lines (log2) */
+    const int minCacheLinesLg2;
+    const int maxCacheLinesLg2;
+
+    /** Lines whose hash is below this threshold are sampled */
+    uint64_t threshold;
+
+    /** Current sampling rate, threshold / hashModulus */
+    double rate;
+
+    struct SampledLine
+    {
+        /** Logical time of the last access */
+        uint64_t time;
+        /** Footprint measurement the line was last counted in */
+        uint64_t epoch;
+    };
+
+    std::unordered_map<Addr, SampledLine> lines;
+
+    /** Sampled lines ordered by hash, used to lower the threshold */
+    std::priority_queue<std::pair<uint64_t, Addr>> linesByHash;
+
+    /**
+     * Fenwick tree over logical time with a one at the time of the last
+     * access of each sampled line. The number of distinct lines accessed
+     * after a given time is a suffix sum of the tree.
+     */
+    std::vector<uint32_t> lastAccesses;
+
+    /** The line accessed at each logical time, or MaxAddr */
+    std::vector<Addr> timeLines;
+
+    /** Next logical time */
+    uint64_t now;
+
+    /** Current footprint measurement */
+    uint64_t epoch;
+
+    /** SHARDS hash of a line address */
+    static uint64_t hashLine(Addr line);
+
+    void markAccess(uint64_t time, int delta);
+
+    /** Number of sampled lines last accessed before the given time */
+    uint64_t accessesBefore(uint64_t time) const;
+
+    /** Renumber the logical times when the tree is full */
+    void compact();
+
+    /** Lower the threshold until the sample fits in maxSampledLines */
+    void shrinkSample();
+
+    struct RegionReuseProbeStats : public statistics::Group
+    {
+        RegionReuseProbeStats(RegionReuseProbe *parent);
+
+        void preDumpStats() override;
+
+        RegionReuseProbe &probe;
+
+        /// Sampled accesses per region
+        statistics::Vector sampledAccesses;
+        /// Sampled accesses to lines not seen before, per region
+        statistics::Vector coldAccesses;
+        /// Estimated footprint per region
+        statistics::Vector footprint;
+        /// Sampled accesses per region and reuse distance bucket
+        statistics::Vector2d reuseDist;
+        /// Estimated miss ratio per region and cache size
+        statistics::Vector2d missRatio;
+        /// Current sampling rate
+        statistics::Scalar samplingRate;
+    };
+
+    RegionReuseProbeStats stats;
+};
+
+} // namespace gem5
+
+#endif //__MEM_PROBES_REGION_REUSE_HH__
@@ -115,16 +115,21 @@ Ramulator2::nbrOutstanding() const {
 }
 
 void Ramulator2::tick() {
-    // Only tick when it's timing mode
-    if (system()->isTimingMode()) {
-        ramulator2_memorysystem->tick();
-
-        // is the connected port waiting for a retry, if so check the
-        // state and send a retry if conditions have changed
-        if (retryReq) {
-            retryReq = false;
-            port.sendRetryReq();
-        }
+    // Only tick when it's timing mode. Atomic accesses do not go through
+    // the Ramulator2 memory system, so the clock stops until drainResume
+    // sees the system back in timing mode, which keeps fast-forwarding
+    // and functional warming from paying for an event every DRAM cycle.
+    if (!system()->isTimingMode()) {
+        return;
+    }
+
+    ramulator2_memorysystem->tick();
+
+    // is the connected port waiting for a retry, if so check the
+    // state and send a retry if conditions have changed
+    if (retryReq) {
+        retryReq = false;
+        port.sendRetryReq();
     }
 
     schedule(tickEvent, curTick() + ramulator2_memorysystem->get_tCK() * sim_clock::as_float::ns);
@@ -287,6 +292,14 @@ Ramulator2::drain() {
     return nbrOutstanding() != 0 ? DrainState::Draining : DrainState::Drained;
 }
 
+void
+Ramulator2::drainResume() {
+    // restart the clock after switching back to timing mode
+    if (system()->isTimingMode() && !tickEvent.scheduled()) {
+        schedule(tickEvent, clockEdge());
+    }
+}
+
 Ramulator2::MemorySystemPort::MemorySystemPort(const std::string &_name,
                                                Ramulator2 &_ramulator2)
     : ResponsePort(_name), ramulator2(_ramulator2) {}
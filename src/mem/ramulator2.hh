@@ -112,6 +112,7 @@ public:
     Ramulator2(const Params &p);
 
     DrainState drain() override;
+    void drainResume() override;
 
     virtual Port &getPort(const std::string &if_name,
                           PortID idx = InvalidPortID) override;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/common/MessagePool.hh"
+
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace message_pool
+{
+
+namespace
+{
+
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+constexpr std::size_t NumClasses = MaxPooledSize / Granularity;
+
+// The lists themselves are trivially destructible so that they stay
+// usable while other thread_local and static objects are torn down. The
+// drainer returns the free blocks to the heap when the thread exits, and
+// blocks freed after that go straight to the heap.
+thread_local FreeBlock *freeLists[NumClasses];
+thread_local bool drained = false;
+
+struct Drainer
+{
+    ~Drainer()
+    {
+        for (auto &head: freeLists) {
+            while (head) {
+                FreeBlock *next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+        drained = true;
+    }
+};
+
+thread_local Drainer drainer;
+
+std::size_t
+sizeClass(std::size_t bytes)
+{
+    return (bytes + Granularity - 1) / Granularity - 1;
+}
+
+} // anonymous namespace
+
+void *
+allocate(std::size_t bytes)
+{
+    if (bytes == 0 || bytes > MaxPooledSize)
+        return ::operator new(bytes);
+
+    std::size_t size_class = sizeClass(bytes);
+    FreeBlock *&head = freeLists[size_class];
+    if (!head)
+        return ::operator new((size_class + 1) * Granularity);
+
+    FreeBlock *block = head;
+    head = block->next;
+    return block;
+}
+
+void
+deallocate(void *p, std::size_t bytes)
+{
+    if (bytes == 0 || bytes > MaxPooledSize || drained) {
+        ::operator delete(p);
+        return;
+    }
+
+    // Touch the drainer so the lists get emptied at thread exit.
+    (void)drainer;
+    FreeBlock *&head = freeLists[sizeClass(bytes)];
+    FreeBlock *block = static_cast<FreeBlock *>(p);
+    block->next = head;
+    head = block;
+}
+
+std::size_t
+freeBlocks()
+{
+    std::size_t n = 0;
+    for (FreeBlock *head: freeLists) {
+        for (; head; head = head->next)
+            n++;
+    }
+    return n;
+}
+
+} // namespace message_pool
+
+} // namespace ruby
+} // namespace gem5
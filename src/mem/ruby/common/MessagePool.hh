@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_COMMON_MESSAGEPOOL_HH__
+#define __MEM_RUBY_COMMON_MESSAGEPOOL_HH__
+
+#include <cstddef>
+#include <new>
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * Free lists of fixed size blocks for Ruby messages.
+ *
+ * Every message hop allocates a new message and frees the old one, so
+ * going to the general purpose heap each time shows up in profiles of
+ * many-core protocols. Blocks are kept in per-thread free lists, one per
+ * 16 byte size class. A block may be freed on a different thread than the
+ * one that allocated it; it then simply moves to that thread's lists.
+ */
+namespace message_pool
+{
+
+/** Size classes are this many bytes apart. */
+constexpr std::size_t Granularity = 16;
+/** Larger requests go straight to the heap. */
+constexpr std::size_t MaxPooledSize = 2048;
+
+void *allocate(std::size_t bytes);
+void deallocate(void *p, std::size_t bytes);
+
+/** Number of free blocks held by the calling thread, for testing. */
+std::size_t freeBlocks();
+
+} // namespace message_pool
+
+/**
+ * Standard allocator on top of the message pool. Used with
+ * std::allocate_shared, it puts the reference count in the same pooled
+ * block as the message.
+ */
+template <class T>
+class MessagePoolAllocator
+{
+  public:
+    using value_type = T;
+
+    MessagePoolAllocator() = default;
+
+    template <class U>
+    MessagePoolAllocator(const MessagePoolAllocator<U> &) {}
+
+    T *
+    allocate(std::size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Over-aligned types can't come from the message pool");
+        return static_cast<T *>(message_pool::allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, std::size_t n)
+    {
+        message_pool::deallocate(p, n * sizeof(T));
+    }
+
+    template <class U>
+    bool operator==(const MessagePoolAllocator<U> &) const { return true; }
+    template <class U>
+    bool operator!=(const MessagePoolAllocator<U> &) const { return false; }
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_MESSAGEPOOL_HH__
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "mem/ruby/common/MessagePool.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+struct TestMessage
+{
+    TestMessage(int v) : value(v) { ++live; }
+    ~TestMessage() { --live; }
+
+    int value;
+    char payload[100];
+
+    static int live;
+};
+
+int TestMessage::live = 0;
+
+std::shared_ptr<TestMessage>
+makeTestMessage(int v)
+{
+    return std::allocate_shared<TestMessage>(
+        MessagePoolAllocator<TestMessage>(), v);
+}
+
+} // anonymous namespace
+
+TEST(MessagePool, ReusesFreedBlocks)
+{
+    void *a = message_pool::allocate(100);
+    message_pool::deallocate(a, 100);
+    std::size_t free_blocks = message_pool::freeBlocks();
+
+    // Any size in the same class gets the block back.
+    void *b = message_pool::allocate(97);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(message_pool::freeBlocks(), free_blocks - 1);
+
+    // A different class does not.
+    void *c = message_pool::allocate(200);
+    EXPECT_NE(c, b);
+
+    message_pool::deallocate(b, 97);
+    message_pool::deallocate(c, 200);
+}
+
+TEST(MessagePool, LargeBlocksAreNotPooled)
+{
+    std::size_t free_blocks = message_pool::freeBlocks();
+    void *p = message_pool::allocate(message_pool::MaxPooledSize + 1);
+    message_pool::deallocate(p, message_pool::MaxPooledSize + 1);
+    EXPECT_EQ(message_pool::freeBlocks(), free_blocks);
+}
+
+TEST(MessagePool, SharedMessages)
+{
+    void *first;
+    {
+        auto msg = makeTestMessage(1);
+        std::shared_ptr<TestMessage> copy = msg;
+        EXPECT_EQ(TestMessage::live, 1);
+        EXPECT_EQ(copy->value, 1);
+        first = msg.get();
+    }
+    EXPECT_EQ(TestMessage::live, 0);
+
+    // The control block shares the allocation, so the next message of the
+    // same type lands in the same block.
+    auto msg = makeTestMessage(2);
+    EXPECT_EQ(msg.get(), first);
+    EXPECT_EQ(msg->value, 2);
+}
+
+TEST(MessagePool, FreeOnAnotherThread)
+{
+    auto msg = makeTestMessage(3);
+    std::thread t([&msg]() { msg.reset(); });
+    t.join();
+    EXPECT_EQ(TestMessage::live, 0);
+
+    // Blocks left behind by an exited thread are safe to allocate again.
+    std::thread u([]() {
+        for (int i = 0; i < 100; i++)
+            makeTestMessage(i);
+    });
+    u.join();
+    EXPECT_EQ(TestMessage::live, 0);
+}
@@ -48,6 +48,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <string>
@@ -92,11 +93,9 @@ class MessageBuffer : public SimObject
     void
     delayHead(Tick current_time, Tick delta)
     {
-        MsgPtr m = m_prio_heap.front();
-        std::pop_heap(m_prio_heap.begin(), m_prio_heap.end(),
-                      std::greater<MsgPtr>());
-        m_prio_heap.pop_back();
-        enqueue(m, current_time, delta);
+        MsgPtr m = std::move(m_msg_queue.front());
+        m_msg_queue.pop_front();
+        enqueue(std::move(m), current_time, delta);
     }
 
     bool areNSlotsAvailable(unsigned int n, Tick curTime);
@@ -121,7 +120,7 @@ class MessageBuffer : public SimObject
     //! message queue.  The function assumes that the queue is nonempty.
     const Message* peek() const;
 
-    const MsgPtr &peekMsgPtr() const { return m_prio_heap.front(); }
+    const MsgPtr &peekMsgPtr() const { return m_msg_queue.front(); }
 
     void enqueue(MsgPtr message, Tick curTime, Tick delta,
                 bool bypassStrictFIFO = false);
@@ -146,7 +145,7 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool isEmpty() const { return m_msg_queue.empty(); }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -196,13 +195,24 @@ class MessageBuffer : public SimObject
   private:
     void reanalyzeList(std::list<MsgPtr> &, Tick);
 
+    /** Insert a message into m_msg_queue at its place in arrival order. */
+    void insertMessage(MsgPtr message);
+
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
     Consumer* m_consumer;
-    std::vector<MsgPtr> m_prio_heap;
+
+    /**
+     * Messages ordered by arrival tick and, within a tick, by message
+     * counter: the same order a priority heap on those keys would pop them
+     * in. Messages for each tick sit next to each other, and nearly all
+     * enqueues land at the back and all dequeues at the front, so both are
+     * constant time instead of a heap sift.
+     */
+    std::deque<MsgPtr> m_msg_queue;
 
     std::function<void()> m_dequeue_callback;
 
@@ -213,14 +223,14 @@ class MessageBuffer : public SimObject
     /**
      * A map from line addresses to lists of stalled messages for that line.
      * If this buffer allows the receiver to stall messages, on a stall
-     * request, the stalled message is removed from the m_prio_heap and placed
+     * request, the stalled message is removed from the m_msg_queue and placed
      * in the m_stall_msg_map. Messages are held there until the receiver
      * requests they be reanalyzed, at which point they are moved back to
-     * m_prio_heap.
+     * m_msg_queue.
      *
      * NOTE: The stall map holds messages in the order in which they were
      * initially received, and when a line is unblocked, the messages are
-     * moved back to the m_prio_heap in the same order. This prevents starving
+     * moved back to the m_msg_queue in the same order. This prevents starving
      * older requests with younger ones.
      */
     StallMsgMapType m_stall_msg_map;
@@ -237,7 +247,7 @@ class MessageBuffer : public SimObject
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
      * ensure that if the buffer is finite-sized, it blocks further requests
-     * when the m_prio_heap and m_stall_msg_map contain m_max_size messages.
+     * when the m_msg_queue and m_stall_msg_map contain m_max_size messages.
      */
     int m_stall_map_size;
 
@@ -69,6 +69,10 @@ CrossbarSwitch::wakeup()
             "at time: %lld\n",
             m_router->get_id(), m_router->curCycle());
 
+    // Nothing won the switch, no need to look at every input
+    if (m_num_flits == 0)
+        return;
+
     for (auto& switch_buffer : switchBuffers) {
         if (!switch_buffer.isReady(curTick())) {
             continue;
@@ -86,6 +90,7 @@ CrossbarSwitch::wakeup()
             // in the next cycle
             m_router->getOutputUnit(outport)->insert_flit(t_flit);
             switch_buffer.getTopFlit();
+            m_num_flits--;
             m_crossbar_activity++;
         }
     }
@@ -116,9 +116,15 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
+        assert(m_num_flits > 0);
+        m_num_flits--;
         return virtualChannels[vc].getTopFlit();
     }
 
+    // Whether any input VC of this port holds a flit. Ports without
+    // flits can't take part in switch allocation and are skipped.
+    inline bool has_flits() const { return m_num_flits > 0; }
+
     inline bool
     need_stage(int vc, flit_stage stage, Tick time)
     {
@@ -168,6 +174,8 @@ class InputUnit : public Consumer
 
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
+    // Number of flits buffered across all input VCs
+    int m_num_flits = 0;
 
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
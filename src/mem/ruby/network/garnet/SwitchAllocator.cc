@@ -55,6 +55,7 @@ SwitchAllocator::SwitchAllocator(Router *router)
 
     m_input_arbiter_activity = 0;
     m_output_arbiter_activity = 0;
+    m_num_port_requests = 0;
 }
 
 void
@@ -113,11 +114,15 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
+        auto input_unit = m_router->getInputUnit(inport);
+
+        // An input without flits has nothing to arbitrate for
+        if (!input_unit->has_flits())
+            continue;
+
         int invc = m_round_robin_invc[inport];
 
         for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
-
             if (input_unit->need_stage(invc, SA_, curTick())) {
                 // This flit is in SA stage
 
@@ -133,6 +138,7 @@ SwitchAllocator::arbitrate_inports()
                     m_input_arbiter_activity++;
                     m_port_requests[inport] = outport;
                     m_vc_winners[inport] = invc;
+                    m_num_port_requests++;
 
                     break; // got one vc winner for this port
                 }
@@ -166,6 +172,10 @@ SwitchAllocator::arbitrate_outports()
     // Again do round robin arbitration on these requests
     // Independent arbiter at each output port
     for (int outport = 0; outport < m_num_outports; outport++) {
+        // Every request has been granted, the other outports have none
+        if (m_num_port_requests == 0)
+            break;
+
         int inport = m_round_robin_inport[outport];
 
         for (int inport_iter = 0; inport_iter < m_num_inports;
@@ -241,6 +251,7 @@ SwitchAllocator::arbitrate_outports()
 
                 // remove this request
                 m_port_requests[inport] = -1;
+                m_num_port_requests--;
 
                 // Update Round Robin pointer
                 m_round_robin_inport[outport] = inport + 1;
@@ -363,8 +374,12 @@ SwitchAllocator::check_for_wakeup()
     }
 
     for (int i = 0; i < m_num_inports; i++) {
+        auto input_unit = m_router->getInputUnit(i);
+        if (!input_unit->has_flits())
+            continue;
+
         for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+            if (input_unit->need_stage(j, SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
@@ -386,7 +401,11 @@ SwitchAllocator::get_vnet(int invc)
 void
 SwitchAllocator::clear_request_vector()
 {
+    if (m_num_port_requests == 0)
+        return;
+
     std::fill(m_port_requests.begin(), m_port_requests.end(), -1);
+    m_num_port_requests = 0;
 }
 
 void
@@ -32,9 +32,11 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_FLIT_HH__
 
 #include <cassert>
+#include <cstddef>
 #include <iostream>
 
 #include "base/types.hh"
+#include "mem/ruby/common/MessagePool.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
 #include "mem/ruby/slicc_interface/Message.hh"
 
@@ -56,6 +58,20 @@ class flit
 
     virtual ~flit(){};
 
+    // Flits and credits are created and freed at every hop, take them
+    // from the message pool rather than the heap
+    static void *
+    operator new(std::size_t size)
+    {
+        return message_pool::allocate(size);
+    }
+
+    static void
+    operator delete(void *p, std::size_t size)
+    {
+        message_pool::deallocate(p, size);
+    }
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
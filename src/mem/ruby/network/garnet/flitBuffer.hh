@@ -32,6 +32,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_FLITBUFFER_HH__
 
 #include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <vector>
 
@@ -47,6 +48,11 @@ namespace ruby
 namespace garnet
 {
 
+/**
+ * FIFO of flits. The flits are kept in a ring buffer that doubles when it
+ * is full, so once it has reached the occupancy of the buffer it models
+ * no more allocations happen.
+ */
 class flitBuffer
 {
   public:
@@ -58,33 +64,51 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_count; }
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        m_buffer.pop_front();
+        assert(m_count > 0);
+        flit *f = m_buffer[m_head];
+        m_head = (m_head + 1) & (m_buffer.size() - 1);
+        m_count--;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        assert(m_count > 0);
+        return m_buffer[m_head];
     }
 
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
+        if (m_count == m_buffer.size())
+            grow();
+        m_buffer[(m_head + m_count) & (m_buffer.size() - 1)] = flt;
+        m_count++;
     }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *pkt);
 
   private:
-    std::deque<flit *> m_buffer;
+    // The i-th flit from the top of the buffer
+    flit *
+    at(unsigned i) const
+    {
+        return m_buffer[(m_head + i) & (m_buffer.size() - 1)];
+    }
+
+    void grow();
+
+    // Ring storage, its size is always zero or a power of two
+    std::vector<flit *> m_buffer;
+    unsigned m_head = 0;
+    unsigned m_count = 0;
     int max_size;
 };
 
@@ -341,7 +341,7 @@ bool AbstractController::recvTimingResp(PacketPtr pkt) {
         return false;
     }
 
-    std::shared_ptr<MemoryMsg> msg = std::make_shared<MemoryMsg>(clockEdge());
+    std::shared_ptr<MemoryMsg> msg = makeMessage<MemoryMsg>(clockEdge());
     (*msg).m_addr = pkt->getAddr();
     (*msg).m_Sender = m_machineID;
 
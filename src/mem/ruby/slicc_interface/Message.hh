@@ -44,8 +44,10 @@
 #include <iostream>
 #include <memory>
 #include <stack>
+#include <utility>
 
 #include "mem/packet.hh"
+#include "mem/ruby/common/MessagePool.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/protocol/MessageSizeType.hh"
@@ -132,6 +134,19 @@ class Message
     int vnet;
 };
 
+/**
+ * Create a message. The message and its reference count share one block
+ * from the message pool, which is much cheaper than std::make_shared for
+ * the short lived messages Ruby sends on every hop.
+ */
+template <class T, class... Args>
+std::shared_ptr<T>
+makeMessage(Args&&... args)
+{
+    return std::allocate_shared<T>(MessagePoolAllocator<T>(),
+                                   std::forward<Args>(args)...);
+}
+
 inline bool
 operator>(const MsgPtr &lhs, const MsgPtr &rhs)
 {
@@ -125,14 +125,14 @@ RubyPrefetcherProxy::issuePrefetch()
                                     RubyRequestType_ST : RubyRequestType_LD;
 
                 std::shared_ptr<RubyRequest> msg =
-                    std::make_shared<RubyRequest>(cacheCntrl->clockEdge(),
-                                                  pkt->getAddr(),
-                                                  blk_size,
-                                                  0, // pc
-                                                  req_type,
-                                                  RubyAccessMode_Supervisor,
-                                                  pkt,
-                                                  PrefetchBit_Yes);
+                    makeMessage<RubyRequest>(cacheCntrl->clockEdge(),
+                                             pkt->getAddr(),
+                                             blk_size,
+                                             0, // pc
+                                             req_type,
+                                             RubyAccessMode_Supervisor,
+                                             pkt,
+                                             PrefetchBit_Yes);
 
                 // enqueue request into prefetch queue to the cache
                 pfQueue->enqueue(msg, cacheCntrl->clockEdge(),
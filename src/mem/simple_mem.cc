@@ -112,7 +112,7 @@ void
 SimpleMemory::recvMemBackdoorReq(const MemBackdoorReq &req,
         MemBackdoorPtr &_backdoor)
 {
-    getBackdoor(_backdoor);
+    getBackdoor(_backdoor, req.writeable());
 }
 
 bool
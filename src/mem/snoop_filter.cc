@@ -384,6 +384,22 @@ void SnoopFilter::updateResponse(const Packet *cpkt, const ResponsePort &
             __func__, sf_item.requested, sf_item.holder);
 }
 
+void SnoopFilter::addHolder(const Packet *cpkt,
+                            const ResponsePort &cpu_side_port) {
+    if (cpkt->req->isUncacheable() || !cpu_side_port.isSnooping())
+        return;
+
+    Addr line_addr = cpkt->getBlockAddr(linesize);
+    if (cpkt->isSecure()) {
+        line_addr |= LineSecure;
+    }
+    SnoopItem &sf_item = cachedLocations[line_addr];
+    sf_item.holder |= portToMask(cpu_side_port);
+    DPRINTF(SnoopFilter, "%s: src %s packet %s SF value %x.%x\n", __func__,
+            cpu_side_port.name(), cpkt->print(), sf_item.requested,
+            sf_item.holder);
+}
+
 SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
     : statistics::Group(parent),
       ADD_STAT(totRequests, statistics::units::Count::get(),
@@ -195,6 +195,17 @@ public:
      */
     void updateResponse(const Packet *cpkt, const ResponsePort &cpu_side_port);
 
+    /**
+     * Record that a cache above a CPU-side port holds a block it
+     * allocated without the snoop filter seeing the request, as done
+     * by functional warming. Stale holders are harmless, missing ones
+     * are not, so the holder is only ever added.
+     *
+     * @param cpkt          Pointer to the refresh packet of the block.
+     * @param cpu_side_port ResponsePort the refresh came from.
+     */
+    void addHolder(const Packet *cpkt, const ResponsePort &cpu_side_port);
+
     virtual void regStats();
 
 protected:
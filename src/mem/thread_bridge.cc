@@ -27,15 +27,182 @@
 
 #include "mem/thread_bridge.hh"
 
+#include <algorithm>
+
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "sim/eventq.hh"
+#include "sim/simulate.hh"
 
 namespace gem5
 {
 
 ThreadBridge::ThreadBridge(const ThreadBridgeParams &p)
-    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this)
+    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this),
+      delay(p.delay), inQueue(getEventQueue(p.in_eventq_index)),
+      requests(*this, name() + ".requests",
+               [this](PacketPtr pkt) { return out_port_.sendTimingReq(pkt); }),
+      responses(*this, name() + ".responses",
+                [this](PacketPtr pkt) {
+                    return in_port_.sendTimingResp(pkt);
+                })
+{
+}
+
+ThreadBridge::~ThreadBridge()
+{
+    if (quantumCallback != -1)
+        unregisterQuantumCallback(quantumCallback);
+}
+
+void
+ThreadBridge::init()
+{
+    const bool direct = inQueue == eventQueue();
+    requests.setQueue(eventQueue(), direct);
+    responses.setQueue(inQueue, direct);
+
+    if (!direct)
+        quantumCallback = registerQuantumCallback([this]() { sync(); });
+}
+
+Tick
+ThreadBridge::deliveryTick(PacketPtr pkt) const
+{
+    // like the Bridge, account for the header and payload delay here
+    // rather than passing it on
+    const Tick when = curTick() + delay + pkt->headerDelay +
+        pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+    return when;
+}
+
+void
+ThreadBridge::sync()
+{
+    requests.sync();
+    responses.sync();
+    checkDrained();
+}
+
+void
+ThreadBridge::checkDrained()
+{
+    if (drainState() == DrainState::Draining && requests.empty() &&
+        responses.empty()) {
+        signalDrainDone();
+    }
+}
+
+DrainState
+ThreadBridge::drain()
+{
+    return requests.empty() && responses.empty() ?
+        DrainState::Drained : DrainState::Draining;
+}
+
+ThreadBridge::Channel::Channel(ThreadBridge &bridge, const std::string &name,
+                               std::function<bool(PacketPtr)> send)
+    : bridge(bridge), send(std::move(send)),
+      deliverEvent([this]() { deliver(); }, name)
+{
+}
+
+void
+ThreadBridge::Channel::setQueue(EventQueue *receiver, bool is_direct)
+{
+    queue = receiver;
+    direct = is_direct;
+}
+
+void
+ThreadBridge::Channel::post(PacketPtr pkt, Tick when)
+{
+    if (!direct) {
+        outbox.emplace_back(when, pkt);
+        return;
+    }
+
+    // the delivery tick includes the delays of the packet itself, so
+    // packets are not posted in tick order
+    auto pos = std::upper_bound(inbox.begin(), inbox.end(), when,
+                                [](Tick t, const auto &queued) {
+                                    return t < queued.first;
+                                });
+    inbox.emplace(pos, when, pkt);
+    scheduleDelivery();
+}
+
+void
+ThreadBridge::Channel::sync()
+{
+    if (outbox.empty())
+        return;
+
+    // keep the inbox sorted by delivery tick, and packets due at the
+    // same tick in the order they were posted
+    auto by_tick = [](const auto &a, const auto &b) {
+        return a.first < b.first;
+    };
+    std::stable_sort(outbox.begin(), outbox.end(), by_tick);
+    const auto old_size = inbox.size();
+    inbox.insert(inbox.end(), outbox.begin(), outbox.end());
+    outbox.clear();
+    std::inplace_merge(inbox.begin(), inbox.begin() + old_size,
+                       inbox.end(), by_tick);
+
+    scheduleDelivery();
+}
+
+void
+ThreadBridge::Channel::scheduleDelivery()
 {
+    if (waitingRetry || inbox.empty())
+        return;
+
+    const Tick when = std::max(inbox.front().first, queue->getCurTick());
+    if (!deliverEvent.scheduled())
+        queue->schedule(&deliverEvent, when);
+    else if (deliverEvent.when() > when)
+        queue->reschedule(&deliverEvent, when);
+}
+
+void
+ThreadBridge::Channel::retry()
+{
+    assert(waitingRetry);
+    waitingRetry = false;
+    deliver();
+}
+
+void
+ThreadBridge::Channel::deliver()
+{
+    while (!inbox.empty() && inbox.front().first <= curTick()) {
+        if (!send(inbox.front().second)) {
+            waitingRetry = true;
+            return;
+        }
+        inbox.pop_front();
+    }
+
+    if (!inbox.empty()) {
+        scheduleDelivery();
+    } else if (direct) {
+        bridge.checkDrained();
+    }
+}
+
+bool
+ThreadBridge::Channel::trySatisfyFunctional(PacketPtr pkt, bool sender) const
+{
+    // the outbox belongs to the sending thread and the inbox to the
+    // receiving one, so only look at the side the caller owns
+    for (const auto &queued : sender ? outbox : inbox) {
+        if (pkt->trySatisfyFunctional(queued.second))
+            return true;
+    }
+    return false;
 }
 
 ThreadBridge::IncomingPort::IncomingPort(const std::string &name,
@@ -54,12 +221,23 @@ ThreadBridge::IncomingPort::getAddrRanges() const
 bool
 ThreadBridge::IncomingPort::recvTimingReq(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    fatal_if(device_.inQueue != device_.eventQueue() &&
+             device_.delay < simQuantum,
+             "%s: Delay of %d ticks is below the simulation quantum of %d "
+             "ticks.\n", device_.name(), device_.delay, simQuantum);
+
+    device_.requests.post(pkt, device_.deliveryTick(pkt));
+    return true;
 }
 void
 ThreadBridge::IncomingPort::recvRespRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.responses.retry();
+}
+bool
+ThreadBridge::IncomingPort::recvTimingSnoopResp(PacketPtr pkt)
+{
+    return device_.out_port_.sendTimingSnoopResp(pkt);
 }
 
 // AtomicResponseProtocol
@@ -74,7 +252,23 @@ ThreadBridge::IncomingPort::recvAtomic(PacketPtr pkt)
 void
 ThreadBridge::IncomingPort::recvFunctional(PacketPtr pkt)
 {
+    pkt->pushLabel(name());
+
+    // check the packets in flight, on this side first
+    if (device_.responses.trySatisfyFunctional(pkt, false) ||
+        device_.requests.trySatisfyFunctional(pkt, true)) {
+        pkt->popLabel();
+        return;
+    }
+
     EventQueue::ScopedMigration migrate(device_.eventQueue());
+    if (device_.responses.trySatisfyFunctional(pkt, true) ||
+        device_.requests.trySatisfyFunctional(pkt, false)) {
+        pkt->popLabel();
+        return;
+    }
+
+    pkt->popLabel();
     device_.out_port_.sendFunctional(pkt);
 }
 
@@ -90,16 +284,49 @@ ThreadBridge::OutgoingPort::recvRangeChange()
     device_.in_port_.sendRangeChange();
 }
 
+bool
+ThreadBridge::OutgoingPort::isSnooping() const
+{
+    // pass snoops on to caches behind the bridge, so that functional
+    // accesses on this side see their data
+    return device_.in_port_.isSnooping();
+}
+
 // TimingRequestProtocol
 bool
 ThreadBridge::OutgoingPort::recvTimingResp(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.responses.post(pkt, device_.deliveryTick(pkt));
+    return true;
 }
 void
 ThreadBridge::OutgoingPort::recvReqRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.requests.retry();
+}
+void
+ThreadBridge::OutgoingPort::recvTimingSnoopReq(PacketPtr pkt)
+{
+    fatal_if(device_.inQueue != device_.eventQueue(),
+             "%s: Timing snoops cannot cross threads. The caches on the "
+             "two sides of the bridge must not share memory.\n", name());
+    device_.in_port_.sendTimingSnoopReq(pkt);
+}
+
+// AtomicRequestProtocol
+Tick
+ThreadBridge::OutgoingPort::recvAtomicSnoop(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(device_.inQueue);
+    return device_.in_port_.sendAtomicSnoop(pkt);
+}
+
+// FunctionalRequestProtocol
+void
+ThreadBridge::OutgoingPort::recvFunctionalSnoop(PacketPtr pkt)
+{
+    EventQueue::ScopedMigration migrate(device_.inQueue);
+    device_.in_port_.sendFunctionalSnoop(pkt);
 }
 
 Port &
@@ -28,8 +28,15 @@
 #ifndef __MEM_THREAD_BRIDGE_HH__
 #define __MEM_THREAD_BRIDGE_HH__
 
+#include <deque>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "mem/packet.hh"
 #include "mem/port.hh"
 #include "params/ThreadBridge.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -39,11 +46,75 @@ class ThreadBridge : public SimObject
 {
   public:
     explicit ThreadBridge(const ThreadBridgeParams &p);
+    ~ThreadBridge() override;
 
     Port &getPort(const std::string &if_name,
                   PortID idx = InvalidPortID) override;
 
+    void init() override;
+
+    DrainState drain() override;
+
   private:
+    /**
+     * Timing packets travelling in one direction. A sender posts packets
+     * to the outbox during a quantum, and they move to the inbox of the
+     * receiver at the next quantum boundary. Packets are delivered at
+     * the tick they were posted for, which includes their own header
+     * and payload delays, so the inbox is kept sorted by that tick.
+     * Packets due at the same tick keep the order they were posted. As
+     * that is at least a quantum ahead, a packet never arrives in the
+     * past of the receiver, and the receiver sees the same packets at
+     * the same ticks however the threads happen to interleave.
+     *
+     * When both sides share an event queue, packets go straight to the
+     * inbox.
+     */
+    class Channel
+    {
+      public:
+        Channel(ThreadBridge &bridge, const std::string &name,
+                std::function<bool(PacketPtr)> send);
+
+        /** Set up the queue of the receiving side. */
+        void setQueue(EventQueue *receiver, bool direct);
+
+        /** Post a packet from the sending side. */
+        void post(PacketPtr pkt, Tick when);
+
+        /** Hand the posted packets to the receiver, at a barrier. */
+        void sync();
+
+        /** The receiver can accept packets again. */
+        void retry();
+
+        bool empty() const { return outbox.empty() && inbox.empty(); }
+
+        /**
+         * Try to satisfy a functional access from the packets owned by
+         * the sending side, or the receiving side.
+         */
+        bool trySatisfyFunctional(PacketPtr pkt, bool sender) const;
+
+      private:
+        void deliver();
+
+        /** Schedule delivery for the earliest packet in the inbox. */
+        void scheduleDelivery();
+
+        ThreadBridge &bridge;
+        std::function<bool(PacketPtr)> send;
+
+        EventQueue *queue = nullptr;
+        bool direct = true;
+
+        std::deque<std::pair<Tick, PacketPtr>> outbox;
+        std::deque<std::pair<Tick, PacketPtr>> inbox;
+
+        EventFunctionWrapper deliverEvent;
+        bool waitingRetry = false;
+    };
+
     class IncomingPort : public ResponsePort
     {
       public:
@@ -53,6 +124,7 @@ class ThreadBridge : public SimObject
         // TimingResponseProtocol
         bool recvTimingReq(PacketPtr pkt) override;
         void recvRespRetry() override;
+        bool recvTimingSnoopResp(PacketPtr pkt) override;
 
         // AtomicResponseProtocol
         Tick recvAtomic(PacketPtr pkt) override;
@@ -69,17 +141,46 @@ class ThreadBridge : public SimObject
       public:
         OutgoingPort(const std::string &name, ThreadBridge &device);
         void recvRangeChange() override;
+        bool isSnooping() const override;
 
         // TimingRequestProtocol
         bool recvTimingResp(PacketPtr pkt) override;
         void recvReqRetry() override;
+        void recvTimingSnoopReq(PacketPtr pkt) override;
+
+        // AtomicRequestProtocol
+        Tick recvAtomicSnoop(PacketPtr pkt) override;
+
+        // FunctionalRequestProtocol
+        void recvFunctionalSnoop(PacketPtr pkt) override;
 
       private:
         ThreadBridge &device_;
     };
 
+    /** Tick at which a packet received now is delivered. */
+    Tick deliveryTick(PacketPtr pkt) const;
+
+    /** Exchange packets between the threads at a quantum boundary. */
+    void sync();
+
+    /** Signal the end of draining once no packets are in flight. */
+    void checkDrained();
+
     IncomingPort in_port_;
     OutgoingPort out_port_;
+
+    /** Latency of timing packets, the lookahead between the threads. */
+    const Tick delay;
+
+    /** Event queue of the in_port side. */
+    EventQueue *inQueue;
+
+    Channel requests;
+    Channel responses;
+
+    /** Id of the quantum callback of the bridge, -1 if none. */
+    int quantumCallback = -1;
 };
 
 }  // namespace gem5
@@ -45,10 +45,13 @@
 
 #include "mem/translating_port_proxy.hh"
 
+#include <cstring>
+
 #include "arch/generic/mmu.hh"
 #include "base/chunk_generator.hh"
 #include "cpu/base.hh"
 #include "cpu/thread_context.hh"
+#include "mem/port.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -63,6 +66,14 @@ bool
 TranslatingPortProxy::tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
         std::function<void(const TranslationGen::Range &)> func) const
 {
+    // Translations which haven't been passed to func() yet.
+    TranslationGen::Range pending{0, 0, 0, NoFault};
+    auto flush = [&pending, &func]() {
+        if (pending.size)
+            func(pending);
+        pending.size = 0;
+    };
+
     // Wether we're trying to get past a fault.
     bool faulting = false;
     for (const auto &range: *gen) {
@@ -70,29 +81,80 @@ TranslatingPortProxy::tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
         if (range.fault) {
             // If there was a fault last time too, or the fixup this time
             // fails, then the operation has failed.
-            if (faulting || !fixupRange(range, mode))
+            if (faulting || !fixupRange(range, mode)) {
+                flush();
                 return false;
+            }
             // This must be the first time we've tried this translation, so
             // record that we're making a second attempt and continue.
             faulting = true;
             continue;
         }
 
-        // Run func() on this successful translation.
+        // Run func() on this successful translation, together with the
+        // previous ones if it continues them.
         faulting = false;
-        func(range);
+        if (pending.size && range.paddr == pending.paddr + pending.size) {
+            pending.size += range.size;
+        } else {
+            flush();
+            pending = range;
+        }
     }
+    flush();
     return true;
 }
 
+uint8_t *
+TranslatingPortProxy::backdoorPtr(Addr paddr, uint64_t size,
+        MemBackdoor::Flags access, MemBackdoorPtr &backdoor) const
+{
+    if (flags != 0 || !_tc->getSystemPtr()->isAtomicMode())
+        return nullptr;
+
+    const AddrRange range(paddr, paddr + size);
+    if (!backdoor || !range.isSubset(backdoor->range())) {
+        auto *port =
+            dynamic_cast<RequestPort *>(&_tc->getCpuPtr()->getDataPort());
+        if (!port)
+            return nullptr;
+
+        // A back door requested for writing would stop the memory from
+        // tracking dirty pages until it is invalidated
+        backdoor = nullptr;
+        port->sendMemBackdoorReq(
+            MemBackdoorReq(range, MemBackdoor::Readable), backdoor);
+        if (!backdoor || !range.isSubset(backdoor->range())) {
+            backdoor = nullptr;
+            return nullptr;
+        }
+    }
+
+    if ((backdoor->flags() & access) != access)
+        return nullptr;
+    return backdoor->ptr() + (paddr - backdoor->range().start());
+}
+
+void
+TranslatingPortProxy::markWritten(const uint8_t *host, uint64_t size) const
+{
+    _tc->getSystemPtr()->getPhysMem().markDirty(host, size);
+}
+
 bool
 TranslatingPortProxy::tryReadBlob(Addr addr, void *p, uint64_t size) const
 {
     constexpr auto mode = BaseMMU::Read;
     return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
             addr, size, _tc, mode, flags),
-        [this, &p](const auto &range) {
-            PortProxy::readBlobPhys(range.paddr, flags, p, range.size);
+        [this, &p, backdoor = MemBackdoorPtr(nullptr)](
+                const auto &range) mutable {
+            if (auto *host = backdoorPtr(range.paddr, range.size,
+                        MemBackdoor::Readable, backdoor)) {
+                std::memcpy(p, host, range.size);
+            } else {
+                PortProxy::readBlobPhys(range.paddr, flags, p, range.size);
+            }
             p = static_cast<uint8_t *>(p) + range.size;
     });
 }
@@ -104,8 +166,15 @@ TranslatingPortProxy::tryWriteBlob(
     constexpr auto mode = BaseMMU::Write;
     return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
             addr, size, _tc, mode, flags),
-        [this, &p](const auto &range) {
-            PortProxy::writeBlobPhys(range.paddr, flags, p, range.size);
+        [this, &p, backdoor = MemBackdoorPtr(nullptr)](
+                const auto &range) mutable {
+            if (auto *host = backdoorPtr(range.paddr, range.size,
+                        MemBackdoor::Writeable, backdoor)) {
+                std::memcpy(host, p, range.size);
+                markWritten(host, range.size);
+            } else {
+                PortProxy::writeBlobPhys(range.paddr, flags, p, range.size);
+            }
             p = static_cast<const uint8_t *>(p) + range.size;
     });
 }
@@ -116,8 +185,15 @@ TranslatingPortProxy::tryMemsetBlob(Addr addr, uint8_t v, uint64_t size) const
     constexpr auto mode = BaseMMU::Write;
     return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
             addr, size, _tc, mode, flags),
-        [this, v](const auto &range) {
-            PortProxy::memsetBlobPhys(range.paddr, flags, v, range.size);
+        [this, v, backdoor = MemBackdoorPtr(nullptr)](
+                const auto &range) mutable {
+            if (auto *host = backdoorPtr(range.paddr, range.size,
+                        MemBackdoor::Writeable, backdoor)) {
+                std::memset(host, v, range.size);
+                markWritten(host, range.size);
+            } else {
+                PortProxy::memsetBlobPhys(range.paddr, flags, v, range.size);
+            }
     });
 }
 
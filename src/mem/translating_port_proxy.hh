@@ -69,9 +69,38 @@ class TranslatingPortProxy : public PortProxy
         return false;
     }
 
+    /**
+     * Run func() on each translated range of gen, merging ranges which
+     * are contiguous both virtually and physically.
+     */
     bool tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
             std::function<void(const TranslationGen::Range &)> func) const;
 
+    /**
+     * Find a host pointer to a physical range through a back door of the
+     * memory holding it. Back doors are only used in atomic mode, where
+     * there are no accesses in flight which functional packets would
+     * have to observe.
+     *
+     * Back doors are always requested for reading, so that the memory
+     * keeps tracking the pages written to it for delta checkpoints.
+     * Callers that write through the pointer mark the range dirty with
+     * markWritten().
+     *
+     * @param paddr Start of the physical range
+     * @param size Size of the range
+     * @param access How the range will be accessed
+     * @param backdoor The back door used for the previous range of the
+     *        same access, reused if it covers this range as well
+     * @return A pointer to paddr, or nullptr if the range has to be
+     *         accessed through functional packets
+     */
+    uint8_t *backdoorPtr(Addr paddr, uint64_t size,
+            MemBackdoor::Flags access, MemBackdoorPtr &backdoor) const;
+
+    /** Record a write through a pointer from backdoorPtr(). */
+    void markWritten(const uint8_t *host, uint64_t size) const;
+
   public:
     TranslatingPortProxy(ThreadContext *tc, Request::Flags _flags=0);
 
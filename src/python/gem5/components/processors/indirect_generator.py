@@ -0,0 +1,157 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from typing import List
+
+from ...utils.override import overrides
+from .abstract_generator import AbstractGenerator
+from .indirect_generator_core import IndirectGeneratorCore
+
+
+class IndirectGenerator(AbstractGenerator):
+    def __init__(
+        self,
+        num_cores: int = 1,
+        duration: str = "1ms",
+        rate: str = "100GB/s",
+        index_addr: int = 0,
+        index_size: int = 4,
+        target_addr: int = 0x100000,
+        word_size: int = 4,
+        access: str = "load",
+        distribution: str = "uniform",
+        index_file: str = "",
+        num_indices: int = 65536,
+        num_targets: int = 65536,
+        skew: float = 1.0,
+        mlp: int = 16,
+        cond_perc: int = 100,
+        data_limit: int = 0,
+    ) -> None:
+        super().__init__(
+            cores=self._create_cores(
+                num_cores=num_cores,
+                duration=duration,
+                rate=rate,
+                index_addr=index_addr,
+                index_size=index_size,
+                target_addr=target_addr,
+                word_size=word_size,
+                access=access,
+                distribution=distribution,
+                index_file=index_file,
+                num_indices=num_indices,
+                num_targets=num_targets,
+                skew=skew,
+                mlp=mlp,
+                cond_perc=cond_perc,
+                data_limit=data_limit,
+            )
+        )
+        """The indirect generator
+
+        This class defines an external interface to create a list of indirect
+        generator cores that could replace the processing cores in a board.
+        Each core gathers (``load``), scatters (``store``) or updates
+        (``rmw``) ``target[index[i]]`` for the indices of an index array, with
+        every target access waiting for its index to be read from memory.
+
+        :param num_cores: The number of indirect generator cores to create.
+        :param duration: The number of ticks for the generator to generate
+                         traffic.
+        :param rate: The rate at which requests are injected.
+        :param index_addr: The start address of the index array.
+        :param index_size: The size of one index in bytes.
+        :param target_addr: The start address of the target array.
+        :param word_size: The size of one target element in bytes.
+        :param access: ``load``, ``store`` or ``rmw``.
+        :param distribution: ``uniform``, ``zipf``, ``powerlaw``, ``file`` or
+                             ``mtx``. See IndirectGeneratorCore.
+        :param index_file: The file to read for ``file`` and ``mtx``.
+        :param num_indices: The number of indices to use; 0 for all of them
+                            with ``file``, ``mtx`` and ``powerlaw``.
+        :param num_targets: The number of elements in the target array; 0 to
+                            derive it from the file.
+        :param skew: The exponent of the ``zipf`` and ``powerlaw``
+                     distributions.
+        :param mlp: The maximum number of requests in flight per core.
+        :param cond_perc: The percentage of elements that pass the condition
+                          and are accessed.
+        :param data_limit: The amount of data in bytes to read/write by the
+                           generator before stopping generation.
+        """
+
+    def _create_cores(
+        self,
+        num_cores: int,
+        duration: str,
+        rate: str,
+        index_addr: int,
+        index_size: int,
+        target_addr: int,
+        word_size: int,
+        access: str,
+        distribution: str,
+        index_file: str,
+        num_indices: int,
+        num_targets: int,
+        skew: float,
+        mlp: int,
+        cond_perc: int,
+        data_limit: int,
+    ) -> List[IndirectGeneratorCore]:
+        """
+        The helper function to create the cores for the generator, it will use
+        the same inputs as the constructor function.
+        """
+        return [
+            IndirectGeneratorCore(
+                duration=duration,
+                rate=rate,
+                index_addr=index_addr,
+                index_size=index_size,
+                target_addr=target_addr,
+                word_size=word_size,
+                access=access,
+                distribution=distribution,
+                index_file=index_file,
+                num_indices=num_indices,
+                num_targets=num_targets,
+                skew=skew,
+                mlp=mlp,
+                cond_perc=cond_perc,
+                data_limit=data_limit,
+            )
+            for _ in range(num_cores)
+        ]
+
+    @overrides(AbstractGenerator)
+    def start_traffic(self) -> None:
+        """
+        This function will start the assigned traffic to this generator.
+        """
+        for core in self.cores:
+            core.start_traffic()
@@ -0,0 +1,160 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from typing import Iterator
+
+from m5.objects import (
+    BaseTrafficGen,
+    Port,
+    PyTrafficGen,
+)
+from m5.ticks import fromSeconds
+from m5.util.convert import (
+    toLatency,
+    toMemoryBandwidth,
+)
+
+from ...utils.override import overrides
+from .abstract_core import AbstractCore
+from .abstract_generator_core import AbstractGeneratorCore
+
+
+class IndirectGeneratorCore(AbstractGeneratorCore):
+    def __init__(
+        self,
+        duration: str,
+        rate: str,
+        index_addr: int,
+        index_size: int,
+        target_addr: int,
+        word_size: int,
+        access: str,
+        distribution: str,
+        index_file: str,
+        num_indices: int,
+        num_targets: int,
+        skew: float,
+        mlp: int,
+        cond_perc: int,
+        data_limit: int,
+    ) -> None:
+        super().__init__()
+        """ The indirect generator core interface.
+
+        This class defines the interface for a generator core that walks an
+        index array and loads, stores or updates ``target[index[i]]``. The
+        target accesses of an index are only issued once the index has been
+        read from memory. This core uses PyTrafficGen to create and inject
+        the synthetic traffic.
+
+        :param duration: The number of ticks for the generator core to generate
+                         traffic.
+        :param rate: The rate at which requests are injected.
+        :param index_addr: The start address of the index array.
+        :param index_size: The size of one index in bytes.
+        :param target_addr: The start address of the target array.
+        :param word_size: The size of one target element in bytes.
+        :param access: ``load``, ``store`` or ``rmw``.
+        :param distribution: Where the indices come from: ``uniform``,
+                             ``zipf``, ``powerlaw`` (column indices of a
+                             power-law graph), ``file`` (whitespace separated
+                             indices) or ``mtx`` (column indices of a Matrix
+                             Market matrix in CSR order).
+        :param index_file: The file to read for ``file`` and ``mtx``.
+        :param num_indices: The number of indices to use; 0 for all of them
+                            with ``file``, ``mtx`` and ``powerlaw``.
+        :param num_targets: The number of elements in the target array; 0 to
+                            derive it from the file.
+        :param skew: The exponent of the ``zipf`` and ``powerlaw``
+                     distributions.
+        :param mlp: The maximum number of requests in flight.
+        :param cond_perc: The percentage of elements that pass the condition
+                          and are accessed.
+        :param data_limit: The amount of data in bytes to read/write by the
+                           generator before stopping generation.
+        """
+        self.generator = PyTrafficGen()
+        self._duration = duration
+        self._rate = rate
+        self._index_addr = index_addr
+        self._index_size = index_size
+        self._target_addr = target_addr
+        self._word_size = word_size
+        self._access = access
+        self._distribution = distribution
+        self._index_file = index_file
+        self._num_indices = num_indices
+        self._num_targets = num_targets
+        self._skew = skew
+        self._mlp = mlp
+        self._cond_perc = cond_perc
+        self._data_limit = data_limit
+
+    @overrides(AbstractCore)
+    def connect_dcache(self, port: Port) -> None:
+        self.generator.port = port
+
+    def _set_traffic(self) -> None:
+        """
+        This private function will set the traffic to be generated.
+        """
+        self._traffic = self._create_traffic()
+
+    def _create_traffic(self) -> Iterator[BaseTrafficGen]:
+        """
+        A python generator that yields (creates) an indirect traffic with the
+        specified params in the generator core and then yields (creates) an
+        exit traffic.
+
+        :rtype: Iterator[BaseTrafficGen]
+        """
+        duration = fromSeconds(toLatency(self._duration))
+        rate = toMemoryBandwidth(self._rate)
+        period = fromSeconds(self._word_size / rate)
+        yield self.generator.createIndirect(
+            duration,
+            self._index_addr,
+            self._index_size,
+            self._target_addr,
+            self._word_size,
+            self._access,
+            self._distribution,
+            self._index_file,
+            self._num_indices,
+            self._num_targets,
+            self._skew,
+            self._mlp,
+            self._cond_perc,
+            period,
+            period,
+            self._data_limit,
+        )
+        yield self.generator.createExit(0)
+
+    @overrides(AbstractGeneratorCore)
+    def start_traffic(self) -> None:
+        self._set_traffic()
+        self.generator.start(self._traffic)
@@ -105,11 +105,14 @@ class SimpleSwitchableProcessor(SwitchableProcessor):
             self._mem_mode = MemMode.ATOMIC_NONCACHING
         board.set_mem_mode(self._mem_mode)
 
-    def switch(self):
-        """Switches to the "switched out" cores."""
+    def switch(self, functional_warming: bool = False):
+        """Switches to the "switched out" cores.
+
+        :param functional_warming: See ``switch_to_processor``.
+        """
         if self._current_is_start:
-            self.switch_to_processor(self._switch_key)
+            self.switch_to_processor(self._switch_key, functional_warming)
         else:
-            self.switch_to_processor(self._start_key)
+            self.switch_to_processor(self._start_key, functional_warming)
 
         self._current_is_start = not self._current_is_start
@@ -117,7 +117,16 @@ class SwitchableProcessor(AbstractProcessor):
         for core_list in self._switchable_cores.values():
             yield from core_list
 
-    def switch_to_processor(self, switchable_core_key: str):
+    def switch_to_processor(
+        self, switchable_core_key: str, functional_warming: bool = False
+    ):
+        """Switch to the cores of ``switchable_core_key``.
+
+        :param functional_warming: Run the new cores, which must be atomic,
+                                   with the caches bypassed, so that the
+                                   caches with ``functional_warming`` set
+                                   are warmed instead of accessed.
+        """
         # Run various checks.
         if not hasattr(self, "_board"):
             raise AssertionError("The processor has not been incorporated.")
@@ -150,7 +159,9 @@ class SwitchableProcessor(AbstractProcessor):
 
         # Switch the CPUs
         m5.switchCpus(
-            self._board, list(zip(current_core_simobj, to_switch_simobj))
+            self._board,
+            list(zip(current_core_simobj, to_switch_simobj)),
+            functional_warming=functional_warming,
         )
 
         # Ensure the current processor is updated.
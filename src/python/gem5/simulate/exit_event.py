@@ -49,6 +49,7 @@ class ExitEvent(Enum):
     )
     SIMPOINT_BEGIN = "simpoint begins"
     MAX_INSTS = "number of instructions reached"
+    SAMPLE_BOUNDARY = "sample boundary"  # A sampling phase has ended.
     PERF_COUNTER_ENABLE = "performance counter enabled"
     PERF_COUNTER_DISABLE = "performance counter disabled"
     PERF_COUNTER_RESET = "performance counter reset"
@@ -97,6 +98,8 @@ class ExitEvent(Enum):
             return ExitEvent.SIMPOINT_BEGIN
         elif exit_string == "a thread reached the max instruction count":
             return ExitEvent.MAX_INSTS
+        elif exit_string == "sample boundary reached":
+            return ExitEvent.SAMPLE_BOUNDARY
         elif exit_string == "performance counter enabled":
             return ExitEvent.PERF_COUNTER_ENABLE
         elif exit_string == "performance counter disabled":
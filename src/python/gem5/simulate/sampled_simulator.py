@@ -0,0 +1,465 @@
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import json
+import math
+import os
+from statistics import (
+    NormalDist,
+    mean,
+    stdev,
+)
+from typing import (
+    Callable,
+    Dict,
+    Generator,
+    List,
+    Optional,
+    Union,
+)
+
+import m5
+import m5.stats
+from m5.util import warn
+
+import _m5.stats
+
+from ..components.boards.abstract_board import AbstractBoard
+from ..components.boards.mem_mode import MemMode
+from ..components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+from ..components.processors.switchable_processor import SwitchableProcessor
+from .exit_event import ExitEvent
+from .simulator import Simulator
+
+
+class SampledSimulator(Simulator):
+    """
+    A Simulator that samples the detailed cores of a SwitchableProcessor
+    SMARTS-style instead of simulating everything in detail.
+
+    Sampling repeats three phases until the region of interest ends:
+
+    1. Functional warming: the fast cores (typically ``AtomicSimpleCPU``)
+       run ``functional_warming_insts`` instructions per core. They access
+       the caches, so the cache contents stay warm, and they share the
+       branch predictors of the detailed cores, so those stay warm too.
+       With ``functional_cache_warming`` the fast cores bypass the caches
+       instead, which only update their tags, replacement state and
+       prefetchers; the caches must have ``functional_warming`` set.
+    2. Detailed warm-up: the detailed cores (typically O3) run
+       ``detailed_warmup_insts`` instructions to fill the pipeline, the
+       MSHRs and the memory controller queues.
+    3. Measurement: the stats are reset and the detailed cores run
+       ``measurement_insts`` instructions. The stats listed in ``stats`` are
+       then read and recorded as one sample.
+
+    Phase lengths are counted per core: a phase ends as soon as any thread
+    of any core has committed its instruction budget. When ``roi_only`` is
+    set, sampling starts at the first ``m5_work_begin`` and stops, on the
+    fast cores, when the matching ``m5_work_end`` is reached, discarding an
+    unfinished measurement. Memory regions set with ``m5_add_mem_region``
+    follow the switches between the cores, so per-region stats can be
+    sampled like any other stat.
+
+    The mean of every sampled stat, and its confidence interval assuming the
+    sample means are normally distributed, are returned by
+    ``get_sample_results()`` and written to ``sampling.json`` in the output
+    directory when ``run()`` returns.
+
+    Example
+    -------
+
+    .. code-block::
+
+        processor = SimpleSwitchableProcessor(
+            starting_core_type=CPUTypes.ATOMIC,
+            switch_core_type=CPUTypes.O3,
+            num_cores=4,
+        )
+        ...
+        simulator = SampledSimulator(
+            board=board,
+            functional_warming_insts=1000000,
+            detailed_warmup_insts=20000,
+            measurement_insts=10000,
+        )
+        simulator.run()
+    """
+
+    def __init__(
+        self,
+        board: AbstractBoard,
+        functional_warming_insts: int,
+        detailed_warmup_insts: int,
+        measurement_insts: int,
+        fast_cores: str = "start",
+        detailed_cores: str = "switch",
+        stats: Optional[List[str]] = None,
+        confidence: float = 0.997,
+        roi_only: bool = True,
+        max_samples: int = 0,
+        dump_samples: bool = False,
+        warm_branch_predictors: bool = True,
+        functional_cache_warming: bool = False,
+        exit_on_roi_end: bool = False,
+        on_exit_event: Optional[
+            Dict[
+                ExitEvent,
+                Union[
+                    Generator[Optional[bool], None, None],
+                    List[Callable],
+                    Callable,
+                ],
+            ]
+        ] = None,
+        **kwargs,
+    ) -> None:
+        """
+        :param board: The board to be simulated. Its processor must be a
+                      ``SwitchableProcessor``.
+        :param functional_warming_insts: Instructions per core simulated on
+                                         the fast cores between samples.
+        :param detailed_warmup_insts: Instructions per core simulated on the
+                                      detailed cores before a measurement.
+        :param measurement_insts: Instructions per core measured in a sample.
+        :param fast_cores: The key of the fast cores in the processor. The
+                           default matches ``SimpleSwitchableProcessor``
+                           started on the fast cores.
+        :param detailed_cores: The key of the detailed cores in the processor.
+        :param stats: Paths of the stats, relative to the root, to record in
+                      every sample. Scalars are read as is, vectors and
+                      formulas as their total and distributions as their sum.
+                      The default is the IPC of every detailed core.
+        :param confidence: Confidence level of the reported intervals. The
+                           default, 99.7%, is the one used by SMARTS.
+        :param roi_only: Only sample between ``m5_work_begin`` and
+                         ``m5_work_end``. Otherwise sampling starts with the
+                         simulation and lasts until it exits.
+        :param max_samples: Stop sampling, and continue on the fast cores,
+                            after this many samples. 0 means no limit.
+        :param dump_samples: Dump the stats at the end of every measurement,
+                             which leaves one stats dump per sample.
+        :param warm_branch_predictors: Let the fast cores use, and so warm,
+                                       the branch predictors of the detailed
+                                       cores.
+        :param functional_cache_warming: Run the fast cores with the caches
+                                         bypassed and functionally warmed.
+        :param exit_on_roi_end: Exit the simulation loop when the region of
+                                interest ends.
+        :param on_exit_event: As for ``Simulator``. The sampler handles
+                              ``WORKBEGIN``, ``WORKEND`` and
+                              ``SAMPLE_BOUNDARY`` itself, so these may not be
+                              overridden.
+        """
+
+        processor = board.get_processor()
+        if not isinstance(processor, SwitchableProcessor):
+            raise TypeError(
+                "Sampled simulation needs a SwitchableProcessor to switch "
+                "between fast and detailed cores."
+            )
+        for key in (fast_cores, detailed_cores):
+            if not hasattr(processor, key):
+                raise KeyError(f"The processor has no cores named '{key}'.")
+        if fast_cores == detailed_cores:
+            raise ValueError("The fast and detailed cores must differ.")
+        if measurement_insts <= 0:
+            raise ValueError("'measurement_insts' must be positive.")
+        if functional_warming_insts < 0 or detailed_warmup_insts < 0:
+            raise ValueError("Phase lengths cannot be negative.")
+        if not 0 < confidence < 1:
+            raise ValueError("'confidence' must be in (0, 1).")
+
+        handlers = dict(on_exit_event) if on_exit_event else {}
+        for event in (
+            ExitEvent.WORKBEGIN,
+            ExitEvent.WORKEND,
+            ExitEvent.SAMPLE_BOUNDARY,
+        ):
+            if event in handlers:
+                raise ValueError(
+                    f"The '{event.value}' exit event is handled by the "
+                    "sampler."
+                )
+        handlers[ExitEvent.WORKBEGIN] = self._work_begin
+        handlers[ExitEvent.WORKEND] = self._work_end
+        handlers[ExitEvent.SAMPLE_BOUNDARY] = self._sample_boundary
+
+        super().__init__(board=board, on_exit_event=handlers, **kwargs)
+
+        self._processor = processor
+        self._fast_key = fast_cores
+        self._detailed_key = detailed_cores
+        self._phase_insts = {
+            "functional": functional_warming_insts,
+            "warmup": detailed_warmup_insts,
+            "measure": measurement_insts,
+        }
+        self._sampled_stats = stats
+        self._confidence = confidence
+        self._roi_only = roi_only
+        self._max_samples = max_samples
+        self._dump_samples = dump_samples
+        self._exit_on_roi_end = exit_on_roi_end
+        self._functional_cache_warming = functional_cache_warming
+
+        self._current_key = (
+            fast_cores
+            if processor.get_cores()[0] in getattr(processor, fast_cores)
+            else detailed_cores
+        )
+        self._phase = None
+        self._phase_start = []
+        self._roi_depth = 0
+        self._samples = []
+        self._discarded_samples = 0
+
+        if warm_branch_predictors:
+            self._share_branch_predictors()
+        if functional_cache_warming and self._current_key == fast_cores:
+            board.set_mem_mode(MemMode.ATOMIC_NONCACHING)
+
+    def _share_branch_predictors(self) -> None:
+        fast = getattr(self._processor, self._fast_key)
+        detailed = getattr(self._processor, self._detailed_key)
+        for fast_core, detailed_core in zip(fast, detailed):
+            fast_cpu = fast_core.get_simobject()
+            detailed_cpu = detailed_core.get_simobject()
+            # Assign the predictor to the detailed core explicitly first so
+            # it is parented there and its stats keep their usual path.
+            bpred = detailed_cpu.branchPred
+            detailed_cpu.branchPred = bpred
+            fast_cpu.branchPred = bpred
+
+    def _instantiate(self) -> None:
+        instantiated = self._instantiated
+        super()._instantiate()
+        if not instantiated and not self._roi_only:
+            self._start_sampling()
+
+    def run(self, max_ticks: int = m5.MaxTick) -> None:
+        super().run(max_ticks)
+        self.write_sample_results()
+
+    def _switch_to(self, key: str) -> None:
+        if self._current_key == key:
+            return
+        warming = self._functional_cache_warming and key == self._fast_key
+        if isinstance(self._processor, SimpleSwitchableProcessor):
+            # Keep the processor's own notion of its active cores right
+            self._processor.switch(warming)
+        else:
+            self._processor.switch_to_processor(key, warming)
+        self._current_key = key
+
+    def _enter_phase(self, phase: str) -> None:
+        self._phase = phase
+        self._switch_to(
+            self._fast_key if phase == "functional" else self._detailed_key
+        )
+        if phase == "measure":
+            m5.stats.reset()
+        insts = self._phase_insts[phase]
+        if insts == 0:
+            # Nothing to simulate in this phase, move on right away
+            self._next_phase()
+            return
+        self._phase_start = []
+        for core in self._processor.get_cores():
+            cpu = core.get_simobject()
+            cpu.scheduleSampleStop(insts)
+            self._phase_start.append(
+                [cpu.getCurrentInstCount(tid) for tid in range(cpu.numThreads)]
+            )
+
+    def _phase_done(self) -> bool:
+        # Several cores may reach their boundary on the same tick, only the
+        # first of their exits ends the phase
+        insts = self._phase_insts[self._phase]
+        for core, start in zip(self._processor.get_cores(), self._phase_start):
+            cpu = core.get_simobject()
+            for tid, count in enumerate(start):
+                if cpu.getCurrentInstCount(tid) >= count + insts:
+                    return True
+        return False
+
+    def _next_phase(self) -> None:
+        if self._phase == "functional":
+            self._enter_phase("warmup")
+        elif self._phase == "warmup":
+            self._enter_phase("measure")
+        else:
+            self._record_sample()
+            if self._max_samples and len(self._samples) >= self._max_samples:
+                self._stop_sampling()
+            elif self._phase_insts["functional"] == 0:
+                # Back-to-back detailed samples, stay on the detailed cores
+                self._enter_phase("warmup")
+            else:
+                self._enter_phase("functional")
+
+    def _start_sampling(self) -> None:
+        if self._phase is None:
+            self._enter_phase("functional")
+
+    def _stop_sampling(self) -> None:
+        if self._phase is None:
+            return
+        if self._phase == "measure":
+            self._discarded_samples += 1
+        for core in self._processor.get_cores():
+            core.get_simobject().descheduleSampleStop()
+        self._switch_to(self._fast_key)
+        self._phase = None
+
+    def _work_begin(self) -> bool:
+        self._roi_depth += 1
+        if self._roi_only and self._roi_depth == 1:
+            self._start_sampling()
+        return False
+
+    def _work_end(self) -> bool:
+        if self._roi_depth == 0:
+            warn("m5_work_end without a matching m5_work_begin, ignoring it.")
+            return False
+        self._roi_depth -= 1
+        if self._roi_depth > 0:
+            return False
+        if self._roi_only:
+            self._stop_sampling()
+        return self._exit_on_roi_end
+
+    def _sample_boundary(self) -> bool:
+        if self._phase is None or not self._phase_done():
+            # A boundary due on the same tick as a work end or as the
+            # boundary of another core
+            return False
+        self._next_phase()
+        return False
+
+    def _default_stats(self) -> List[str]:
+        return [
+            f"{core.get_simobject().path()}.ipc"
+            for core in getattr(self._processor, self._detailed_key)
+        ]
+
+    def _read_stat(self, name: str) -> float:
+        try:
+            stat = self._root.resolveStat(name)
+        except KeyError:
+            raise KeyError(f"Unknown stat '{name}'.")
+        stat.prepare()
+        if isinstance(stat, _m5.stats.ScalarInfo):
+            return stat.value
+        elif isinstance(stat, _m5.stats.VectorInfo):
+            return stat.total
+        elif isinstance(stat, _m5.stats.DistInfo):
+            return stat.sum
+        raise TypeError(f"Stat '{name}' cannot be sampled.")
+
+    def _record_sample(self) -> None:
+        if self._sampled_stats is None:
+            self._sampled_stats = self._default_stats()
+        self._samples.append(
+            {
+                "tick": m5.curTick(),
+                "stats": {
+                    name: self._read_stat(name)
+                    for name in self._sampled_stats
+                },
+            }
+        )
+        if self._dump_samples:
+            m5.stats.dump()
+
+    def get_samples(self) -> List[Dict]:
+        """
+        Returns the recorded samples in order. Each is a dictionary with the
+        tick at which the measurement ended and the value of every sampled
+        stat.
+        """
+        return self._samples
+
+    def get_sample_results(self) -> Dict:
+        """
+        Returns, for every sampled stat, the mean over the samples and its
+        confidence interval. The interval is only defined from two samples on.
+        Non-finite values, such as the IPC of a core that idled through a
+        measurement, are left out.
+        """
+        z = NormalDist().inv_cdf(0.5 + self._confidence / 2)
+        results = {}
+        for name in self._sampled_stats or []:
+            values = [
+                sample["stats"][name]
+                for sample in self._samples
+                if math.isfinite(sample["stats"][name])
+            ]
+            result = {"samples": len(values)}
+            if values:
+                result["mean"] = mean(values)
+            if len(values) > 1:
+                half_width = z * stdev(values) / math.sqrt(len(values))
+                result["stdev"] = stdev(values)
+                result["ci_low"] = result["mean"] - half_width
+                result["ci_high"] = result["mean"] + half_width
+                if result["mean"] != 0:
+                    result["relative_error"] = abs(
+                        half_width / result["mean"]
+                    )
+            results[name] = result
+        return {
+            "confidence": self._confidence,
+            "functional_warming_insts": self._phase_insts["functional"],
+            "detailed_warmup_insts": self._phase_insts["warmup"],
+            "measurement_insts": self._phase_insts["measure"],
+            "num_samples": len(self._samples),
+            "discarded_samples": self._discarded_samples,
+            "stats": results,
+        }
+
+    def write_sample_results(self, path: Optional[str] = None) -> None:
+        """
+        Writes the sample results and the individual samples as JSON.
+
+        :param path: The output file. Defaults to ``sampling.json`` in the
+                     simulation output directory.
+        """
+        if path is None:
+            from m5 import options
+
+            path = os.path.join(options.outdir, "sampling.json")
+        with open(path, "w") as f:
+            json.dump(
+                {
+                    "results": self.get_sample_results(),
+                    "samples": self._samples,
+                },
+                f,
+                indent=4,
+            )
@@ -52,6 +52,7 @@ from .exit_event_generators import (
     exit_generator,
     reset_stats_generator,
     save_checkpoint_generator,
+    skip_generator,
     switch_generator,
     warn_default_decorator,
 )
@@ -265,6 +266,7 @@ class Simulator:
             * ExitEvent.SCHEDULED_TICK: exit simulation
             * ExitEvent.SIMPOINT_BEGIN: reset stats
             * ExitEvent.MAX_INSTS: exit simulation
+            * ExitEvent.SAMPLE_BOUNDARY: continue simulation
 
         These generators can be found in the ``exit_event_generator.py`` module.
 
@@ -308,6 +310,11 @@ class Simulator:
                 "max instructions",
                 "exiting the simulation",
             )(),
+            ExitEvent.SAMPLE_BOUNDARY: warn_default_decorator(
+                skip_generator,
+                "sample boundary",
+                "continuing",
+            )(),
             ExitEvent.KERNEL_PANIC: exit_generator(),
             ExitEvent.KERNEL_OOPS: exit_generator(),
         }
@@ -227,6 +227,12 @@ def parse_options():
         default="stats.txt",
         help="Sets the output file for statistics [Default: %default]",
     )
+    option(
+        "--stats-delta",
+        action="store_true",
+        default=False,
+        help="Only dump stats that changed since the previous dump",
+    )
     option(
         "--stats-help",
         action="callback",
@@ -261,6 +267,14 @@ def parse_options():
         help="Create DOT & pdf outputs of the DVFS configuration"
         + " [Default: %default]",
     )
+    option(
+        "--event-queue",
+        metavar="{list,calendar}",
+        choices=["list", "calendar"],
+        default="list",
+        help="Event queue implementation; the calendar queue is faster "
+        "with many pending events [Default: %default]",
+    )
 
     # Debugging options
     group("Debugging Options")
@@ -402,6 +416,9 @@ def main():
 
     m5.options = options
 
+    # Select the event queue implementation before any queue is used.
+    event.useCalendarEventQueues(options.event_queue == "calendar")
+
     # Set the main event queue for the main thread.
     event.mainq = event.getEventQueue(0)
     event.setEventQueue(event.mainq)
@@ -558,6 +575,7 @@ def main():
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    stats.setDeltaDumps(options.stats_delta)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
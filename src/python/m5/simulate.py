@@ -348,7 +348,7 @@ def _changeMemoryMode(system, mode):
         print("System already in target mode. Memory mode unchanged.")
 
 
-def switchCpus(system, cpuList, verbose=True):
+def switchCpus(system, cpuList, verbose=True, functional_warming=False):
     """Switch CPUs in a system.
 
     .. note::
@@ -360,6 +360,9 @@ def switchCpus(system, cpuList, verbose=True):
     Arguments:
       system -- Simulated system.
       cpuList -- (old_cpu, new_cpu) tuples
+      functional_warming -- Run atomic CPUs with the caches bypassed
+        (atomic_noncaching), so that caches with functional_warming
+        set are warmed instead of accessed.
     """
 
     if verbose:
@@ -401,6 +404,14 @@ def switchCpus(system, cpuList, verbose=True):
                 f"Old CPU ({old_cpu}) does not support CPU handover."
             )
 
+    if functional_warming:
+        if memory_mode_name != "atomic":
+            raise RuntimeError(
+                f"Functional warming needs atomic CPUs, {new_cpus[0]} "
+                f"requires {memory_mode_name} mode."
+            )
+        memory_mode_name = "atomic_noncaching"
+
     MemoryMode = params.allEnums["MemoryMode"]
     try:
         memory_mode = MemoryMode(memory_mode_name).getValue()
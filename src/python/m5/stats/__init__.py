@@ -190,6 +190,28 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["bin", "binary"])
+def _binaryFactory(fn, desc=True, formulas=True):
+    """Output stats in a compact, columnar binary format.
+
+    Binary stat files store the name, unit and description of every
+    stat value once and append a row of raw values on every dump. This
+    makes dumps considerably cheaper than text dumps, which is useful
+    for periodic dumps and dumps inside loops. The files can be read
+    using util/binary_stats.py, which does not depend on HDF5.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+      * formulas (bool): Output derived stats (default: True)
+
+    Example:
+      bin://stats.bin?desc=False;formulas=False
+
+    """
+
+    return _m5.stats.initBinary(fn, desc, formulas)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -344,21 +366,35 @@ def enable():
     _m5.stats.enable()
 
 
-def prepare():
+def prepare(delta=False):
     """Prepare all stats for data access.  This must be done before
-    dumping and serialization."""
+    dumping and serialization.
+
+    If delta is True, only stats that changed since the last dump are
+    prepared. Unchanged stats keep the data prepared for an earlier
+    dump."""
 
     # Legacy stats
     for stat in stats_list:
-        stat.prepare()
+        if not delta or stat.changed():
+            stat.prepare()
 
     # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    if delta:
+        root = Root.getInstance()
+        if root:
+            root.prepareStats(True)
+    else:
+        _visit_stats(lambda g, s: s.prepare())
 
 
-def _dump_to_visitor(visitor, roots=None):
+def _dump_to_visitor(visitor, roots=None, delta=False):
     # New stats
     def dump_group(group):
+        if delta:
+            group.visitStats(visitor, True)
+            return
+
         for stat in group.getStats():
             stat.visit(visitor)
         for n, g in group.getStatGroups().items():
@@ -380,16 +416,42 @@ def _dump_to_visitor(visitor, roots=None):
 
         # Legacy stats
         for stat in stats_list:
-            stat.visit(visitor)
+            if delta and not stat.changed():
+                visitor.unchanged(stat)
+            else:
+                stat.visit(visitor)
 
 
 lastDump = 0
 # List[SimObject].
 global_dump_roots = []
+# Only dump stats that changed since the previous dump.
+delta_dumps = False
+
+
+def setDeltaDumps(enable):
+    """Enable or disable delta stat dumps.
+
+    In a delta dump, stats that haven't been updated since the previous
+    dump are neither prepared nor evaluated, and formulas are only
+    evaluated if one of their operands changed. The text output only
+    prints the stats that changed, while the binary output copies the
+    previous values of unchanged stats. Outputs that can't represent
+    partial dumps (e.g., HDF5 and JSON) still receive full dumps.
+    """
+
+    global delta_dumps
+    delta_dumps = enable
 
 
-def dump(roots=None):
-    """Dump all statistics data to the registered outputs"""
+def dump(roots=None, delta=None):
+    """Dump all statistics data to the registered outputs
+
+    If delta is None, the mode set by setDeltaDumps() is used.
+    """
+
+    if delta is None:
+        delta = delta_dumps
 
     all_roots = []
     if roots is not None:
@@ -415,7 +477,9 @@ def dump(roots=None):
         sim_root = Root.getInstance()
         if sim_root:
             sim_root.preDumpStats()
-        prepare()
+        # Partial dumps may skip stats, so they can't rely on stats
+        # prepared during an earlier dump being up to date.
+        prepare(delta and not all_roots)
 
     for output in outputList:
         if isinstance(output, JsonOutputVistor):
@@ -426,9 +490,19 @@ def dump(roots=None):
         else:
             if output.valid():
                 output.begin()
-                _dump_to_visitor(output, roots=all_roots)
+                _dump_to_visitor(
+                    output, roots=all_roots, delta=delta and not all_roots
+                )
                 output.end()
 
+    # Later delta dumps only include stats updated after this dump.
+    if not all_roots:
+        sim_root = Root.getInstance()
+        if sim_root:
+            sim_root.clearChangedStats()
+        for stat in stats_list:
+            stat.clearChanged()
+
 
 def reset():
     """Reset all statistics to the base state"""
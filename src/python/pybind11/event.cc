@@ -116,6 +116,7 @@ pybind_init_event(py::module_ &m_native)
     m.def("setEventQueue", [](EventQueue *q) { return curEventQueue(q); });
     m.def("getEventQueue", &getEventQueue,
           py::return_value_policy::reference);
+    m.def("useCalendarEventQueues", &useCalendarEventQueues);
 
     py::class_<EventQueue>(m, "EventQueue")
         .def("name",  [](EventQueue *eq) { return eq->name(); })
@@ -42,6 +42,7 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/binary.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -111,6 +112,7 @@ pybind_init_stats(py::module_ &m_native)
         .def("initSimStats", &statistics::initSimStats)
         .def("initText", &statistics::initText,
             py::return_value_policy::reference)
+        .def("initBinary", &statistics::initBinary)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
@@ -132,6 +134,7 @@ pybind_init_stats(py::module_ &m_native)
         .def("valid", &statistics::Output::valid)
         .def("beginGroup", &statistics::Output::beginGroup)
         .def("endGroup", &statistics::Output::endGroup)
+        .def("unchanged", &statistics::Output::unchanged)
         ;
 
     py::class_<statistics::Info,
@@ -151,6 +154,8 @@ pybind_init_stats(py::module_ &m_native)
         .def("prepare", &statistics::Info::prepare)
         .def("reset", &statistics::Info::reset)
         .def("zero", &statistics::Info::zero)
+        .def("changed", &statistics::Info::changed)
+        .def("clearChanged", &statistics::Info::clearChanged)
         .def("visit", &statistics::Info::visit)
         ;
 
@@ -221,6 +226,9 @@ pybind_init_stats(py::module_ &m_native)
         .def("regStats", &statistics::Group::regStats)
         .def("resetStats", &statistics::Group::resetStats)
         .def("preDumpStats", &statistics::Group::preDumpStats)
+        .def("prepareStats", &statistics::Group::prepareStats)
+        .def("visitStats", &statistics::Group::visitStats)
+        .def("clearChangedStats", &statistics::Group::clearChangedStats)
         .def("getStats", [](const statistics::Group &self)
              -> std::vector<py::object> {
 
@@ -51,6 +51,16 @@ class Process(SimObject):
     )
     kvmInSE = Param.Bool("false", "initialize the process for KvmCPU in SE")
     maxStackSize = Param.MemorySize("64MiB", "maximum size of the stack")
+    largePageSizes = VectorParam.MemorySize(
+        [],
+        "sizes of the large pages anonymous memory is mapped with, when "
+        "its mappings cover an aligned page of that size",
+    )
+    mapFilePages = Param.Bool(
+        False,
+        "map the pages of mmapped files copy-on-write into the guest "
+        "memory instead of copying them when they are first accessed",
+    )
 
     uid = Param.Int(100, "user id")
     euid = Param.Int(100, "effective user id")
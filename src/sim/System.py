@@ -104,6 +104,30 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    sparse_memory_checkpoint = Param.Bool(
+        False,
+        "Checkpoint the backing store in the sparse format, which only "
+        "stores non-zero pages and compresses them in parallel",
+    )
+    image_memory_checkpoint = Param.Bool(
+        False,
+        "Checkpoint the backing store as uncompressed images, which are "
+        "restored by mapping them copy-on-write so that simulations "
+        "restoring from the same checkpoint share the host memory",
+    )
+    delta_memory_checkpoint = Param.Bool(
+        False,
+        "Track the memory pages written between checkpoints, and only "
+        "write those pages in the checkpoints after the first one. "
+        "Delta checkpoints refer to the previous checkpoint, which must "
+        "be kept to restore them.",
+    )
+    checkpoint_threads = Param.Unsigned(
+        0,
+        "Host threads used to write and read sparse and image memory "
+        "checkpoints (0 for one per host core)",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
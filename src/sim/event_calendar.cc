@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_calendar.hh"
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+EventCalendar::EventCalendar()
+    : buckets(minBuckets, nullptr), bucketMask(minBuckets - 1),
+      widthShift(10), _head(nullptr), headBucket(0), _numBins(0),
+      opsSinceResize(0), stepsSinceResize(0)
+{
+}
+
+void
+EventCalendar::insert(Event *event)
+{
+    // Find the bin of the event in its bucket, or where a new bin
+    // needs to be inserted
+    Event **curr = &bucket(event->when());
+    uint64_t steps = 0;
+    while (*curr && **curr < *event) {
+        curr = &(*curr)->nextBin;
+        steps++;
+    }
+
+    Event *top = *curr;
+    const bool new_bin = !top || *event < *top;
+    *curr = Event::insertBefore(event, top);
+
+    if (new_bin) {
+        _numBins++;
+        if (!_head || *event < *_head) {
+            _head = event;
+            headBucket = virtualBucket(event->when());
+        }
+    } else if (top == _head) {
+        // the event is the new top of the head bin
+        _head = event;
+    }
+
+    if (_numBins > 2 * buckets.size())
+        resize(2 * buckets.size());
+    else
+        accountSteps(steps);
+}
+
+void
+EventCalendar::remove(Event *event)
+{
+    Event **curr = &bucket(event->when());
+    uint64_t steps = 0;
+    while (*curr && **curr < *event) {
+        curr = &(*curr)->nextBin;
+        steps++;
+    }
+
+    if (!*curr || **curr != *event)
+        panic("event not found!");
+
+    Event *top = *curr;
+    const bool bin_removed = event == top && !top->nextInBin;
+    *curr = Event::removeItem(event, top);
+
+    if (bin_removed)
+        _numBins--;
+
+    if (top == _head) {
+        if (bin_removed)
+            findHead();
+        else
+            _head = *curr;
+    }
+
+    if (_numBins < buckets.size() / 2 && buckets.size() > minBuckets)
+        resize(buckets.size() / 2);
+    else
+        accountSteps(steps);
+}
+
+void
+EventCalendar::findHead()
+{
+    if (!_numBins) {
+        _head = nullptr;
+        return;
+    }
+
+    // No bin is in an earlier virtual bucket than the previous head,
+    // so the first bin found in the following ones is the earliest
+    for (uint64_t i = 0; i < buckets.size(); i++) {
+        const uint64_t vb = headBucket + i;
+        Event *top = buckets[vb & bucketMask];
+        if (top && virtualBucket(top->when()) == vb) {
+            _head = top;
+            headBucket = vb;
+            accountSteps(i);
+            return;
+        }
+    }
+
+    // All the bins are more than a turn through the buckets away
+    Event *earliest = nullptr;
+    for (Event *top : buckets) {
+        if (top && (!earliest || *top < *earliest))
+            earliest = top;
+    }
+    _head = earliest;
+    headBucket = virtualBucket(earliest->when());
+    accountSteps(2 * buckets.size());
+}
+
+void
+EventCalendar::accountSteps(uint64_t steps)
+{
+    opsSinceResize++;
+    stepsSinceResize += steps;
+
+    // Look at the average walk over windows of operations, a long one
+    // means the bucket width no longer fits the pending events
+    if (opsSinceResize < 4 * buckets.size() + 64)
+        return;
+
+    if (stepsSinceResize > 4 * opsSinceResize) {
+        resize(buckets.size());
+    } else {
+        opsSinceResize = 0;
+        stepsSinceResize = 0;
+    }
+}
+
+std::vector<Event *>
+EventCalendar::bins() const
+{
+    std::vector<Event *> tops;
+    tops.reserve(_numBins);
+    for (Event *top : buckets) {
+        for (; top; top = top->nextBin)
+            tops.push_back(top);
+    }
+    std::sort(tops.begin(), tops.end(),
+              [](const Event *l, const Event *r) { return *l < *r; });
+    return tops;
+}
+
+void
+EventCalendar::resize(unsigned num_buckets)
+{
+    rebuild(bins(), num_buckets);
+}
+
+void
+EventCalendar::rebuild(const std::vector<Event *> &tops,
+                       unsigned num_buckets)
+{
+    // Use a few times the median distance between the bins closest to
+    // the head as the width, which ignores the few bins that are far
+    // in the future (e.g. exit events)
+    std::vector<Tick> gaps;
+    for (size_t i = 1; i < std::min<size_t>(tops.size(), widthSamples);
+         i++) {
+        const Tick gap = tops[i]->when() - tops[i - 1]->when();
+        if (gap)
+            gaps.push_back(gap);
+    }
+    if (!gaps.empty()) {
+        std::nth_element(gaps.begin(), gaps.begin() + gaps.size() / 2,
+                         gaps.end());
+        const Tick gap = gaps[gaps.size() / 2];
+        widthShift = gap >= (Tick(1) << 60) ? 62 : ceilLog2(3 * gap);
+    }
+
+    buckets.assign(num_buckets, nullptr);
+    bucketMask = num_buckets - 1;
+
+    // Insert the bins from the last one at the front of their buckets,
+    // which leaves each bucket sorted
+    for (auto it = tops.rbegin(); it != tops.rend(); ++it) {
+        Event *&b = bucket((*it)->when());
+        (*it)->nextBin = b;
+        b = *it;
+    }
+
+    _numBins = tops.size();
+    _head = tops.empty() ? nullptr : tops.front();
+    if (_head)
+        headBucket = virtualBucket(_head->when());
+
+    opsSinceResize = 0;
+    stepsSinceResize = 0;
+}
+
+Event *
+EventCalendar::extract()
+{
+    std::vector<Event *> tops = bins();
+    for (size_t i = 0; i < tops.size(); i++)
+        tops[i]->nextBin = i + 1 < tops.size() ? tops[i + 1] : nullptr;
+
+    std::fill(buckets.begin(), buckets.end(), nullptr);
+    _head = nullptr;
+    _numBins = 0;
+
+    return tops.empty() ? nullptr : tops.front();
+}
+
+void
+EventCalendar::insertList(Event *list)
+{
+    assert(empty());
+
+    std::vector<Event *> tops;
+    for (Event *top = list; top; top = top->nextBin)
+        tops.push_back(top);
+
+    unsigned num_buckets = minBuckets;
+    while (num_buckets < tops.size())
+        num_buckets *= 2;
+    rebuild(tops, num_buckets);
+}
+
+} // namespace gem5
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENT_CALENDAR_HH__
+#define __SIM_EVENT_CALENDAR_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * A calendar queue of event bins, used by EventQueue as an
+ * alternative to its sorted list of bins.
+ *
+ * As in the list, a bin holds the events scheduled for the same time
+ * and priority as a stack linked through Event::nextInBin, so events
+ * are serviced in exactly the same order. The bins are hashed on
+ * their time into an array of buckets, each covering a power of two
+ * ticks, and each bucket keeps its bins sorted through Event::nextBin.
+ * As long as the bucket width is in the order of the distance between
+ * pending bins, inserting an event and finding the next one take
+ * constant time on average, independent of the number of bins. The
+ * number of buckets follows the number of bins, and the width is
+ * re-estimated from the bins closest to the head whenever the buckets
+ * are resized or the queue is found to walk too much.
+ */
+class EventCalendar
+{
+  public:
+    EventCalendar();
+
+    /** The top event of the earliest bin, null if empty */
+    Event *head() const { return _head; }
+
+    bool empty() const { return _head == nullptr; }
+
+    /** Number of non-empty bins */
+    uint64_t numBins() const { return _numBins; }
+
+    void insert(Event *event);
+    void remove(Event *event);
+
+    /**
+     * Remove all the events and return them as a sorted list of bins
+     * linked through Event::nextBin, the format used by EventQueue.
+     */
+    Event *extract();
+
+    /**
+     * Insert a sorted list of bins as returned by extract(). The
+     * calendar must be empty.
+     */
+    void insertList(Event *list);
+
+    /** The top events of all the bins, in order */
+    std::vector<Event *> bins() const;
+
+  private:
+    /** Smallest number of buckets */
+    static const unsigned minBuckets = 16;
+
+    /** Number of bins closest to the head used to estimate the width */
+    static const unsigned widthSamples = 32;
+
+    uint64_t
+    virtualBucket(Tick when) const
+    {
+        return when >> widthShift;
+    }
+
+    Event *&
+    bucket(Tick when)
+    {
+        return buckets[virtualBucket(when) & bucketMask];
+    }
+
+    /** Find the earliest bin after the head was removed */
+    void findHead();
+
+    /**
+     * Rehash the bins into a new number of buckets, re-estimating the
+     * bucket width.
+     */
+    void resize(unsigned num_buckets);
+
+    /** Hash a sorted vector of bins into a new number of buckets */
+    void rebuild(const std::vector<Event *> &tops, unsigned num_buckets);
+
+    /** Count walking steps and re-estimate the width if too many */
+    void accountSteps(uint64_t steps);
+
+    std::vector<Event *> buckets;
+    uint64_t bucketMask;
+    unsigned widthShift;
+
+    Event *_head;
+
+    /** Virtual bucket of the head, no bin is in an earlier one */
+    uint64_t headBucket;
+
+    uint64_t _numBins;
+
+    /** Operations and walking steps since the last resize */
+    uint64_t opsSinceResize;
+    uint64_t stepsSinceResize;
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENT_CALENDAR_HH__
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class LogEvent : public Event
+{
+  public:
+    LogEvent(int id, Priority prio, std::vector<int> &log)
+        : Event(prio), id(id), log(log)
+    {}
+
+    void process() override { log.push_back(id); }
+
+  private:
+    const int id;
+    std::vector<int> &log;
+};
+
+/**
+ * Run a random mix of schedules, deschedules, reschedules and serviced
+ * events on a queue, logging the order in which events are serviced.
+ */
+std::vector<int>
+runRandom(bool calendar, unsigned seed, bool switch_midway=false)
+{
+    std::vector<int> log;
+    EventQueue eq("test");
+    eq.useCalendar(calendar);
+
+    std::mt19937_64 rng(seed);
+    const Event::Priority prios[] = {
+        Event::Minimum_Pri, -1, Event::Default_Pri, 1, Event::Maximum_Pri
+    };
+
+    std::vector<std::unique_ptr<LogEvent>> events;
+    for (int i = 0; i < 2000; i++) {
+        events.emplace_back(
+            std::make_unique<LogEvent>(i, prios[rng() % 5], log));
+    }
+
+    auto when = [&]() {
+        // cluster events on a few ticks, with some far in the future
+        switch (rng() % 8) {
+          case 0:
+            return eq.getCurTick();
+          case 1:
+            return eq.getCurTick() + (rng() % 1000000000);
+          default:
+            return eq.getCurTick() + 500 * (rng() % 64);
+        }
+    };
+
+    for (int op = 0; op < 50000; op++) {
+        if (switch_midway && op == 25000)
+            eq.useCalendar(!calendar);
+
+        LogEvent *e = events[rng() % events.size()].get();
+        switch (rng() % 4) {
+          case 0:
+            if (!e->scheduled())
+                eq.schedule(e, when());
+            break;
+          case 1:
+            if (e->scheduled())
+                eq.deschedule(e);
+            break;
+          case 2:
+            eq.reschedule(e, when(), true);
+            break;
+          default:
+            if (!eq.empty())
+                eq.serviceOne();
+            break;
+        }
+        if (op % 1000 == 0)
+            EXPECT_TRUE(eq.debugVerify());
+    }
+
+    while (!eq.empty())
+        eq.serviceOne();
+
+    return log;
+}
+
+} // anonymous namespace
+
+TEST(EventCalendarTest, SameOrderAsList)
+{
+    for (unsigned seed = 0; seed < 4; seed++) {
+        std::vector<int> list = runRandom(false, seed);
+        ASSERT_GT(list.size(), 1000);
+        EXPECT_EQ(list, runRandom(true, seed));
+    }
+}
+
+TEST(EventCalendarTest, SwitchWhilePending)
+{
+    std::vector<int> list = runRandom(false, 7);
+    EXPECT_EQ(list, runRandom(false, 7, true));
+    EXPECT_EQ(list, runRandom(true, 7, true));
+}
+
+TEST(EventCalendarTest, ReplaceHead)
+{
+    std::vector<int> log;
+    EventQueue eq("test");
+    eq.useCalendar(true);
+
+    LogEvent a(0, Event::Default_Pri, log), b(1, Event::Default_Pri, log),
+             c(2, Event::Default_Pri, log);
+    eq.schedule(&a, 100);
+    eq.schedule(&b, 100);
+    eq.schedule(&c, 50);
+
+    // the pending events can be set aside and restored as a list
+    Event *saved = eq.replaceHead(nullptr);
+    EXPECT_TRUE(eq.empty());
+    EXPECT_EQ(&c, saved);
+
+    eq.replaceHead(saved);
+    EXPECT_EQ(&c, eq.getHead());
+    while (!eq.empty())
+        eq.serviceOne();
+
+    // events in the same bin are serviced last in, first out
+    EXPECT_EQ(std::vector<int>({2, 1, 0}), log);
+}
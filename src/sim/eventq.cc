@@ -58,6 +58,14 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+namespace
+{
+
+// Whether new main event queues use a calendar queue
+bool calendarEventQueues = false;
+
+} // anonymous namespace
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
@@ -65,11 +73,28 @@ getEventQueue(uint32_t index)
         numMainEventQueues++;
         mainEventQueue.push_back(
             new EventQueue(csprintf("MainEventQueue-%d", index)));
+        mainEventQueue.back()->mainIndex = numMainEventQueues - 1;
+        mainEventQueue.back()->useCalendar(calendarEventQueues);
     }
 
     return mainEventQueue[index];
 }
 
+void
+useCalendarEventQueues(bool enable)
+{
+    calendarEventQueues = enable;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->useCalendar(enable);
+}
+
+void
+sealAsyncInsertions()
+{
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->sealAsyncInsertions();
+}
+
 #ifndef NDEBUG
 Counter Event::instanceCounter = 0;
 #endif
@@ -134,9 +159,32 @@ Event::releaseImpl()
         delete this;
 }
 
+void
+EventQueue::useCalendar(bool enable)
+{
+    if (enable == usingCalendar())
+        return;
+
+    // Both keep the same bins, so the list of bins moves over as is
+    if (enable) {
+        calendar = std::make_unique<EventCalendar>();
+        calendar->insertList(head);
+        head = calendar->head();
+    } else {
+        head = calendar->extract();
+        calendar.reset();
+    }
+}
+
 void
 EventQueue::insert(Event *event)
 {
+    if (calendar) {
+        calendar->insert(event);
+        head = calendar->head();
+        return;
+    }
+
     // Deal with the head case
     if (!head || *event <= *head) {
         head = Event::insertBefore(event, head);
@@ -196,6 +244,12 @@ EventQueue::remove(Event *event)
 
     assert(event->queue == this);
 
+    if (calendar) {
+        calendar->remove(event);
+        head = calendar->head();
+        return;
+    }
+
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
@@ -225,10 +279,12 @@ EventQueue::serviceOne()
 {
     std::lock_guard<EventQueue> lock(*this);
     Event *event = head;
-    Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (calendar) {
+        calendar->remove(event);
+        head = calendar->head();
+    } else if (Event *next = head->nextInBin) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -321,15 +377,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : bins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -344,8 +397,7 @@ EventQueue::debugVerify() const
     Tick time = 0;
     short priority = 0;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (Event *nextBin : bins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -371,16 +423,34 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::bins() const
+{
+    if (calendar)
+        return calendar->bins();
+
+    std::vector<Event *> tops;
+    for (Event *top = head; top; top = top->nextBin)
+        tops.push_back(top);
+    return tops;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
+    if (calendar) {
+        // hand out the events as a list of bins, as without calendar
+        Event *t = calendar->extract();
+        calendar->insertList(s);
+        head = calendar->head();
+        return t;
+    }
+
     Event* t = head;
     head = s;
     return t;
@@ -449,23 +519,33 @@ EventQueue::EventQueue(const std::string &n)
 void
 EventQueue::asyncInsert(Event *event)
 {
-    async_queue_mutex.lock();
-    async_queue.push_back(event);
-    async_queue_mutex.unlock();
+    // The scheduling thread holds the lock of its current queue, which
+    // makes it the only producer of that queue's async queue.
+    asyncQueues[curEventQueue()->mainIndex]->push(event);
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+    for (size_t i = 0; i < asyncQueues.size(); ++i) {
+        SpscQueue<Event *> &queue = *asyncQueues[i];
+        Event *event;
+        while (queue.popped() < asyncSeals[i] && queue.pop(event))
+            insert(event);
     }
+}
+
+void
+EventQueue::sealAsyncInsertions()
+{
+    while (asyncQueues.size() < numMainEventQueues)
+        asyncQueues.emplace_back(std::make_unique<SpscQueue<Event *>>());
 
-    async_queue_mutex.unlock();
+    asyncSeals.resize(asyncQueues.size());
+    for (size_t i = 0; i < asyncQueues.size(); ++i)
+        asyncSeals[i] = asyncQueues[i]->pushed();
 }
 
 } // namespace gem5
@@ -43,16 +43,19 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
 #include "base/named.hh"
+#include "base/spsc_queue.hh"
 #include "base/trace.hh"
 #include "base/type_traits.hh"
 #include "base/types.hh"
 #include "base/uncontended_mutex.hh"
 #include "debug/Event.hh"
 #include "sim/cur_tick.hh"
+#include "sim/event_calendar.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
@@ -74,6 +77,16 @@ extern uint32_t numMainEventQueues;
 //! Array for main event queues.
 extern std::vector<EventQueue *> mainEventQueue;
 
+//! Use calendar queues in the main event queues, including the ones
+//! created later.
+void useCalendarEventQueues(bool enable);
+
+/**
+ * Seal the asynchronous insertions of all main event queues, see
+ * EventQueue::sealAsyncInsertions().
+ */
+void sealAsyncInsertions();
+
 //! The current event queue for the running thread. Access to this queue
 //! does not require any locking from the thread.
 
@@ -254,6 +267,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventCalendar;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -264,7 +278,9 @@ class Event : public EventBase, public Serializable
     // result is that the insert/removal in 'nextBin' is
     // linear/constant, and the lookup/removal in 'nextInBin' is
     // constant/constant.  Hopefully this is a significant improvement
-    // over the current fully linear insertion.
+    // over the current fully linear insertion.  Event queues using an
+    // EventCalendar keep the same bins, but hash them into buckets
+    // instead of keeping them on a single list.
     Event *nextBin;
     Event *nextInBin;
 
@@ -605,27 +621,43 @@ operator!=(const Event &l, const Event &r)
  * schedule() method with the 'global' parameter set to true. Unlike
  * the previous queue migration strategy, this strategy is fully
  * deterministic. This causes the event to be inserted in a separate
- * queue of asynchronous events (async_queue), which is merged main
+ * queue of asynchronous events (asyncQueues), which is merged main
  * event queue at the end of each simulation quantum (by calling the
  * handleAsyncInsertions() method). Note that this implies that such
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
  * handleAsyncInsertions().
+ *
+ * There is an asynchronous queue for each main event queue events are
+ * scheduled from, which the thread holding that queue's lock fills
+ * without locking. Events are merged in the order of these queues, and
+ * only those scheduled before the end of the quantum, so the order of
+ * insertion does not depend on thread timing.
  */
 class EventQueue
 {
   private:
     friend void curEventQueue(EventQueue *);
+    friend EventQueue *getEventQueue(uint32_t index);
 
     std::string objName;
     Event *head;
     Tick _curTick;
 
-    //! Mutex to protect async queue.
-    UncontendedMutex async_queue_mutex;
+    //! Calendar queue holding the bins instead of the list starting at
+    //! 'head', if enabled. 'head' then mirrors the calendar's head.
+    std::unique_ptr<EventCalendar> calendar;
+
+    //! Position of this queue among the main event queues.
+    uint32_t mainIndex = 0;
+
+    //! Events added by other threads to this event queue, with one
+    //! lock-free queue per main event queue they were scheduled from.
+    std::vector<std::unique_ptr<SpscQueue<Event *>>> asyncQueues;
 
-    //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    //! Number of events of each async queue that the next call to
+    //! handleAsyncInsertions() inserts, see sealAsyncInsertions().
+    std::vector<uint64_t> asyncSeals;
 
     /**
      * Lock protecting event handling.
@@ -654,6 +686,9 @@ class EventQueue
     void insert(Event *event);
     void remove(Event *event);
 
+    //! The top events of all the bins, in order
+    std::vector<Event *> bins() const;
+
     //! Function for adding events to the async queue. The added events
     //! are added to main event queue later. Threads, other than the
     //! owning thread, should call this function instead of insert().
@@ -748,6 +783,16 @@ class EventQueue
     void name(const std::string &st) { objName = st; }
     /** @}*/ //end of api_eventq group
 
+    /**
+     * Select how the pending events are stored: as a sorted list of
+     * bins, which is linear in the number of pending bins, or in a
+     * calendar queue, which is constant on average. Both service the
+     * events in exactly the same order, and pending events are moved
+     * over.
+     */
+    void useCalendar(bool enable);
+    bool usingCalendar() const { return calendar != nullptr; }
+
     /**
      * Schedule the given event on this queue. Safe to call from any thread.
      *
@@ -901,10 +946,16 @@ class EventQueue
     bool debugVerify() const;
 
     /**
-     * Function for moving events from the async_queue to the main queue.
+     * Function for moving events from the asyncQueues to the main queue.
      */
     void handleAsyncInsertions();
 
+    /**
+     * Let the next handleAsyncInsertions() insert the events scheduled
+     * so far, but no later ones. Called while all threads are stopped.
+     */
+    void sealAsyncInsertions();
+
     /**
      *  Function to signal that the event loop should be woken up because
      *  an event has been scheduled by an agent outside the gem5 event
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Microbenchmark of the event queue backends. It models a system with
+ * many clocked objects in different clock domains that reschedule
+ * themselves every cycle, and that now and then schedule a one-shot
+ * event some cycles ahead, like a memory response.
+ *
+ * Usage: eventqtime [max objects] [events per run]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class OneShotEvent;
+
+struct Model
+{
+    EventQueue &eq;
+    std::mt19937 rng;
+    std::vector<std::unique_ptr<OneShotEvent>> pool;
+    std::vector<OneShotEvent *> freeList;
+    uint64_t processed = 0;
+
+    Model(EventQueue &eq) : eq(eq), rng(1) {}
+
+    void oneShot(Tick when);
+};
+
+class OneShotEvent : public Event
+{
+  public:
+    OneShotEvent(Model &model) : model(model) {}
+
+    void
+    process() override
+    {
+        model.processed++;
+        model.freeList.push_back(this);
+    }
+
+  private:
+    Model &model;
+};
+
+void
+Model::oneShot(Tick when)
+{
+    if (freeList.empty()) {
+        pool.emplace_back(std::make_unique<OneShotEvent>(*this));
+        freeList.push_back(pool.back().get());
+    }
+    eq.schedule(freeList.back(), when);
+    freeList.pop_back();
+}
+
+class TickEvent : public Event
+{
+  public:
+    TickEvent(Model &model, Tick period, Priority prio)
+        : Event(prio), model(model), period(period)
+    {}
+
+    void
+    process() override
+    {
+        model.processed++;
+        model.eq.schedule(this, when() + period);
+
+        // now and then start a request that completes later
+        if (model.rng() % 8 == 0)
+            model.oneShot(when() + period * (1 + model.rng() % 200));
+    }
+
+  private:
+    Model &model;
+    const Tick period;
+};
+
+double
+run(bool calendar, unsigned objects, uint64_t events)
+{
+    EventQueue eq("bench");
+    eq.useCalendar(calendar);
+    Model model(eq);
+
+    // core, cache, interconnect and DRAM like clock periods in ps
+    const Tick periods[] = { 333, 500, 625, 1000, 1250 };
+    const Event::Priority prios[] = {
+        Event::CPU_Tick_Pri, Event::Default_Pri, Event::Default_Pri
+    };
+
+    std::vector<std::unique_ptr<TickEvent>> tickers;
+    for (unsigned i = 0; i < objects; i++) {
+        const Tick period = periods[i % 5];
+        tickers.emplace_back(std::make_unique<TickEvent>(
+            model, period, prios[i % 3]));
+        eq.schedule(tickers.back().get(), model.rng() % period);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    while (model.processed < events)
+        eq.serviceOne();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    while (!eq.empty())
+        eq.deschedule(eq.getHead());
+
+    return model.processed / elapsed.count();
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const unsigned max_objects = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const uint64_t events = argc > 2 ? std::atoll(argv[2]) : 2000000;
+
+    cprintf("%8s %14s %14s %8s\n", "objects", "list ev/s", "calendar ev/s",
+            "speedup");
+    for (unsigned objects = 16; objects <= max_objects; objects *= 4) {
+        const double list = run(false, objects, events);
+        const double calendar = run(true, objects, events);
+        cprintf("%8d %14d %14d %8.2f\n", objects, (uint64_t)list,
+                (uint64_t)calendar, calendar / list);
+    }
+
+    return 0;
+}
@@ -146,6 +146,9 @@ GlobalSyncEvent::BarrierEvent::process()
     // wait for all queues to arrive at barrier, then process event
     if (globalBarrier()) {
         _globalEvent->process();
+        // insert what was scheduled on other queues up to here, but not
+        // what threads that pass the barrier first schedule after it
+        sealAsyncInsertions();
     }
 
     // second barrier to force all queues to wait for event processing
@@ -32,6 +32,7 @@
 #include "sim/mem_pool.hh"
 
 #include "base/addr_range.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 
 namespace gem5 {
@@ -92,7 +93,8 @@ Addr MemPool::totalBytes() const {
     return totalPages() << pageShift;
 }
 
-Addr MemPool::allocate(Addr npages) {
+Addr MemPool::allocate(Addr npages, Addr align_pages) {
+    freePageNum = roundUp(freePageNum, align_pages);
     Addr return_addr = freePageAddr();
     freePageNum += npages;
 
@@ -122,8 +124,24 @@ void MemPools::populate(const AddrRangeList &memories) {
     }
 }
 
-Addr MemPools::allocPhysPages(int npages, int pool_id) {
-    return pools[pool_id].allocate(npages);
+Addr MemPools::allocPhysPages(int npages, int pool_id, Addr align_pages) {
+    return pools[pool_id].allocate(npages, align_pages);
+}
+
+MemPools
+MemPools::split(int parts, int pool_id) {
+    MemPool &pool = pools[pool_id];
+    const Counter pages = pool.freePages() / parts;
+    fatal_if(pages == 0, "Not enough free memory to split into %d pools.",
+             parts);
+
+    MemPools split_pools(pageShift);
+    for (int i = 0; i < parts; i++) {
+        const Addr start = pool.freePageAddr();
+        pool.setFreePage(pool.freePage() + pages);
+        split_pools.pools.emplace_back(pageShift, start, pool.freePageAddr());
+    }
+    return split_pools;
 }
 
 Addr MemPools::memSize(int pool_id) const {
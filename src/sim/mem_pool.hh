@@ -77,7 +77,7 @@ class MemPool : public Serializable
     Addr freeBytes() const;
     Addr totalBytes() const;
 
-    Addr allocate(Addr npages);
+    Addr allocate(Addr npages, Addr align_pages=1);
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
@@ -95,9 +95,19 @@ class MemPools : public Serializable
 
     void populate(const AddrRangeList &memories);
 
-    /// Allocate npages contiguous unused physical pages.
+    /// Allocate npages contiguous unused physical pages, starting at a
+    /// multiple of align_pages pages. Pages skipped to align the
+    /// allocation are not used.
     /// @return Starting address of first page
-    Addr allocPhysPages(int npages, int pool_id=0);
+    Addr allocPhysPages(int npages, int pool_id=0, Addr align_pages=1);
+
+    /**
+     * Split the free memory of a pool into equally sized pools, which
+     * take the memory out of the original pool.
+     */
+    MemPools split(int parts, int pool_id=0);
+
+    size_t numPools() const { return pools.size(); }
 
     /** Amount of physical memory that exists in a pool. */
     Addr memSize(int pool_id=0) const;
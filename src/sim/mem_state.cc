@@ -28,6 +28,7 @@
 
 #include "sim/mem_state.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "arch/generic/mmu.hh"
@@ -41,6 +42,14 @@
 namespace gem5
 {
 
+namespace
+{
+
+/** Size of the runs of mmapped host file pages mapped at a time. */
+constexpr Addr fileMapRunBytes = 2 * 1024 * 1024;
+
+} // anonymous namespace
+
 MemState::MemState(Process *owner, Addr brk_point, Addr stack_base,
                    Addr max_stack_size, Addr next_thread_stack_base,
                    Addr mmap_end)
@@ -185,7 +194,8 @@ MemState::mapRegion(Addr start_addr, Addr length,
      * Record the region in our list structure.
      */
     _vmaList.emplace_back(AddrRange(start_addr, start_addr + length),
-                          _pageBytes, region_name, sim_fd, offset);
+                          _pageBytes, region_name, sim_fd, offset,
+                          _ownerProcess->mapFilePages);
 }
 
 void
@@ -397,8 +407,41 @@ MemState::fixupFault(Addr vaddr)
      */
     for (const auto &vma : _vmaList) {
         if (vma.contains(vaddr)) {
+            /**
+             * Map anonymous memory with the largest page which the area
+             * covers and which is not partly mapped already.
+             */
+            for (unsigned log_bytes : _ownerProcess->largePageShifts) {
+                const Addr size = 1ULL << log_bytes;
+                const Addr start = roundDown(vaddr, size);
+                if (vma.hasHostBuf() || !vma.contains(start) ||
+                    !vma.contains(start + size - 1) ||
+                    !_ownerProcess->pTable->isUnmapped(start, size)) {
+                    continue;
+                }
+                _ownerProcess->allocateLargePage(start, log_bytes);
+                return true;
+            }
+
             Addr vpage_start = roundDown(vaddr, _pageBytes);
-            _ownerProcess->allocateMem(vpage_start, _pageBytes);
+            Addr fill_bytes = _pageBytes;
+
+            /**
+             * When the host file pages are mapped into the guest, map
+             * the rest of the file up to the next fileMapRunBytes
+             * boundary along with the faulting page, so that large files
+             * do not need a host mapping per page.
+             */
+            if (vma.hasHostBuf() && _ownerProcess->mapFilePages) {
+                Addr run = std::min(vma.hostBufBytesFrom(vpage_start),
+                    roundUp(vpage_start + 1, fileMapRunBytes) - vpage_start);
+                if (run > _pageBytes &&
+                    _ownerProcess->pTable->isUnmapped(vpage_start, run)) {
+                    fill_bytes = run;
+                }
+            }
+
+            _ownerProcess->allocateMem(vpage_start, fill_bytes);
 
             /**
              * We are assuming that fresh pages are zero-filled, so there is
@@ -406,6 +449,20 @@ MemState::fixupFault(Addr vaddr)
              * This assumption will not hold true if/when physical pages
              * are recycled.
              */
+            if (vma.hasHostBuf() && _ownerProcess->mapFilePages) {
+                /**
+                 * Map the host file pages directly over the fresh
+                 * physical pages if possible.
+                 */
+                auto *pte = _ownerProcess->pTable->lookup(vpage_start);
+                assert(pte);
+                if (vma.mapMemPages(vpage_start, fill_bytes,
+                        pte->translate(vpage_start),
+                        _ownerProcess->system->getPhysMem())) {
+                    return true;
+                }
+            }
+
             if (vma.hasHostBuf()) {
                 /**
                  * Write the memory for the host buffer contents for all
@@ -415,7 +472,11 @@ MemState::fixupFault(Addr vaddr)
                     auto *tc = _ownerProcess->system->threads[cid];
                     SETranslatingPortProxy
                         virt_mem(tc, SETranslatingPortProxy::Always);
-                    vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
+                    for (Addr page = vpage_start;
+                         page < vpage_start + fill_bytes;
+                         page += _pageBytes) {
+                        vma.fillMemPages(page, _pageBytes, virt_mem);
+                    }
                 }
             }
             return true;
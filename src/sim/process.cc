@@ -44,6 +44,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <climits>
 #include <csignal>
@@ -116,6 +117,7 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
       seWorkload(dynamic_cast<SEWorkload *>(system->workload)),
       useArchPT(params.useArchPT),
       kvmInSE(params.kvmInSE),
+      mapFilePages(params.mapFilePages),
       useForClone(false),
       pTable(pTable),
       objFile(obj_file),
@@ -140,6 +142,17 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
     auto ret_pair = system->PIDs.emplace(_pid);
     fatal_if(!ret_pair.second, "_pid %d is already used", _pid);
 
+    for (Addr size : params.largePageSizes) {
+        fatal_if(!isPowerOf2(size) || size <= pTable->pageSize(),
+                 "Large page size %d is not a power of two larger than "
+                 "the page size", size);
+        largePageShifts.push_back(floorLog2(size));
+    }
+    std::sort(largePageShifts.rbegin(), largePageShifts.rend());
+    // Architectural page tables only hold base pages
+    fatal_if(useArchPT && !largePageShifts.empty(),
+             "Large pages need the emulated page table (useArchPT=False)");
+
     /**
      * Linux bundles together processes into this concept called a thread
      * group. The thread group is responsible for recording which processes
@@ -313,6 +326,14 @@ Process::drain()
     return DrainState::Drained;
 }
 
+void
+Process::allocateLargePage(Addr vaddr, unsigned log_bytes)
+{
+    const Addr npages = (1ULL << log_bytes) / pTable->pageSize();
+    const Addr paddr = seWorkload->allocPhysPages(npages, 0, npages);
+    pTable->mapLarge(vaddr, paddr, log_bytes);
+}
+
 void
 Process::allocateMem(Addr vaddr, int64_t size, bool clobber)
 {
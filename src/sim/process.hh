@@ -120,6 +120,10 @@ class Process : public SimObject
     // requested, and may configure more if necessary.
     void allocateMem(Addr vaddr, int64_t size, bool clobber=false);
 
+    // Allocate physical memory for a single large page of 2^log_bytes
+    // bytes, and map it at vaddr, which must be aligned to its size.
+    void allocateLargePage(Addr vaddr, unsigned log_bytes);
+
     /// Attempt to fix up a fault at vaddr by allocating a page on the stack.
     /// @return Whether the fault has been fixed.
     bool fixupFault(Addr vaddr);
@@ -178,6 +182,11 @@ class Process : public SimObject
     bool useArchPT;
     // running KVM requires special initialization
     bool kvmInSE;
+    // map mmapped file pages into guest memory instead of copying them
+    bool mapFilePages;
+    // sizes of the large pages to map memory with, in address bits and
+    // from the largest down
+    std::vector<unsigned> largePageShifts;
     // flag for using the process as a thread which shares page tables
     bool useForClone;
 
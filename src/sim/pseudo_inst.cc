@@ -54,7 +54,6 @@
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "cpu/base.hh"
-#include "cpu/o3/cpu.hh"
 #include "cpu/thread_context.hh"
 #include "debug/Loader.hh"
 #include "debug/Quiesce.hh"
@@ -557,12 +556,12 @@ void workend(ThreadContext *tc, uint64_t workid, uint64_t threadid) {
 
 void addmemregion(ThreadContext *tc, Addr start, Addr end, uint64_t id) {
     DPRINTF(PseudoInst, "pseudo_inst::addmemregion(%d: 0x%x, 0x%x)\n", id, start, end);
-    static_cast<gem5::o3::CPU *>(tc->getCpuPtr())->addMemRegion(start, end, id);
+    tc->getCpuPtr()->addMemRegion(start, end, id);
 }
 
 void clearmemregion(ThreadContext *tc) {
     DPRINTF(PseudoInst, "pseudo_inst::clearmemregion()\n");
-    static_cast<gem5::o3::CPU *>(tc->getCpuPtr())->clearMemRegion();
+    tc->getCpuPtr()->clearMemRegion();
 }
 
 // int *m5MAAload(ThreadContext *tc, int *a, int *b, int min, int max) {
@@ -29,6 +29,7 @@
 
 #include "cpu/thread_context.hh"
 #include "params/SEWorkload.hh"
+#include "sim/eventq.hh"
 #include "sim/process.hh"
 #include "sim/system.hh"
 
@@ -36,7 +37,7 @@ namespace gem5
 {
 
 SEWorkload::SEWorkload(const Params &p, Addr page_shift) :
-    Workload(p), memPools(page_shift)
+    Workload(p), memPools(page_shift), queuePools(page_shift)
 {}
 
 void
@@ -57,24 +58,59 @@ void
 SEWorkload::serialize(CheckpointOut &cp) const
 {
     memPools.serialize(cp);
+    if (queuePools.numPools())
+        queuePools.serializeSection(cp, "queue_pools");
 }
 
 void
 SEWorkload::unserialize(CheckpointIn &cp)
 {
     memPools.unserialize(cp);
+    if (cp.sectionExists(Serializable::currentSection() + ".queue_pools"))
+        queuePools.unserializeSection(cp, "queue_pools");
 }
 
 void
 SEWorkload::syscall(ThreadContext *tc)
 {
+    if (!inParallelMode) {
+        tc->getProcessPtr()->syscall(tc);
+        return;
+    }
+
+    // Emulating a system call may touch state shared by all processes.
+    // Other threads may want to migrate to our event queue, so release
+    // it while waiting for our turn.
+    std::unique_lock<std::mutex> lock(syscallMutex, std::defer_lock);
+    {
+        EventQueue::ScopedRelease release(curEventQueue());
+        lock.lock();
+    }
     tc->getProcessPtr()->syscall(tc);
 }
 
 Addr
-SEWorkload::allocPhysPages(int npages, int pool_id)
+SEWorkload::allocPhysPages(int npages, int pool_id, Addr align_pages)
 {
-    return memPools.allocPhysPages(npages, pool_id);
+    if (numMainEventQueues == 1 && !queuePools.numPools())
+        return memPools.allocPhysPages(npages, pool_id, align_pages);
+
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (pool_id != 0)
+        return memPools.allocPhysPages(npages, pool_id, align_pages);
+
+    if (!queuePools.numPools())
+        queuePools = memPools.split(numMainEventQueues);
+
+    uint32_t index = 0;
+    while (index < numMainEventQueues && getEventQueue(index) !=
+           curEventQueue()) {
+        index++;
+    }
+    fatal_if(index >= queuePools.numPools(),
+             "No memory pool for event queue %d, the checkpoint was taken "
+             "with %d event queues.", index, queuePools.numPools());
+    return queuePools.allocPhysPages(npages, index, align_pages);
 }
 
 Addr
@@ -28,6 +28,8 @@
 #ifndef __SIM_SE_WORKLOAD_HH__
 #define __SIM_SE_WORKLOAD_HH__
 
+#include <mutex>
+
 #include "params/SEWorkload.hh"
 #include "sim/mem_pool.hh"
 #include "sim/workload.hh"
@@ -41,6 +43,17 @@ class SEWorkload : public Workload
     /** Memory allocation objects for all physical memories in the system. */
     MemPools memPools;
 
+    /**
+     * With several event queues, pages come from a pool per queue, so
+     * that the pages a thread gets do not depend on how the threads of
+     * a parallel simulation interleave.
+     */
+    MemPools queuePools;
+    std::mutex poolMutex;
+
+    /** Serializes system calls from the threads of a parallel run. */
+    std::mutex syscallMutex;
+
   public:
     using Params = SEWorkloadParams;
 
@@ -89,7 +102,7 @@ class SEWorkload : public Workload
     // For now, assume the only type of events are system calls.
     void event(ThreadContext *tc) override { syscall(tc); }
 
-    Addr allocPhysPages(int npages, int pool_id=0);
+    Addr allocPhysPages(int npages, int pool_id=0, Addr align_pages=1);
     Addr memSize(int pool_id=0) const;
     Addr freeMemSize(int pool_id=0) const;
 };
@@ -168,6 +168,28 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
     }
 }
 
+CheckpointIn &
+CheckpointIn::base(const std::string &path)
+{
+    fatal_if(path.empty(), "Empty base checkpoint path in %s\n", _cptDir);
+
+    auto it = bases.find(path);
+    if (it == bases.end()) {
+        const std::string dir = path[0] == '/' ? path : _cptDir + path;
+        DPRINTF(Checkpoint, "Loading base checkpoint %s\n", dir);
+
+        // Loading a checkpoint sets the current directory, which
+        // should keep referring to this one
+        const std::string current = currentDirectory;
+        it = bases.emplace(path, std::make_unique<CheckpointIn>(dir)).first;
+        currentDirectory = current;
+
+        fatal_if(it->second->getCptDir() == _cptDir,
+                 "Checkpoint %s is based on itself\n", _cptDir);
+    }
+    return *it->second;
+}
+
 /**
  * @param section Here we mention the section we are looking for
  * (example: currentsection).
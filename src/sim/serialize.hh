@@ -50,6 +50,8 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <stack>
 #include <string>
 #include <type_traits>
@@ -72,6 +74,9 @@ class CheckpointIn
 
     const std::string _cptDir;
 
+    // Checkpoints this one is based on, by path
+    std::map<std::string, std::unique_ptr<CheckpointIn>> bases;
+
   public:
     CheckpointIn(const std::string &cpt_dir);
     ~CheckpointIn() = default;
@@ -93,6 +98,18 @@ class CheckpointIn
         IniFile::VisitSectionCallback cb);
     /** @}*/ //end of api_checkout group
 
+    /**
+     * Get a checkpoint this one is based on, e.g. the one a delta
+     * checkpoint only holds the changes to. Relative paths are relative
+     * to the directory of this checkpoint. Each base is only loaded
+     * once, and as bases resolve their own bases in the same way,
+     * objects can restore a chain of checkpoints by recursing through
+     * it.
+     *
+     * @param path Directory of the base checkpoint
+     */
+    CheckpointIn &base(const std::string &path);
+
     // The following static functions have to do with checkpoint
     // creation rather than restoration.  This class makes a handy
     // namespace for them though.  Currently no Checkpoint object is
@@ -43,13 +43,17 @@
 #include "sim/simulate.hh"
 
 #include <atomic>
+#include <functional>
+#include <map>
 #include <thread>
+#include <vector>
 
 #include "base/logging.hh"
 #include "base/pollevent.hh"
 #include "base/types.hh"
 #include "sim/async.hh"
 #include "sim/eventq.hh"
+#include "sim/global_event.hh"
 #include "sim/init_signals.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -167,6 +171,45 @@ class SimulatorThreads
 
 static std::unique_ptr<SimulatorThreads> simulatorThreads;
 
+static std::map<int, std::function<void()>> quantumCallbacks;
+static int nextQuantumCallback = 0;
+
+/**
+ * The global event that synchronizes the threads every quantum. It runs
+ * the quantum callbacks while the threads wait at its barrier.
+ */
+class QuantumSyncEvent : public GlobalSyncEvent
+{
+  public:
+    QuantumSyncEvent(Tick when, Tick quantum)
+        : GlobalSyncEvent(when, quantum, EventBase::Progress_Event_Pri, 0)
+    {}
+
+    void
+    process() override
+    {
+        for (auto &callback : quantumCallbacks)
+            callback.second();
+        GlobalSyncEvent::process();
+    }
+
+    const char *description() const override { return "QuantumSyncEvent"; }
+};
+
+int
+registerQuantumCallback(std::function<void()> callback)
+{
+    const int id = nextQuantumCallback++;
+    quantumCallbacks.emplace(id, std::move(callback));
+    return id;
+}
+
+void
+unregisterQuantumCallback(int id)
+{
+    quantumCallbacks.erase(id);
+}
+
 struct DescheduleDeleter
 {
     void operator()(BaseGlobalEvent *event)
@@ -194,7 +237,7 @@ simulate(Tick num_cycles)
 
     if (global_exit_event)//cleaning last global exit event
         global_exit_event->clean();
-    std::unique_ptr<GlobalSyncEvent, DescheduleDeleter> quantum_event;
+    std::unique_ptr<QuantumSyncEvent, DescheduleDeleter> quantum_event;
 
     inform("Entering event queue @ %d.  Starting simulation...\n", curTick());
 
@@ -224,9 +267,9 @@ simulate(Tick num_cycles)
                  "Quantum for multi-eventq simulation not specified");
 
         quantum_event.reset(
-            new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
-                                EventBase::Progress_Event_Pri, 0));
+            new QuantumSyncEvent(curTick() + simQuantum, simQuantum));
 
+        sealAsyncInsertions();
         inParallelMode = true;
     }
 
@@ -38,6 +38,8 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <functional>
+
 #include "base/types.hh"
 
 namespace gem5
@@ -75,6 +77,22 @@ Tick get_max_tick();
  */
 void terminateEventQueueThreads();
 
+/**
+ * Register a callback to run at every quantum boundary of a parallel
+ * simulation. Callbacks run on one thread while all event queues wait
+ * at the barrier, in the order they were registered, so they can
+ * safely exchange state between the threads.
+ *
+ * @return An id to unregister the callback with.
+ */
+int registerQuantumCallback(std::function<void()> callback);
+
+/**
+ * Remove a callback added by registerQuantumCallback(), e.g. when its
+ * owner is destroyed.
+ */
+void unregisterQuantumCallback(int id);
+
 extern GlobalSimLoopExitEvent *simulate_limit_event;
 
 } // namespace gem5
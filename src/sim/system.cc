@@ -168,10 +168,22 @@ System::System(const Params &p)
     : SimObject(p), _systemPort("system_port"),
       multiThread(p.multi_thread),
       init_param(p.init_param),
-      physProxy(_systemPort, p.cache_line_size),
+      physProxy(
+          [this](PacketPtr pkt) {
+              // threads of a parallel simulation access memory from
+              // the event queue of the system
+              if (inParallelMode) {
+                  EventQueue::ScopedMigration migrate(eventQueue());
+                  _systemPort.sendFunctional(pkt);
+              } else {
+                  _systemPort.sendFunctional(pkt);
+              }
+          }, p.cache_line_size),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              p.sparse_memory_checkpoint, p.image_memory_checkpoint,
+              p.delta_memory_checkpoint, p.checkpoint_threads),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
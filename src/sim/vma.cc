@@ -30,8 +30,15 @@
 
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "base/intmath.hh"
 #include "base/types.hh"
+#include "mem/physical.hh"
 
 namespace gem5
 {
@@ -50,6 +57,31 @@ VMA::fillMemPages(Addr start, Addr size, PortProxy &port) const
     }
 }
 
+bool
+VMA::mapMemPages(Addr start, Addr size, Addr paddr,
+                 memory::PhysicalMemory &physmem) const
+{
+    auto offset = start - _addrRange.start();
+    if (offset >= _hostBufLen || _origHostBuf->getFd() == -1)
+        return false;
+
+    // The host buffer moves along the file as the area is sliced
+    auto buf_offset = (uint8_t *)_hostBuf -
+        (uint8_t *)_origHostBuf->getBuffer();
+    return physmem.mapFile(paddr, size, _origHostBuf->getFd(),
+                           _origHostBuf->getOffset() + buf_offset + offset);
+}
+
+Addr
+VMA::hostBufBytesFrom(Addr start) const
+{
+    auto offset = start - _addrRange.start();
+    if (offset >= _hostBufLen)
+        return 0;
+    return std::min(roundUp(_hostBufLen, _pageBytes), _addrRange.size()) -
+        offset;
+}
+
 bool
 VMA::isStrictSuperset(const AddrRange &r) const
 {
@@ -119,9 +151,16 @@ VMA::sanityCheck()
 }
 
 VMA::MappedFileBuffer::MappedFileBuffer(int fd, size_t length,
-                                        off_t offset)
-    : _buffer(nullptr), _length(length), _offset(offset)
+                                        off_t offset, bool keep_fd)
+    : _buffer(nullptr), _length(length), _offset(offset),
+      _fd(keep_fd ? dup(fd) : -1)
 {
+    // Without a descriptor the pages are copied instead of mapped
+    if (keep_fd && _fd == -1) {
+        warn_once("Cannot duplicate file descriptor (%s), copying file "
+                  "pages instead of mapping them\n", strerror(errno));
+    }
+
     panic_if(_length == 0, "Tried to mmap file of length zero");
 
     struct stat file_stat;
@@ -154,6 +193,8 @@ VMA::MappedFileBuffer::~MappedFileBuffer()
                  "mmap: failed to unmap file-backed host memory: %s",
                  strerror(errno));
     }
+    if (_fd != -1)
+        close(_fd);
 }
 
 } // namespace gem5
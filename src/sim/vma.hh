@@ -40,21 +40,30 @@
 namespace gem5
 {
 
+namespace memory
+{
+class PhysicalMemory;
+} // namespace memory
+
 class VMA
 {
   class MappedFileBuffer;
 
   public:
+    /**
+     * @param keep_fd Keep a duplicate of fd, so that mapMemPages() can
+     *        map the file after the workload closes it
+     */
     VMA(AddrRange r, Addr page_bytes, const std::string& vma_name="anon",
-        int fd=-1, off_t off=0)
+        int fd=-1, off_t off=0, bool keep_fd=false)
         : _addrRange(r), _pageBytes(page_bytes), _vmaName(vma_name)
     {
         DPRINTF(Vma, "Creating vma start %#x len %llu end %#x\n",
                 r.start(), r.size(), r.end());
 
         if (fd != -1) {
-            _origHostBuf =
-                std::make_shared<MappedFileBuffer>(fd, r.size(), off);
+            _origHostBuf = std::make_shared<MappedFileBuffer>(
+                fd, r.size(), off, keep_fd);
             _hostBuf = _origHostBuf->getBuffer();
             _hostBufLen = _origHostBuf->getLength();
         }
@@ -88,6 +97,22 @@ class VMA
      */
     void fillMemPages(Addr start, Addr size, PortProxy &port) const;
 
+    /**
+     * Map the host file pages backing a section of memory on the target
+     * copy-on-write over the physical pages it is mapped to, instead of
+     * copying them with fillMemPages().
+     *
+     * @return Whether the pages were mapped
+     */
+    bool mapMemPages(Addr start, Addr size, Addr paddr,
+                     memory::PhysicalMemory &physmem) const;
+
+    /**
+     * Number of bytes from start to the end of the host buffer, rounded
+     * up to a whole page, or 0 if start is past the host buffer.
+     */
+    Addr hostBufBytesFrom(Addr start) const;
+
     /**
      * Returns true if desired range exists within this virtual memory area
      * and does not include the start and end addresses.
@@ -190,17 +215,20 @@ class VMA
     class MappedFileBuffer
     {
       public:
-        MappedFileBuffer(int fd, size_t length, off_t offset);
+        MappedFileBuffer(int fd, size_t length, off_t offset, bool keep_fd);
         ~MappedFileBuffer();
 
         void *getBuffer() const { return _buffer; }
         uint64_t getLength() const { return _length; }
         off_t getOffset() const { return _offset; }
+        int getFd() const { return _fd; }
 
       private:
         void *_buffer;       // Host buffer ptr
         size_t _length;       // Length of host ptr
         off_t _offset;       // Offset in file at which mapping starts
+        int _fd;             // Host file descriptor kept to map pages,
+                             // -1 if none
     };
 };
 
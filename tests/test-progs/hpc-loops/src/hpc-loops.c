@@ -0,0 +1,127 @@
+/*
+ * Small HPC kernels for measuring the host speed of CPU models.
+ *
+ * usage: hpc-loops <triad|spmv|stencil|gather|all> [iterations]
+ *
+ * The kernels are tight loops over a few kB of code, so the time the
+ * simulator spends on them is dominated by fetching, decoding and
+ * executing the same instructions over and over.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define N 4096
+#define STENCIL_DIM 64
+#define NNZ_PER_ROW 8
+
+static double a[N], b[N], c[N];
+static double grid[STENCIL_DIM][STENCIL_DIM];
+static double next[STENCIL_DIM][STENCIL_DIM];
+static int col_idx[N * NNZ_PER_ROW];
+static double vals[N * NNZ_PER_ROW];
+static int idx[N];
+
+static void
+init(void)
+{
+    unsigned seed = 1;
+    for (int i = 0; i < N; i++) {
+        a[i] = 0.0;
+        b[i] = i * 0.5;
+        c[i] = i * 0.25;
+        seed = seed * 1103515245 + 12345;
+        idx[i] = (seed >> 8) % N;
+    }
+    for (int i = 0; i < N * NNZ_PER_ROW; i++) {
+        seed = seed * 1103515245 + 12345;
+        col_idx[i] = (seed >> 8) % N;
+        vals[i] = 1.0 / (1 + i % 7);
+    }
+    for (int i = 0; i < STENCIL_DIM; i++)
+        for (int j = 0; j < STENCIL_DIM; j++)
+            grid[i][j] = i + j;
+}
+
+static void
+triad(int iters)
+{
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < N; i++)
+            a[i] = b[i] + 3.0 * c[i];
+}
+
+static void
+spmv(int iters)
+{
+    for (int it = 0; it < iters; it++) {
+        for (int row = 0; row < N; row++) {
+            double sum = 0.0;
+            for (int k = row * NNZ_PER_ROW; k < (row + 1) * NNZ_PER_ROW; k++)
+                sum += vals[k] * b[col_idx[k]];
+            a[row] = sum;
+        }
+    }
+}
+
+static void
+stencil(int iters)
+{
+    for (int it = 0; it < iters; it++) {
+        for (int i = 1; i < STENCIL_DIM - 1; i++)
+            for (int j = 1; j < STENCIL_DIM - 1; j++)
+                next[i][j] = 0.2 * (grid[i][j] + grid[i - 1][j] +
+                        grid[i + 1][j] + grid[i][j - 1] + grid[i][j + 1]);
+        memcpy(grid, next, sizeof(grid));
+    }
+}
+
+static void
+gather(int iters)
+{
+    for (int it = 0; it < iters; it++)
+        for (int i = 0; i < N; i++)
+            a[i] += b[idx[i]] * c[i];
+}
+
+int
+main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        fprintf(stderr,
+                "usage: %s <triad|spmv|stencil|gather|all> [iterations]\n",
+                argv[0]);
+        return 1;
+    }
+    const char *kernel = argv[1];
+    int iters = argc > 2 ? atoi(argv[2]) : 10;
+    int all = strcmp(kernel, "all") == 0;
+    int ran = 0;
+
+    init();
+    if (all || strcmp(kernel, "triad") == 0) {
+        triad(iters);
+        ran = 1;
+    }
+    if (all || strcmp(kernel, "spmv") == 0) {
+        spmv(iters);
+        ran = 1;
+    }
+    if (all || strcmp(kernel, "stencil") == 0) {
+        stencil(iters);
+        ran = 1;
+    }
+    if (all || strcmp(kernel, "gather") == 0) {
+        gather(iters);
+        ran = 1;
+    }
+    if (!ran) {
+        fprintf(stderr, "Unknown kernel %s\n", kernel);
+        return 1;
+    }
+
+    // Keep the results live
+    printf("%s: a[1] = %f, grid[1][1] = %f\n", kernel, a[1], grid[1][1]);
+    return 0;
+}
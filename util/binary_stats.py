@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2024 The Regents of The University of Michigan
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Reader for gem5 binary stat files (bin://stats.bin).
+
+The binary stat format is written by statistics::Binary. A file holds a
+header followed by schema records (column names, units and
+descriptions) and row records (the tick of a dump and one double per
+column). Rows always refer to the most recent schema.
+
+This module only depends on the Python standard library. If numpy is
+available, BinaryStats.column() and BinaryStats.matrix() return numpy
+arrays.
+
+Example:
+
+    from binary_stats import BinaryStats
+
+    stats = BinaryStats("m5out/stats.bin")
+    for dump in stats.dumps():
+        print(dump.tick, dump["simTicks"])
+
+    cycles = stats.column("system.switch_cpus0.numCycles")
+
+It can also be used from the command line to convert a binary stat file
+to a text-like format or to CSV:
+
+    util/binary_stats.py m5out/stats.bin
+    util/binary_stats.py --csv --match 'system.l3.*' m5out/stats.bin
+"""
+
+import argparse
+import array
+import fnmatch
+import math
+import struct
+import sys
+
+MAGIC = b"GEM5STAT"
+VERSION = 1
+SCHEMA_TAG = 0x4D484353  # "SCHM"
+ROW_TAG = 0x5F574F52  # "ROW_"
+
+
+class Column:
+    __slots__ = ("name", "unit", "desc")
+
+    def __init__(self, name, unit, desc):
+        self.name = name
+        self.unit = unit
+        self.desc = desc
+
+
+class Schema:
+    """Column metadata shared by a sequence of dumps."""
+
+    def __init__(self, schema_id, columns):
+        self.id = schema_id
+        self.columns = columns
+        self.index = {c.name: i for i, c in enumerate(columns)}
+
+
+class Dump:
+    """A single stat dump (one row of the file)."""
+
+    def __init__(self, schema, tick, values):
+        self.schema = schema
+        self.tick = tick
+        self.values = values
+
+    def __contains__(self, name):
+        return name in self.schema.index
+
+    def __getitem__(self, name):
+        return self.values[self.schema.index[name]]
+
+    def get(self, name, default=None):
+        idx = self.schema.index.get(name)
+        return default if idx is None else self.values[idx]
+
+    def items(self):
+        for column, value in zip(self.schema.columns, self.values):
+            yield column.name, value
+
+
+class BinaryStats:
+    """Parsed contents of a binary stat file."""
+
+    def __init__(self, path):
+        self.schemas = []
+        self._dumps = []
+        with open(path, "rb") as f:
+            self._parse(f.read())
+
+    def _parse(self, buf):
+        if buf[:8] != MAGIC:
+            raise ValueError("Not a gem5 binary stat file")
+        (version, _) = struct.unpack_from("=II", buf, 8)
+        if version != VERSION:
+            raise ValueError(f"Unsupported binary stat version {version}")
+
+        offset = 16
+        schema = None
+        while offset < len(buf):
+            (tag, schema_id) = struct.unpack_from("=II", buf, offset)
+            offset += 8
+            if tag == SCHEMA_TAG:
+                (count,) = struct.unpack_from("=Q", buf, offset)
+                offset += 8
+                columns = []
+                for _ in range(count):
+                    fields = []
+                    for _ in range(3):
+                        (length,) = struct.unpack_from("=I", buf, offset)
+                        offset += 4
+                        fields.append(
+                            buf[offset : offset + length].decode("utf-8")
+                        )
+                        offset += length
+                    columns.append(Column(*fields))
+                schema = Schema(schema_id, columns)
+                self.schemas.append(schema)
+            elif tag == ROW_TAG:
+                (tick, count) = struct.unpack_from("=QQ", buf, offset)
+                offset += 16
+                end = offset + count * 8
+                if end > len(buf):
+                    # Truncated dump, e.g., the simulation was killed
+                    # while writing stats.
+                    break
+                if schema is None or schema.id != schema_id:
+                    raise ValueError("Row refers to an unknown schema")
+                values = array.array("d")
+                values.frombytes(buf[offset:end])
+                offset = end
+                self._dumps.append(Dump(schema, tick, values))
+            else:
+                raise ValueError(f"Unknown record tag {tag:#x}")
+
+    def __len__(self):
+        return len(self._dumps)
+
+    def __getitem__(self, idx):
+        return self._dumps[idx]
+
+    def dumps(self):
+        return iter(self._dumps)
+
+    def column(self, name, default=float("nan")):
+        """Time series of a single stat across all dumps."""
+        values = [d.get(name, default) for d in self._dumps]
+        try:
+            import numpy
+
+            return numpy.array(values)
+        except ImportError:
+            return values
+
+    def ticks(self):
+        return [d.tick for d in self._dumps]
+
+    def matrix(self, schema=None):
+        """Dumps x columns matrix of all dumps sharing a schema.
+
+        Defaults to the last schema in the file. Returns a numpy array if
+        numpy is available, a list of rows otherwise.
+        """
+        if schema is None:
+            schema = self.schemas[-1]
+        rows = [d.values for d in self._dumps if d.schema is schema]
+        try:
+            import numpy
+
+            return numpy.array(rows).reshape(len(rows), len(schema.columns))
+        except ImportError:
+            return [list(r) for r in rows]
+
+
+def _format_value(value):
+    # Same spelling as the text output for nan and +-inf, e.g. from
+    # formulas that divide by zero
+    if math.isnan(value):
+        return "nan"
+    if math.isinf(value):
+        return "inf" if value > 0 else "-inf"
+    if value == int(value):
+        return str(int(value))
+    return f"{value:.6f}"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert gem5 binary stat files to text or CSV"
+    )
+    parser.add_argument("file", help="Binary stat file")
+    parser.add_argument(
+        "--csv",
+        action="store_true",
+        help="Output one CSV line per dump instead of text",
+    )
+    parser.add_argument(
+        "--match",
+        action="append",
+        default=[],
+        help="Only output stats matching this glob (may be repeated)",
+    )
+    parser.add_argument(
+        "--nozero", action="store_true", help="Skip zero-valued stats"
+    )
+    args = parser.parse_args()
+
+    stats = BinaryStats(args.file)
+
+    def selected(name):
+        return not args.match or any(
+            fnmatch.fnmatchcase(name, m) for m in args.match
+        )
+
+    out = sys.stdout
+    if args.csv:
+        last = None
+        for dump in stats.dumps():
+            if dump.schema is not last:
+                last = dump.schema
+                idx = [
+                    i
+                    for i, c in enumerate(last.columns)
+                    if selected(c.name)
+                ]
+                names = [last.columns[i].name for i in idx]
+                out.write(",".join(["tick"] + names) + "\n")
+            row = [str(dump.tick)]
+            row += [_format_value(dump.values[i]) for i in idx]
+            out.write(",".join(row) + "\n")
+        return
+
+    for dump in stats.dumps():
+        out.write("\n---------- Begin Simulation Statistics ----------\n")
+        for column, value in zip(dump.schema.columns, dump.values):
+            if not selected(column.name):
+                continue
+            if args.nozero and value == 0:
+                continue
+            line = f"{column.name:<40} {_format_value(value):>12}"
+            if column.desc:
+                line += f" # {column.desc}"
+            if column.unit:
+                line += f" ({column.unit})"
+            out.write(line + "\n")
+        out.write("\n---------- End Simulation Statistics   ----------\n")
+
+
+if __name__ == "__main__":
+    main()
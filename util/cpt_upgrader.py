@@ -71,10 +71,17 @@
 
 import configparser
 import glob
+import gzip
+import mmap
 import os
 import os.path as osp
+import shutil
+import struct
 import sys
+import tempfile
 import types
+import zlib
+from concurrent.futures import ThreadPoolExecutor
 
 verbose_print = False
 
@@ -192,6 +199,230 @@ class Upgrader:
                     sys.exit(1)
 
 
+# Layout of the sparse physical memory store format, see
+# PhysicalMemory::serializeSparseStore()
+SPARSE_MAGIC = b"GEM5SPRS"
+SPARSE_VERSION = 1
+SPARSE_HEADER = struct.Struct("<8sIIQQII")
+SPARSE_PAGES_PER_CHUNK = 256
+
+PMEM_SUFFIX = {"gzip": ".pmem", "sparse": ".spmem", "image": ".img"}
+
+
+def read_sparse_store(path):
+    """Read the header of a sparse store. Returns the range size, the page
+    size and a generator of (offset, data) for each stored page."""
+    f = open(path, "rb")
+    (
+        magic,
+        version,
+        page_size,
+        range_size,
+        num_pages,
+        pages_per_chunk,
+        _,
+    ) = SPARSE_HEADER.unpack(f.read(SPARSE_HEADER.size))
+    if magic != SPARSE_MAGIC or version != SPARSE_VERSION:
+        f.close()
+        raise ValueError(f"{path} is not a sparse memory store")
+
+    pages = struct.unpack(f"<{num_pages}Q", f.read(8 * num_pages))
+    num_chunks = -(-num_pages // pages_per_chunk)
+    sizes = struct.unpack(f"<{num_chunks}Q", f.read(8 * num_chunks))
+
+    def gen():
+        with f:
+            for c, size in enumerate(sizes):
+                raw = zlib.decompress(f.read(size))
+                first = c * pages_per_chunk
+                pos = 0
+                for page in pages[first : first + pages_per_chunk]:
+                    offset = page * page_size
+                    length = min(page_size, range_size - offset)
+                    yield offset, raw[pos : pos + length]
+                    pos += length
+
+    return range_size, page_size, gen()
+
+
+def store_page_size(path, fmt):
+    """Page size of a physical memory store. Sparse stores record the page
+    size of the host that wrote them. Other stores are padded to host pages
+    (see PhysicalMemory::serializeImageStore()), and gem5 only restores
+    sparse stores written with its own page size, so use the page size of
+    this host for them."""
+    if fmt != "sparse":
+        return mmap.PAGESIZE
+    with open(path, "rb") as f:
+        magic, version, page_size, *_ = SPARSE_HEADER.unpack(
+            f.read(SPARSE_HEADER.size)
+        )
+    if magic != SPARSE_MAGIC or version != SPARSE_VERSION:
+        raise ValueError(f"{path} is not a sparse memory store")
+    return page_size
+
+
+def sparse_to_linear(src, out, seekable):
+    """Write the pages of a sparse store to a file object as one
+    contiguous image. Zero pages are skipped over if the file is
+    seekable and written out otherwise."""
+    range_size, page_size, pages = read_sparse_store(src)
+    zero = bytes(page_size)
+
+    def fill(start, end):
+        if seekable:
+            out.seek(end)
+            return
+        while start < end:
+            n = min(page_size, end - start)
+            out.write(zero[:n])
+            start += n
+
+    written = 0
+    for offset, data in pages:
+        fill(written, offset)
+        out.write(data)
+        written = offset + len(data)
+    fill(written, range_size)
+
+
+def copy_sparse(inp, out, page_size):
+    """Copy a stream to a seekable file, leaving holes for zero pages."""
+    while True:
+        data = inp.read(page_size)
+        if not data:
+            break
+        if data.count(0) == len(data):
+            out.seek(len(data), os.SEEK_CUR)
+        else:
+            out.write(data)
+    out.truncate()
+
+
+def pad_image(path, range_size, page_size):
+    """Pad a memory image to whole pages so that it can be mapped."""
+    size = -(-range_size // page_size) * page_size
+    with open(path, "r+b") as f:
+        f.truncate(size)
+
+
+def linear_to_sparse(inp, dst, range_size, page_size, threads):
+    pages = []
+    sizes = []
+    with tempfile.TemporaryFile() as chunks:
+        with ThreadPoolExecutor(threads) as pool:
+            pending = []
+            raw = []
+            page = 0
+            while page * page_size < range_size:
+                data = inp.read(page_size)
+                if not data:
+                    break
+                if data.count(0) != len(data):
+                    pages.append(page)
+                    raw.append(data)
+                    if len(raw) == SPARSE_PAGES_PER_CHUNK:
+                        pending.append(
+                            pool.submit(zlib.compress, b"".join(raw), 1)
+                        )
+                        raw = []
+                page += 1
+                # Keep a bounded number of chunks in flight
+                while len(pending) > 4 * threads:
+                    data = pending.pop(0).result()
+                    sizes.append(len(data))
+                    chunks.write(data)
+            if raw:
+                pending.append(pool.submit(zlib.compress, b"".join(raw), 1))
+            for fut in pending:
+                data = fut.result()
+                sizes.append(len(data))
+                chunks.write(data)
+
+        with open(dst, "wb") as out:
+            out.write(
+                SPARSE_HEADER.pack(
+                    SPARSE_MAGIC,
+                    SPARSE_VERSION,
+                    page_size,
+                    range_size,
+                    len(pages),
+                    SPARSE_PAGES_PER_CHUNK,
+                    0,
+                )
+            )
+            out.write(struct.pack(f"<{len(pages)}Q", *pages))
+            out.write(struct.pack(f"<{len(sizes)}Q", *sizes))
+            chunks.seek(0)
+            while True:
+                data = chunks.read(1 << 24)
+                if not data:
+                    break
+                out.write(data)
+
+
+def convert_pmem_stores(cpt, cpt_dir, fmt, threads, keep):
+    """Convert the physical memory stores of a checkpoint to the given
+    format ("gzip", "sparse" or "image"), keeping the original files if
+    requested. Returns True if anything changed."""
+    change = False
+    for sec in cpt.sections():
+        if not (
+            cpt.has_option(sec, "store_id")
+            and cpt.has_option(sec, "filename")
+            and cpt.has_option(sec, "range_size")
+        ):
+            continue
+        current = cpt.get(sec, "format", fallback="gzip")
+        if current == fmt:
+            continue
+        if current == "delta":
+            print(
+                f"Warning: not converting {cpt.get(sec, 'filename')}, "
+                "which is a delta of another checkpoint"
+            )
+            continue
+
+        src = cpt.get(sec, "filename")
+        base = src.rsplit(".", 1)[0]
+        dst = base + PMEM_SUFFIX[fmt]
+        src_path = osp.join(cpt_dir, src)
+        dst_path = osp.join(cpt_dir, dst)
+        range_size = cpt.getint(sec, "range_size")
+        page_size = store_page_size(src_path, current)
+        verboseprint(f"converting {src} from {current} to {fmt}")
+        if fmt == "sparse":
+            opener = gzip.open if current == "gzip" else open
+            with opener(src_path, "rb") as inp:
+                linear_to_sparse(
+                    inp, dst_path, range_size, page_size, threads
+                )
+        elif fmt == "gzip":
+            with gzip.open(dst_path, "wb", compresslevel=6) as out:
+                if current == "sparse":
+                    sparse_to_linear(src_path, out, False)
+                else:
+                    with open(src_path, "rb") as inp:
+                        shutil.copyfileobj(inp, out, 1 << 24)
+        else:
+            with open(dst_path, "wb") as out:
+                if current == "sparse":
+                    sparse_to_linear(src_path, out, True)
+                else:
+                    with gzip.open(src_path, "rb") as inp:
+                        copy_sparse(inp, out, page_size)
+            pad_image(dst_path, range_size, page_size)
+        if fmt == "gzip":
+            cpt.remove_option(sec, "format")
+        else:
+            cpt.set(sec, "format", fmt)
+        cpt.set(sec, "filename", dst)
+        if not keep and dst != src:
+            os.remove(osp.join(cpt_dir, src))
+        change = True
+    return change
+
+
 def process_file(path, **kwargs):
     if not osp.isfile(path):
         import errno
@@ -268,6 +499,16 @@ def process_file(path, **kwargs):
 
         to_apply -= ready
 
+    pmem_format = kwargs.get("pmem_format")
+    if pmem_format:
+        change |= convert_pmem_stores(
+            cpt,
+            osp.dirname(path),
+            pmem_format,
+            kwargs.get("threads") or os.cpu_count() or 1,
+            kwargs.get("backup", True),
+        )
+
     if not change:
         verboseprint("...nothing to do")
         return
@@ -307,6 +548,19 @@ if __name__ == "__main__":
         action="store_true",
         help="Print out debugging information as",
     )
+    parser.add_argument(
+        "--pmem-format",
+        choices=["gzip", "sparse", "image"],
+        help="Convert the physical memory stores to the given format",
+    )
+    parser.add_argument(
+        "-j",
+        "--threads",
+        type=int,
+        default=0,
+        help="Threads used to compress sparse memory stores "
+        "(default: one per core)",
+    )
     parser.add_argument(
         "--get-cc-file",
         action="store_true",